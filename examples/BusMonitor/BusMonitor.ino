@@ -0,0 +1,46 @@
+// File: BusMonitor.ino
+// Records all bus traffic, including the ack characters of the receivers,
+// and streams it to the USB serial port. Nothing is acknowledged or sent.
+
+// Test constellation = ARDUINO MEGA <-> 5WG1 117-2AB12
+
+#include <KnxTpUart.h>
+
+// Initialize the KNX TP-UART library on the Serial1 port of ARDUINO MEGA
+// and with KNX physical address 15.15.20
+KnxTpUart knx(&Serial1, "15.15.20");
+
+KnxMonitorRing monitor;
+unsigned long reportedDrops = 0;
+
+void setup() {
+  // Fast enough to export a busy bus
+  Serial.begin(115200);
+  Serial.println("TP-UART Bus Monitor");
+
+  Serial1.begin(19200, SERIAL_8E1);
+
+  knx.uartReset();
+  delay(10);
+  while (Serial1.available()) {
+    Serial1.read();  // Reset indication
+  }
+
+  knx.setMonitorRing(&monitor);
+  knx.uartActivateBusmonitor();
+}
+
+void loop() {
+  // Export a few records per pass so receiving never waits for long
+  monitor.exportTo(&Serial, 4);
+
+  if (monitor.getDroppedCount() != reportedDrops) {
+    reportedDrops = monitor.getDroppedCount();
+    Serial.print("Dropped: ");
+    Serial.println(reportedDrops);
+  }
+}
+
+void serialEvent1() {
+  knx.serialEvent();
+}
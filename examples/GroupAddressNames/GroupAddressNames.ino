@@ -0,0 +1,51 @@
+// File: GroupAddressNames.ino
+
+// Test constellation = ARDUINO MEGA <-> 5WG1 117-2AB12
+
+/*
+  Uses the group address names of the ETS project instead of "1/0/1"
+  strings. GroupAddresses.h is generated from the ETS export with
+
+    extras/host/build/knxgatable GroupAddresses.csv > GroupAddresses.h
+
+  Fixed addresses use the generated defines; names and datapoint types
+  are looked up in flash when needed, e.g. for the debug output.
+*/
+
+#include <KnxTpUart.h>
+#include "GroupAddresses.h"
+
+KnxTpUart knx(&Serial1, "15.15.20");
+
+void setup() {
+  Serial.begin(9600);
+  Serial1.begin(19200, SERIAL_8E1);
+
+  knx.uartReset();
+  knx.addListenGroupAddress(GA_KITCHEN_LIGHT_STATUS);
+  knx.addListenGroupAddress(GA_OUTDOOR_TEMPERATURE);
+  // Lookup by name, e.g. for names coming from a configuration file
+  knx.addListenGroupAddress(knxGroupAddresses.addressOf("Kitchen temperature"));
+}
+
+void loop() {
+}
+
+void serialEvent1() {
+  KnxTpUartSerialEventType eType = knx.serialEvent();
+  if (eType != KNX_TELEGRAM) {
+    return;
+  }
+
+  KnxTelegram* telegram = knx.getReceivedTelegram();
+  uint16_t target = telegram->getTargetGroupAddress();
+  knxGroupAddresses.printName(&Serial, target);
+  Serial.print(": ");
+
+  int index = knxGroupAddresses.findAddress(target);
+  if (index != KNX_GROUP_ADDRESS_NOT_FOUND && knxGroupAddresses.getDptMain(index) == 9) {
+    Serial.println(telegram->get2ByteFloatValue());
+  } else {
+    Serial.println(telegram->get1ByteIntValue());
+  }
+}
@@ -0,0 +1,57 @@
+// Generated by knxgatable from GroupAddresses.csv, do not edit.
+// 12 group addresses, 214 bytes of names.
+
+#ifndef knxGroupAddresses_h
+#define knxGroupAddresses_h
+
+#include "KnxGroupAddressTable.h"
+
+#define GA_ALL_LIGHTS_OFF 0x0800 // 1/0/0 DPT 1.001
+#define GA_KITCHEN_LIGHT 0x0801 // 1/0/1 DPT 1.001
+#define GA_LIVING_ROOM_LIGHT 0x0802 // 1/0/2 DPT 1.001
+#define GA_KITCHEN_LIGHT_STATUS 0x0901 // 1/1/1 DPT 1.011
+#define GA_LIVING_ROOM_LIGHT_STATUS 0x0902 // 1/1/2 DPT 1.011
+#define GA_KITCHEN_TEMPERATURE 0x1001 // 2/0/1 DPT 9.001
+#define GA_BATHROOM_TEMPERATURE 0x1002 // 2/0/2 DPT 9.001
+#define GA_OUTDOOR_TEMPERATURE 0x100A // 2/0/10 DPT 9.001
+#define GA_BATHROOM_COMFORT_SETPOINT 0x1102 // 2/1/2 DPT 9.001
+#define GA_HEATING_VALVE_K_CHE 0x1201 // 2/2/1 DPT 5.001
+#define GA_SCENE 0x1800 // 3/0/0 DPT 17.000
+#define GA_TIME 0x7803 // 15/0/3 DPT 19.001
+
+static const char knxGroupAddressesNames[] PROGMEM =
+  "All lights off\0"
+  "Kitchen light\0"
+  "Living room light\0"
+  "Kitchen light status\0"
+  "Living room light status\0"
+  "Kitchen temperature\0"
+  "Bathroom temperature\0"
+  "Outdoor temperature\0"
+  "Bathroom \042comfort\042 setpoint\0"
+  "Heating valve K\303\274che\0"
+  "Scene\0"
+  "Time\0";
+
+static const KnxGroupAddressEntry knxGroupAddressesEntries[] PROGMEM = {
+  { 0x0800, 0, 1, 1 },
+  { 0x0801, 15, 1, 1 },
+  { 0x0802, 29, 1, 1 },
+  { 0x0901, 47, 11, 1 },
+  { 0x0902, 68, 11, 1 },
+  { 0x1001, 93, 1, 9 },
+  { 0x1002, 113, 1, 9 },
+  { 0x100A, 134, 1, 9 },
+  { 0x1102, 154, 1, 9 },
+  { 0x1201, 182, 1, 5 },
+  { 0x1800, 203, 0, 17 },
+  { 0x7803, 209, 1, 19 },
+};
+
+static const uint16_t knxGroupAddressesByName[] PROGMEM = {
+  0, 8, 6, 9, 1, 3, 5, 2, 4, 7, 10, 11,
+};
+
+static KnxGroupAddressTable knxGroupAddresses(knxGroupAddressesEntries, knxGroupAddressesByName, knxGroupAddressesNames, 12);
+
+#endif
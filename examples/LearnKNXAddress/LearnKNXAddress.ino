@@ -10,6 +10,9 @@
 // Initialize the KNX TP-UART library on the Serial1 port of ARDUINO MEGA
 KnxTpUart knx(&Serial1, "15.15.20");
 
+// Point-to-point connection with ETS
+KnxTransport transport(&knx);
+
 // Start in programming mode
 boolean programmingMode = true;
 
@@ -21,10 +24,13 @@ void setup() {
 
   knx.uartReset();
   knx.setListenToBroadcasts(true);
+  knx.setTransport(&transport);
 }
 
 
 void loop() {
+  // Connection and acknowledge timeouts
+  transport.poll();
 }
 
 void serialEvent1() {
@@ -0,0 +1,77 @@
+// File: RxRingInterrupt.ino
+
+// Test constellation = ARDUINO MEGA <-> 5WG1 117-2AB12
+
+/*
+  Receives through KnxRxRing instead of the Serial1 buffer. The USART1
+  receive interrupt pushes every byte with its timestamp into the ring, so
+  the bus keeps being received while loop() is busy, and serialEvent()
+  reads whole frames from the ring.
+
+  Serial1 must not be used anywhere in this sketch, otherwise the core
+  installs its own USART1 receive interrupt. Sending goes through the small
+  Usart1Writer below.
+*/
+
+#include <KnxTpUart.h>
+
+class Usart1Writer : public Stream {
+  public:
+    size_t write(uint8_t b) {
+      while (!(UCSR1A & (1 << UDRE1)));
+      UDR1 = b;
+      return 1;
+    }
+    int available() {
+      return 0;
+    }
+    int read() {
+      return -1;
+    }
+    int peek() {
+      return -1;
+    }
+    void flush() {}
+};
+
+Usart1Writer usart1;
+KnxRxRing ring;
+KnxTpUart knx(&usart1, "15.15.20");
+
+int LED = 13;
+
+ISR(USART1_RX_vect) {
+  ring.push(UDR1);
+}
+
+void setup() {
+  pinMode(LED, OUTPUT);
+  Serial.begin(9600);
+
+  // 19200 baud, 8 data bits, even parity, 1 stop bit
+  UBRR1 = (F_CPU / 16 / 19200) - 1;
+  UCSR1A = 0;
+  UCSR1C = (1 << UPM11) | (1 << UCSZ11) | (1 << UCSZ10);
+  UCSR1B = (1 << RXEN1) | (1 << TXEN1) | (1 << RXCIE1);
+
+  knx.setRxRing(&ring);
+  knx.uartReset();
+  knx.addListenGroupAddress("15/0/0");
+}
+
+void loop() {
+  KnxTpUartSerialEventType eType = knx.serialEvent();
+  if (eType == KNX_TELEGRAM) {
+    KnxTelegram* telegram = knx.getReceivedTelegram();
+    if (telegram->getCommand() == KNX_COMMAND_WRITE) {
+      digitalWrite(LED, telegram->getBool() ? HIGH : LOW);
+    }
+  }
+
+  static unsigned long lastOverflows = 0;
+  if (ring.getOverflowCount() != lastOverflows) {
+    lastOverflows = ring.getOverflowCount();
+    Serial.print("Receive ring overflows: ");
+    Serial.println(lastOverflows);
+  }
+}
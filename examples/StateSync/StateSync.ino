@@ -0,0 +1,67 @@
+// File: StateSync.ino
+
+// Test constellation = ESP32 <-> NCN5120
+
+/*
+  Learns the current value of a list of group addresses after a restart.
+  KnxStateSync keeps up to STATE_SYNC_WINDOW read requests in flight, the
+  transmit queue paces them on the bus, and addresses that do not answer
+  are asked again up to STATE_SYNC_RETRIES times.
+*/
+
+#include <KnxTpUart.h>
+#include <KnxStateSync.h>
+
+KnxTpUart knx(&Serial2, "1.1.199");
+KnxTxQueue queue;
+KnxStateSync stateSync(&knx);
+
+const char* const addresses[] = {
+  "2/6/0", "2/6/1", "2/6/2", "2/6/3", "2/6/4", "2/6/5", "2/6/6", "2/6/7",
+  "5/6/0", "5/6/1", "5/6/2", "5/6/3", "5/6/4", "5/6/5", "5/6/6", "5/6/7"
+};
+#define ADDRESS_COUNT (sizeof(addresses) / sizeof(addresses[0]))
+
+uint8_t syncStatus[ADDRESS_COUNT];
+int values[ADDRESS_COUNT];
+bool reported = false;
+
+void onAnswer(int index, KnxTelegram* answer) {
+  values[index] = answer->get1ByteIntValue();
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial2.begin(19200, SERIAL_8E1);
+
+  knx.uartReset();
+  knx.setTxQueue(&queue);
+  // About one read request and its answer per 40 ms fits the bus
+  knx.setTxInterval(40);
+
+  stateSync.setAnswerCallback(onAnswer);
+  stateSync.begin(addresses, syncStatus, ADDRESS_COUNT);
+}
+
+void loop() {
+  knx.serialEvent();
+  knx.processTxQueue();
+  stateSync.poll();
+
+  if (stateSync.isComplete() && !reported) {
+    reported = true;
+    Serial.print("Synchronised in ");
+    Serial.print(stateSync.getDuration());
+    Serial.println(" ms");
+    for (int i = 0; i < (int) ADDRESS_COUNT; i++) {
+      Serial.print(addresses[i]);
+      if (stateSync.getStatus(i) == KNX_SYNC_ANSWERED) {
+        Serial.print(" = ");
+        Serial.println(values[i]);
+      }
+      else {
+        Serial.println(" no answer");
+      }
+    }
+  }
+}
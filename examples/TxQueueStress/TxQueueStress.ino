@@ -0,0 +1,172 @@
+// File: TxQueueStress.ino
+
+// Test constellation = ESP32, no TP-UART needed
+
+/*
+  Stress test for the multi-producer transmit queue.
+
+  Several FreeRTOS tasks call groupWrite2ByteInt() at the same time while
+  loop() is the only drainer of the queue. Instead of a TP-UART the library
+  talks to LoopbackTpUart below, which decodes every frame written to it,
+  checks checksum and per producer sequence and confirms it like the chip.
+
+  The drainer waits SERIAL_WRITE_DELAY_MS after every frame. To measure the
+  queue itself and not that delay, build with -DSERIAL_WRITE_DELAY_MS=0
+  (build_flags in PlatformIO).
+*/
+
+#include <KnxTpUart.h>
+
+#define MAX_PRODUCERS 8
+#define FRAMES_PER_PRODUCER 500
+
+class LoopbackTpUart : public Stream {
+  public:
+    unsigned long received;
+    unsigned long corrupted;
+    int expected[MAX_PRODUCERS];
+
+    void reset() {
+      received = 0;
+      corrupted = 0;
+      _pos = 0;
+      _confirmations = 0;
+      for (int i = 0; i < MAX_PRODUCERS; i++) {
+        expected[i] = 0;
+      }
+    }
+
+    size_t write(uint8_t b) {
+      // Bytes arrive as (control, data) pairs
+      if (_pos % 2 == 0) {
+        _control = b;
+      }
+      else if (_pos / 2 < MAX_KNX_TELEGRAM_SIZE) {
+        _frame[_pos / 2] = b;
+      }
+      _pos++;
+
+      if (_pos % 2 == 0 && (_control & TPUART_DATA_END)) {
+        checkFrame(_pos / 2);
+        _pos = 0;
+        _confirmations++;
+      }
+      return 1;
+    }
+
+    int available() {
+      return _confirmations;
+    }
+
+    int read() {
+      if (_confirmations == 0) {
+        return -1;
+      }
+      _confirmations--;
+      return 0b10001011; // Positive confirmation
+    }
+
+    int peek() {
+      return _confirmations ? 0b10001011 : -1;
+    }
+
+    void flush() {}
+
+  private:
+    uint8_t _frame[MAX_KNX_TELEGRAM_SIZE];
+    uint8_t _control;
+    int _pos;
+    int _confirmations;
+
+    void checkFrame(int length) {
+      KnxTelegram tg;
+      for (int i = 0; i < length; i++) {
+        tg.setBufferByte(i, _frame[i]);
+      }
+
+      int producer = tg.getTargetMiddleGroup();
+      if (length != tg.getTotalLength() || !tg.verifyChecksum() || producer >= MAX_PRODUCERS
+          || tg.get2ByteIntValue() != expected[producer]) {
+        corrupted++;
+        return;
+      }
+      expected[producer]++;
+      received++;
+    }
+};
+
+LoopbackTpUart loopback;
+KnxTpUart knx(&loopback, "1.1.199");
+KnxTxQueue queue;
+
+// One counter per producer, so the tasks never write the same variable
+volatile unsigned long accepted[MAX_PRODUCERS];
+volatile bool finished[MAX_PRODUCERS];
+
+void producerTask(void* parameter) {
+  int producer = (intptr_t) parameter;
+  String address = String("1/") + String(producer) + "/0";
+
+  for (int seq = 0; seq < FRAMES_PER_PRODUCER; seq++) {
+    // A full queue is back pressure, not loss: retry until accepted
+    while (!knx.groupWrite2ByteInt(address, seq)) {
+      taskYIELD();
+    }
+    accepted[producer]++;
+  }
+
+  finished[producer] = true;
+  vTaskDelete(NULL);
+}
+
+void runStress(int producers) {
+  loopback.reset();
+  for (int p = 0; p < MAX_PRODUCERS; p++) {
+    accepted[p] = 0;
+    finished[p] = (p >= producers);
+  }
+
+  unsigned long start = micros();
+  for (int p = 0; p < producers; p++) {
+    xTaskCreatePinnedToCore(producerTask, "knxProducer", 4096, (void*) (intptr_t) p, 1, NULL, p % 2);
+  }
+
+  bool running = true;
+  while (running || !queue.isEmpty()) {
+    knx.processTxQueue();
+    running = false;
+    for (int p = 0; p < producers; p++) {
+      running = running || !finished[p];
+    }
+  }
+  unsigned long elapsed = micros() - start;
+
+  unsigned long sent = 0;
+  for (int p = 0; p < producers; p++) {
+    sent += accepted[p];
+  }
+  Serial.print("Producers: ");
+  Serial.print(producers);
+  Serial.print(" Sent: ");
+  Serial.print(sent);
+  Serial.print(" Lost: ");
+  Serial.print(sent - loopback.received - loopback.corrupted);
+  Serial.print(" Corrupted: ");
+  Serial.print(loopback.corrupted);
+  Serial.print(" Frames/s: ");
+  Serial.println(sent * 1000000.0 / elapsed);
+}
+
+void setup() {
+  Serial.begin(115200);
+  knx.setTxQueue(&queue);
+
+  for (int producers = 1; producers <= MAX_PRODUCERS; producers *= 2) {
+    runStress(producers);
+  }
+  Serial.print("Rejected while full (retried): ");
+  Serial.println(queue.getRejectedCount());
+}
+
+void loop() {
+}
@@ -0,0 +1,320 @@
+// File: KnxCaptureAnalyzer.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxCaptureAnalyzer.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <thread>
+
+#include "KnxTelegramView.h"
+
+KnxCaptureAnalyzer::KnxCaptureAnalyzer() {
+  _data = NULL;
+  _length = 0;
+  _map = NULL;
+  _map_length = 0;
+  _frames = 0;
+  _acks = 0;
+  _transmits = 0;
+  _bad = 0;
+}
+
+KnxCaptureAnalyzer::~KnxCaptureAnalyzer() {
+  close();
+}
+
+bool KnxCaptureAnalyzer::open(const char* path) {
+  close();
+
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0 || st.st_size == 0) {
+    ::close(fd);
+    return false;
+  }
+
+  void* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+  // Every byte is read once, front to back
+  madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+  _map = map;
+  _map_length = st.st_size;
+  if (!begin((const uint8_t*) map, st.st_size)) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool KnxCaptureAnalyzer::begin(const uint8_t* data, size_t length) {
+  KnxCaptureReader reader;
+  if (!reader.begin(data, length)) {
+    return false;
+  }
+  _data = data;
+  _length = length;
+  return true;
+}
+
+void KnxCaptureAnalyzer::close() {
+  if (_map != NULL) {
+    munmap(_map, _map_length);
+    _map = NULL;
+  }
+  _data = NULL;
+  _length = 0;
+}
+
+unsigned long KnxCaptureAnalyzer::run(int threads) {
+  if (_data == NULL) {
+    return 0;
+  }
+  if (threads <= 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  std::vector<Slice> slices(threads);
+  split(slices);
+
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < slices.size(); i++) {
+    workers.push_back(std::thread(decode, _data, &slices[i]));
+  }
+  decode(_data, &slices[0]);
+  for (size_t i = 0; i < workers.size(); i++) {
+    workers[i].join();
+  }
+
+  // In capture order, so the last value of a later slice wins
+  _groups.assign(KNX_ANALYZER_ADDRESSES, KnxAddressStats());
+  _sources.assign(KNX_ANALYZER_ADDRESSES, KnxAddressStats());
+  _frames = _acks = _transmits = _bad = 0;
+  for (size_t i = 0; i < slices.size(); i++) {
+    merge(_groups, slices[i].groups);
+    merge(_sources, slices[i].sources);
+    _frames += slices[i].frames;
+    _acks += slices[i].acks;
+    _transmits += slices[i].transmits;
+    _bad += slices[i].bad;
+  }
+  return _frames;
+}
+
+void KnxCaptureAnalyzer::split(std::vector<Slice>& slices) {
+  // Records have no sync marker, so the boundaries are found by hopping
+  // over the record headers once. This touches only one byte per record.
+  size_t position = KNX_CAPTURE_HEADER_SIZE;
+  size_t target = _length / slices.size();
+  size_t n = 0;
+  slices[0].begin = position;
+  while (position + KNX_CAPTURE_RECORD_HEADER_SIZE <= _length && n + 1 < slices.size()) {
+    if (position >= target * (n + 1)) {
+      slices[n].end = position;
+      slices[++n].begin = position;
+    }
+    position += KNX_CAPTURE_RECORD_HEADER_SIZE + _data[position + 5];
+  }
+  slices[n].end = _length;
+  for (size_t i = n + 1; i < slices.size(); i++) {
+    slices[i].begin = slices[i].end = _length;
+  }
+}
+
+void KnxCaptureAnalyzer::decode(const uint8_t* data, Slice* slice) {
+  slice->groups.assign(KNX_ANALYZER_ADDRESSES, KnxAddressStats());
+  slice->sources.assign(KNX_ANALYZER_ADDRESSES, KnxAddressStats());
+  slice->frames = slice->acks = slice->transmits = slice->bad = 0;
+
+  size_t offsets[KNX_ANALYZER_BATCH];
+  size_t position = slice->begin;
+  while (position < slice->end) {
+    // Collect the frame records of one batch
+    int n = 0;
+    while (n < KNX_ANALYZER_BATCH && position + KNX_CAPTURE_RECORD_HEADER_SIZE <= slice->end) {
+      const uint8_t* record = data + position;
+      uint8_t flags = record[4];
+      uint8_t length = record[5];
+      if (position + KNX_CAPTURE_RECORD_HEADER_SIZE + length > slice->end) {
+        slice->bad++;
+        position = slice->end;
+        break;
+      }
+
+      if (flags & KNX_CAPTURE_ACK_CHAR) {
+        slice->acks++;
+      }
+      else if (length < KNX_TELEGRAM_HEADER_SIZE + 2
+               || KnxTelegramView(record + KNX_CAPTURE_RECORD_HEADER_SIZE).getTotalLength() > length) {
+        slice->bad++;
+      }
+      else {
+        if (flags & KNX_CAPTURE_TX) {
+          slice->transmits++;
+        }
+        offsets[n++] = position + KNX_CAPTURE_RECORD_HEADER_SIZE;
+      }
+      position += KNX_CAPTURE_RECORD_HEADER_SIZE + length;
+    }
+    countBatch(data, offsets, n, slice);
+  }
+}
+
+void KnxCaptureAnalyzer::countBatch(const uint8_t* data, const size_t* offsets, int n, Slice* slice) {
+  uint16_t source[KNX_ANALYZER_BATCH];
+  uint16_t target[KNX_ANALYZER_BATCH];
+  uint8_t length[KNX_ANALYZER_BATCH];
+  uint8_t command[KNX_ANALYZER_BATCH];
+  uint8_t kind[KNX_ANALYZER_BATCH];  // bit 0 group, bit 1 repeated, bit 2 valid
+  uint32_t value[KNX_ANALYZER_BATCH];
+  uint8_t valueLength[KNX_ANALYZER_BATCH];
+
+  // Fixed position fields, one column at a time
+  for (int i = 0; i < n; i++) {
+    KnxTelegramView view(data + offsets[i]);
+    source[i] = view.getSourceAddress();
+    target[i] = view.getTargetAddress();
+    length[i] = view.getTotalLength();
+    command[i] = view.getCommand();
+    kind[i] = (view.isTargetGroup() ? 1 : 0) | (view.isRepeated() ? 2 : 0);
+  }
+  for (int i = 0; i < n; i++) {
+    KnxTelegramView view(data + offsets[i]);
+    kind[i] |= view.verifyChecksum() ? 4 : 0;
+  }
+  for (int i = 0; i < n; i++) {
+    const uint8_t* frame = data + offsets[i];
+    int payload = length[i] - KNX_TELEGRAM_HEADER_SIZE - 1;
+    if (payload <= 2) {
+      // 6 bit value in the APCI byte
+      value[i] = frame[7] & 0b00111111;
+      valueLength[i] = 1;
+    }
+    else {
+      int bytes = std::min(payload - 2, 4);
+      uint32_t v = 0;
+      for (int j = 0; j < bytes; j++) {
+        v = (v << 8) | frame[8 + j];
+      }
+      value[i] = v;
+      valueLength[i] = bytes;
+    }
+  }
+
+  // Scatter into the tables
+  for (int i = 0; i < n; i++) {
+    if (!(kind[i] & 4)) {
+      slice->bad++;
+      continue;
+    }
+    slice->frames++;
+
+    KnxAddressStats& s = slice->sources[source[i]];
+    s.frames++;
+    s.repeats += (kind[i] >> 1) & 1;
+    s.bytes += length[i];
+
+    if (!(kind[i] & 1)) {
+      continue;
+    }
+    KnxAddressStats& g = slice->groups[target[i]];
+    g.frames++;
+    g.repeats += (kind[i] >> 1) & 1;
+    g.bytes += length[i];
+    if (command[i] == KNX_COMMAND_READ) {
+      g.reads++;
+    }
+    else if (command[i] == KNX_COMMAND_WRITE || command[i] == KNX_COMMAND_ANSWER) {
+      if (command[i] == KNX_COMMAND_WRITE) {
+        g.writes++;
+      }
+      else {
+        g.answers++;
+      }
+      g.lastValue = value[i];
+      g.lastValueLength = valueLength[i];
+    }
+  }
+}
+
+void KnxCaptureAnalyzer::merge(std::vector<KnxAddressStats>& into, const std::vector<KnxAddressStats>& from) {
+  for (size_t i = 0; i < from.size(); i++) {
+    const KnxAddressStats& f = from[i];
+    if (f.frames == 0) {
+      continue;
+    }
+    KnxAddressStats& t = into[i];
+    t.frames += f.frames;
+    t.repeats += f.repeats;
+    t.bytes += f.bytes;
+    t.reads += f.reads;
+    t.writes += f.writes;
+    t.answers += f.answers;
+    if (f.lastValueLength > 0) {
+      t.lastValue = f.lastValue;
+      t.lastValueLength = f.lastValueLength;
+    }
+  }
+}
+
+const KnxAddressStats& KnxCaptureAnalyzer::getGroupStats(uint16_t address) {
+  static const KnxAddressStats empty = KnxAddressStats();
+  return _groups.empty() ? empty : _groups[address];
+}
+
+const KnxAddressStats& KnxCaptureAnalyzer::getSourceStats(uint16_t address) {
+  static const KnxAddressStats empty = KnxAddressStats();
+  return _sources.empty() ? empty : _sources[address];
+}
+
+int KnxCaptureAnalyzer::getTopGroups(uint16_t* addresses, int count) {
+  return top(_groups, addresses, count);
+}
+
+int KnxCaptureAnalyzer::getTopSources(uint16_t* addresses, int count) {
+  return top(_sources, addresses, count);
+}
+
+int KnxCaptureAnalyzer::top(const std::vector<KnxAddressStats>& stats, uint16_t* addresses, int count) {
+  std::vector<uint16_t> active;
+  for (size_t i = 0; i < stats.size(); i++) {
+    if (stats[i].frames > 0) {
+      active.push_back(i);
+    }
+  }
+
+  int n = std::min((int) active.size(), count);
+  std::partial_sort(active.begin(), active.begin() + n, active.end(), [&stats](uint16_t a, uint16_t b) {
+    return stats[a].frames > stats[b].frames || (stats[a].frames == stats[b].frames && a < b);
+  });
+  std::copy(active.begin(), active.begin() + n, addresses);
+  return n;
+}
+
+unsigned long KnxCaptureAnalyzer::getFrameCount() {
+  return _frames;
+}
+
+unsigned long KnxCaptureAnalyzer::getAckCount() {
+  return _acks;
+}
+
+unsigned long KnxCaptureAnalyzer::getTransmitCount() {
+  return _transmits;
+}
+
+unsigned long KnxCaptureAnalyzer::getBadFrameCount() {
+  return _bad;
+}
@@ -0,0 +1,90 @@
+// File: KnxCaptureAnalyzer.h
+// Offline statistics over large captures (see KnxCapture.h) on the host.
+// The capture is memory-mapped and split into one slice per thread. Each
+// thread decodes its records in batches: the record offsets are collected
+// first, then the fields are extracted column by column with
+// KnxTelegramView, then counted into its own tables. The tables are merged
+// in capture order at the end, so no locking happens while decoding.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxCaptureAnalyzer_h
+#define KnxCaptureAnalyzer_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "KnxCapture.h"
+
+#define KNX_ANALYZER_BATCH 1024
+#define KNX_ANALYZER_ADDRESSES 65536
+
+// Per group address (by target) or per individual address (by source)
+struct KnxAddressStats {
+  uint32_t frames;
+  uint32_t repeats;
+  uint32_t bytes;
+  uint32_t reads;
+  uint32_t writes;
+  uint32_t answers;
+  uint32_t lastValue;        // Up to 4 bytes of the last write or answer, big endian
+  uint8_t lastValueLength;   // 0 = none, 1 for values in the APCI byte
+};
+
+class KnxCaptureAnalyzer {
+  public:
+    KnxCaptureAnalyzer();
+    ~KnxCaptureAnalyzer();
+
+    bool open(const char* path);
+    bool begin(const uint8_t* data, size_t length);
+    void close();
+
+    // Decodes the whole capture, threads = 0 uses all cores.
+    // Returns the number of frames counted.
+    unsigned long run(int threads = 0);
+
+    const KnxAddressStats& getGroupStats(uint16_t address);
+    const KnxAddressStats& getSourceStats(uint16_t address);
+    // Most frames first, returns how many addresses were written
+    int getTopGroups(uint16_t* addresses, int count);
+    int getTopSources(uint16_t* addresses, int count);
+
+    unsigned long getFrameCount();
+    unsigned long getAckCount();
+    unsigned long getTransmitCount();
+    unsigned long getBadFrameCount();  // Truncated or wrong checksum
+
+  private:
+    struct Slice {
+      size_t begin;
+      size_t end;
+      std::vector<KnxAddressStats> groups;
+      std::vector<KnxAddressStats> sources;
+      unsigned long frames;
+      unsigned long acks;
+      unsigned long transmits;
+      unsigned long bad;
+    };
+
+    const uint8_t* _data;
+    size_t _length;
+    void* _map;
+    size_t _map_length;
+    std::vector<KnxAddressStats> _groups;
+    std::vector<KnxAddressStats> _sources;
+    unsigned long _frames;
+    unsigned long _acks;
+    unsigned long _transmits;
+    unsigned long _bad;
+
+    void split(std::vector<Slice>& slices);
+    static void decode(const uint8_t* data, Slice* slice);
+    static void countBatch(const uint8_t* data, const size_t* offsets, int n, Slice* slice);
+    static void merge(std::vector<KnxAddressStats>& into, const std::vector<KnxAddressStats>& from);
+    static int top(const std::vector<KnxAddressStats>& stats, uint16_t* addresses, int count);
+};
+
+#endif
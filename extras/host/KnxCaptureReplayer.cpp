@@ -0,0 +1,112 @@
+// File: KnxCaptureReplayer.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxCaptureReplayer.h"
+
+#include <stdio.h>
+
+#include <chrono>
+#include <thread>
+
+KnxCaptureReplayer::KnxCaptureReplayer(KnxTpUart* knx) {
+  _knx = knx;
+  _knx->setRxRing(&_ring);
+  _data = NULL;
+  _length = 0;
+  _speed = 0;
+  _handler = NULL;
+  _context = NULL;
+  _skipped = 0;
+}
+
+bool KnxCaptureReplayer::load(const char* path) {
+  FILE* file = fopen(path, "rb");
+  if (file == NULL) {
+    return false;
+  }
+
+  _file.clear();
+  uint8_t buf[65536];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), file)) > 0) {
+    _file.insert(_file.end(), buf, buf + n);
+  }
+  fclose(file);
+  return begin(_file.data(), _file.size());
+}
+
+bool KnxCaptureReplayer::begin(const uint8_t* data, size_t length) {
+  _data = data;
+  _length = length;
+  KnxCaptureReader reader;
+  return reader.begin(data, length);
+}
+
+void KnxCaptureReplayer::setSpeed(double speed) {
+  _speed = speed;
+}
+
+void KnxCaptureReplayer::setEventHandler(KnxEventHandler handler, void* context) {
+  _handler = handler;
+  _context = context;
+}
+
+unsigned long KnxCaptureReplayer::run() {
+  KnxCaptureReader reader;
+  if (!reader.begin(_data, _length)) {
+    return 0;
+  }
+
+  bool wasVirtual = hostClockIsVirtual();
+  if (!wasVirtual) {
+    hostClockSetVirtual(true);
+  }
+
+  std::chrono::steady_clock::time_point realStart = std::chrono::steady_clock::now();
+  unsigned long long elapsed = 0;  // capture time since the first record
+  unsigned long previous = 0;
+  unsigned long fed = 0;
+  _skipped = 0;
+
+  KnxCaptureRecord record;
+  while (reader.next(&record)) {
+    if (record.flags & KNX_CAPTURE_TX) {
+      _skipped++;
+      continue;
+    }
+
+    if (fed > 0) {
+      // Timestamps are 32 bit micros(), the difference survives the wrap
+      unsigned long delta = (uint32_t) (record.timestamp - previous);
+      elapsed += delta;
+      hostClockAdvance(delta);
+    }
+    previous = record.timestamp;
+
+    if (_speed > 0) {
+      std::this_thread::sleep_until(realStart + std::chrono::microseconds((long long) (elapsed / _speed)));
+    }
+
+    unsigned long now = micros();
+    for (int i = 0; i < record.length; i++) {
+      _ring.push(record.data[i], now + i * KNX_REPLAY_BYTE_US);
+    }
+    while (_ring.available() > 0) {
+      KnxTpUartSerialEventType event = _knx->serialEvent();
+      if (_handler != NULL) {
+        _handler(_knx, event, _context);
+      }
+    }
+    fed++;
+  }
+
+  if (!wasVirtual) {
+    hostClockSetVirtual(false);
+  }
+  return fed;
+}
+
+unsigned long KnxCaptureReplayer::getSkippedCount() {
+  return _skipped;
+}
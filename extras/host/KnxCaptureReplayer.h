@@ -0,0 +1,53 @@
+// File: KnxCaptureReplayer.h
+// Feeds a KnxCapture back through KnxTpUart::serialEvent() on the host.
+// Received records are pushed into a KnxRxRing with their original spacing
+// and the virtual clock follows the capture, so timeouts behave as they did
+// on the bus. Transmitted records are skipped, the replayed KnxTpUart
+// produces its own.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxCaptureReplayer_h
+#define KnxCaptureReplayer_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "KnxCapture.h"
+#include "KnxEventLoop.h"
+#include "KnxTpUart.h"
+
+// Time one character takes on the bus, used to spread the bytes of a record
+#define KNX_REPLAY_BYTE_US 1146
+
+class KnxCaptureReplayer {
+  public:
+    // Takes over the receive ring of knx
+    KnxCaptureReplayer(KnxTpUart* knx);
+
+    bool load(const char* path);
+    bool begin(const uint8_t* data, size_t length);
+
+    // 1 = original speed, 10 = ten times faster, 0 = as fast as possible
+    void setSpeed(double speed);
+    void setEventHandler(KnxEventHandler handler, void* context = NULL);
+
+    // Replays the whole capture, returns the number of records fed
+    unsigned long run();
+    unsigned long getSkippedCount();
+
+  private:
+    KnxTpUart* _knx;
+    KnxRxRing _ring;
+    std::vector<uint8_t> _file;
+    const uint8_t* _data;
+    size_t _length;
+    double _speed;
+    KnxEventHandler _handler;
+    void* _context;
+    unsigned long _skipped;
+};
+
+#endif
@@ -0,0 +1,120 @@
+// File: KnxEventLoop.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxEventLoop.h"
+
+#include <errno.h>
+#include <poll.h>
+
+KnxEventLoop::KnxEventLoop() {
+  _port_count = 0;
+  _socket_count = 0;
+  _running = false;
+}
+
+bool KnxEventLoop::add(PosixSerial* serial, KnxTpUart* knx, KnxEventHandler handler, void* context) {
+  if (_port_count >= KNX_EVENT_LOOP_MAX_PORTS) {
+    return false;
+  }
+
+  Port* port = &_ports[_port_count++];
+  port->serial = serial;
+  port->knx = knx;
+  port->handler = handler;
+  port->context = context;
+  return true;
+}
+
+bool KnxEventLoop::addSocket(int fd, KnxSocketHandler handler, void* context) {
+  if (_socket_count >= KNX_EVENT_LOOP_MAX_SOCKETS) {
+    return false;
+  }
+
+  Socket* socket = &_sockets[_socket_count++];
+  socket->fd = fd;
+  socket->handler = handler;
+  socket->context = context;
+  return true;
+}
+
+int KnxEventLoop::dispatch(Port* port) {
+  int events = 0;
+  while (port->serial->available() > 0 || port->knx->hasDeferredFrames()) {
+    KnxTpUartSerialEventType event = port->knx->serialEvent();
+    if (port->handler != NULL) {
+      port->handler(port->knx, event, port->context);
+    }
+    events++;
+  }
+
+  while (port->knx->processTxQueue()) {
+  }
+  return events;
+}
+
+int KnxEventLoop::runOnce(int timeoutMs) {
+  struct pollfd fds[KNX_EVENT_LOOP_MAX_PORTS + KNX_EVENT_LOOP_MAX_SOCKETS];
+  for (int i = 0; i < _port_count; i++) {
+    fds[i].fd = _ports[i].serial->getFd();
+    fds[i].events = POLLIN;
+    fds[i].revents = 0;
+  }
+  for (int i = 0; i < _socket_count; i++) {
+    fds[_port_count + i].fd = _sockets[i].fd;
+    fds[_port_count + i].events = POLLIN;
+    fds[_port_count + i].revents = 0;
+  }
+
+  // Bytes may already wait in the PosixSerial buffer, or frames received
+  // during the last send, don't sleep on them. Queued frames are paced by
+  // their port, wake up soon to send them.
+  bool buffered = false;
+  bool queued = false;
+  for (int i = 0; i < _port_count; i++) {
+    buffered = buffered || _ports[i].serial->available() > 0 || _ports[i].knx->hasDeferredFrames();
+    queued = queued || _ports[i].knx->hasQueuedTelegrams();
+  }
+  if (buffered) {
+    timeoutMs = 0;
+  }
+  else if (queued && (timeoutMs < 0 || timeoutMs > KNX_EVENT_LOOP_TX_POLL_MS)) {
+    timeoutMs = KNX_EVENT_LOOP_TX_POLL_MS;
+  }
+
+  int ready = poll(fds, _port_count + _socket_count, timeoutMs);
+  if (ready < 0) {
+    return errno == EINTR ? 0 : -1;
+  }
+
+  int events = 0;
+  for (int i = 0; i < _port_count; i++) {
+    if (fds[i].revents & (POLLERR | POLLNVAL | POLLHUP)) {
+      // Adapter unplugged or tty hung up, poll() would return at once forever
+      return -1;
+    }
+    if ((fds[i].revents & POLLIN) && _ports[i].serial->fill() < 0) {
+      return -1;
+    }
+    events += dispatch(&_ports[i]);
+  }
+  for (int i = 0; i < _socket_count; i++) {
+    bool readable = (fds[_port_count + i].revents & POLLIN) != 0;
+    _sockets[i].handler(_sockets[i].fd, readable, _sockets[i].context);
+    events += readable ? 1 : 0;
+  }
+  return events;
+}
+
+void KnxEventLoop::run() {
+  _running = true;
+  while (_running) {
+    if (runOnce(100) < 0) {
+      break;
+    }
+  }
+}
+
+void KnxEventLoop::stop() {
+  _running = false;
+}
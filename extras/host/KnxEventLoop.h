@@ -0,0 +1,64 @@
+// File: KnxEventLoop.h
+// poll() based event loop for the host build. It sleeps until one of the
+// registered serial ports has data, then calls serialEvent() of the owning
+// KnxTpUart until the buffered bytes and deferred frames are consumed and
+// hands every event to the handler. The loop thread is also the drainer of the transmit queues.
+// Further descriptors (sockets of a KnxIpBridge) are polled alongside;
+// their handlers run once per iteration, after the serial ports.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxEventLoop_h
+#define KnxEventLoop_h
+
+#include "KnxTpUart.h"
+#include "PosixSerial.h"
+
+#define KNX_EVENT_LOOP_MAX_PORTS 4
+#define KNX_EVENT_LOOP_MAX_SOCKETS 4
+
+// Poll interval while frames wait in a transmit queue for their slot
+#define KNX_EVENT_LOOP_TX_POLL_MS 5
+
+typedef void (*KnxEventHandler)(KnxTpUart* knx, KnxTpUartSerialEventType event, void* context);
+
+// readable is false when the handler is only called for its timers
+typedef void (*KnxSocketHandler)(int fd, bool readable, void* context);
+
+class KnxEventLoop {
+  public:
+    KnxEventLoop();
+
+    bool add(PosixSerial* serial, KnxTpUart* knx, KnxEventHandler handler, void* context = NULL);
+    bool addSocket(int fd, KnxSocketHandler handler, void* context = NULL);
+
+    // Waits at most timeoutMs (-1 = forever) and dispatches what arrived.
+    // Returns the number of events handled or -1 if a port failed.
+    int runOnce(int timeoutMs);
+    void run();
+    void stop();
+
+  private:
+    struct Port {
+      PosixSerial* serial;
+      KnxTpUart* knx;
+      KnxEventHandler handler;
+      void* context;
+    };
+
+    struct Socket {
+      int fd;
+      KnxSocketHandler handler;
+      void* context;
+    };
+
+    Port _ports[KNX_EVENT_LOOP_MAX_PORTS];
+    int _port_count;
+    Socket _sockets[KNX_EVENT_LOOP_MAX_SOCKETS];
+    int _socket_count;
+    volatile bool _running;
+
+    int dispatch(Port* port);
+};
+
+#endif
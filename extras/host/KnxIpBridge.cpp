@@ -0,0 +1,632 @@
+// File: KnxIpBridge.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxIpBridge.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// KNXnet/IP services
+#define SERVICE_CONNECT_REQUEST 0x0205
+#define SERVICE_CONNECT_RESPONSE 0x0206
+#define SERVICE_CONNECTIONSTATE_REQUEST 0x0207
+#define SERVICE_CONNECTIONSTATE_RESPONSE 0x0208
+#define SERVICE_DISCONNECT_REQUEST 0x0209
+#define SERVICE_DISCONNECT_RESPONSE 0x020A
+#define SERVICE_TUNNELLING_REQUEST 0x0420
+#define SERVICE_TUNNELLING_ACK 0x0421
+#define SERVICE_ROUTING_INDICATION 0x0530
+#define SERVICE_ROUTING_LOST_MESSAGE 0x0531
+#define SERVICE_ROUTING_BUSY 0x0532
+
+// Status codes
+#define STATUS_OK 0x00
+#define STATUS_CONNECTION_ID 0x21
+#define STATUS_CONNECTION_TYPE 0x22
+#define STATUS_NO_MORE_CONNECTIONS 0x24
+#define STATUS_TUNNELLING_LAYER 0x29
+
+#define TUNNEL_CONNECTION 0x04
+#define TUNNEL_LINKLAYER 0x02
+
+#define HPAI_SIZE 8
+#define CONNECTION_HEADER_SIZE 4
+
+// Origins of queued frames besides the tunnel indices
+#define ORIGIN_ROUTING -1
+#define ORIGIN_NONE -2
+
+KnxIpBridge::KnxIpBridge(KnxTpUart* knx, KnxTxQueue* queue) {
+  _knx = knx;
+  _queue = queue;
+  _routing_fd = -1;
+  _tunnelling_fd = -1;
+  memset(&_routing_peer, 0, sizeof(_routing_peer));
+  for (int i = 0; i < KNX_IP_MAX_TUNNELS; i++) {
+    _tunnels[i].open = false;
+  }
+  _pending_head = 0;
+  _pending_count = 0;
+  _tunnel_address = knx->getIndividualAddress() + 1;
+  _busy_sent_at = millis() - KNX_IP_BUSY_WAIT_MS;
+  _lost_reported = 0;
+  memset(&_stats, 0, sizeof(_stats));
+
+  knx->setMonitorRing(&_ring);
+  knx->setTxConfirmHandler(txConfirmHandler, this);
+}
+
+KnxIpBridge::~KnxIpBridge() {
+  end();
+}
+
+// A multicast routing socket is bound to its group, so that routing and
+// tunnelling can share port 3671
+static int openSocket(struct in_addr address, int port) {
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  int yes = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+  struct sockaddr_in local;
+  memset(&local, 0, sizeof(local));
+  local.sin_family = AF_INET;
+  local.sin_addr = address;
+  local.sin_port = htons(port);
+  if (bind(fd, (struct sockaddr*) &local, sizeof(local)) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+static int localPort(int fd) {
+  struct sockaddr_in local;
+  socklen_t length = sizeof(local);
+  if (fd < 0 || getsockname(fd, (struct sockaddr*) &local, &length) < 0) {
+    return -1;
+  }
+  return ntohs(local.sin_port);
+}
+
+bool KnxIpBridge::beginRouting(const char* address, int port, int localPort) {
+  memset(&_routing_peer, 0, sizeof(_routing_peer));
+  _routing_peer.sin_family = AF_INET;
+  _routing_peer.sin_port = htons(port);
+  if (inet_pton(AF_INET, address, &_routing_peer.sin_addr) != 1) {
+    return false;
+  }
+
+  bool multicast = IN_MULTICAST(ntohl(_routing_peer.sin_addr.s_addr));
+  struct in_addr any;
+  any.s_addr = htonl(INADDR_ANY);
+  _routing_fd = openSocket(multicast ? _routing_peer.sin_addr : any, localPort < 0 ? port : localPort);
+  if (_routing_fd < 0) {
+    return false;
+  }
+  if (multicast) {
+    struct ip_mreq membership;
+    membership.imr_multiaddr = _routing_peer.sin_addr;
+    membership.imr_interface.s_addr = htonl(INADDR_ANY);
+    // Our own indications must not come back to us
+    unsigned char loop = 0;
+    if (setsockopt(_routing_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) < 0
+        || setsockopt(_routing_fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) < 0) {
+      close(_routing_fd);
+      _routing_fd = -1;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool KnxIpBridge::beginTunnelling(int port) {
+  struct in_addr any;
+  any.s_addr = htonl(INADDR_ANY);
+  _tunnelling_fd = openSocket(any, port);
+  if (_tunnelling_fd < 0) {
+    return false;
+  }
+  // Only unicast, even with the routing group joined on the same port
+  int multicastAll = 0;
+  setsockopt(_tunnelling_fd, IPPROTO_IP, IP_MULTICAST_ALL, &multicastAll, sizeof(multicastAll));
+  return true;
+}
+
+void KnxIpBridge::end() {
+  for (int i = 0; i < KNX_IP_MAX_TUNNELS; i++) {
+    if (_tunnels[i].open) {
+      closeTunnel(&_tunnels[i], true);
+    }
+  }
+  if (_routing_fd >= 0) {
+    close(_routing_fd);
+    _routing_fd = -1;
+  }
+  if (_tunnelling_fd >= 0) {
+    close(_tunnelling_fd);
+    _tunnelling_fd = -1;
+  }
+}
+
+int KnxIpBridge::getRoutingPort() {
+  return localPort(_routing_fd);
+}
+
+int KnxIpBridge::getTunnellingPort() {
+  return localPort(_tunnelling_fd);
+}
+
+void KnxIpBridge::setTunnelAddress(uint16_t address) {
+  _tunnel_address = address;
+}
+
+bool KnxIpBridge::attach(KnxEventLoop* loop) {
+  bool ok = true;
+  if (_routing_fd >= 0) {
+    ok = loop->addSocket(_routing_fd, socketHandler, this) && ok;
+  }
+  if (_tunnelling_fd >= 0) {
+    ok = loop->addSocket(_tunnelling_fd, socketHandler, this) && ok;
+  }
+  return ok;
+}
+
+int KnxIpBridge::getTunnelCount() {
+  int count = 0;
+  for (int i = 0; i < KNX_IP_MAX_TUNNELS; i++) {
+    count += _tunnels[i].open ? 1 : 0;
+  }
+  return count;
+}
+
+KnxIpStats KnxIpBridge::getStats() {
+  return _stats;
+}
+
+void KnxIpBridge::socketHandler(int fd, bool readable, void* context) {
+  ((KnxIpBridge*) context)->service(fd, readable);
+}
+
+void KnxIpBridge::txConfirmHandler(const uint8_t* frame, int length, bool confirmed, void* context) {
+  ((KnxIpBridge*) context)->txConfirmed(frame, length, confirmed);
+}
+
+void KnxIpBridge::service(int fd, bool readable) {
+  if (readable) {
+    receivePackets(fd);
+  }
+  drainRing();
+  timers();
+}
+
+void KnxIpBridge::receivePackets(int fd) {
+  uint8_t packet[256];
+  while (true) {
+    struct sockaddr_in from;
+    socklen_t fromLength = sizeof(from);
+    int length = recvfrom(fd, packet, sizeof(packet), 0, (struct sockaddr*) &from, &fromLength);
+    if (length < 0) {
+      // EAGAIN: all read
+      return;
+    }
+    if (length < KNX_IP_HEADER_SIZE || packet[0] != 0x06 || packet[1] != 0x10
+        || ((packet[4] << 8) | packet[5]) != length) {
+      continue;
+    }
+    if (fd == _routing_fd) {
+      handleRouting(packet, length);
+    }
+    else {
+      handleTunnelling(packet, length, &from);
+    }
+  }
+}
+
+// Routing
+
+void KnxIpBridge::handleRouting(uint8_t* packet, int length) {
+  uint16_t service = (packet[2] << 8) | packet[3];
+  if (service != SERVICE_ROUTING_INDICATION || packet[KNX_IP_HEADER_SIZE] != KNX_CEMI_LDATA_IND) {
+    return;
+  }
+  queueForBus(packet + KNX_IP_HEADER_SIZE, length - KNX_IP_HEADER_SIZE, ORIGIN_ROUTING);
+}
+
+void KnxIpBridge::sendRoutingService(uint16_t service, const uint8_t* body, int length) {
+  uint8_t packet[KNX_IP_MAX_PACKET];
+  int position = writeHeader(packet, service, KNX_IP_HEADER_SIZE + length);
+  memcpy(packet + position, body, length);
+  sendTo(_routing_fd, packet, position + length, &_routing_peer);
+}
+
+// Tunnelling
+
+void KnxIpBridge::handleTunnelling(uint8_t* packet, int length, struct sockaddr_in* from) {
+  uint16_t service = (packet[2] << 8) | packet[3];
+  uint8_t response[KNX_IP_MAX_PACKET];
+
+  switch (service) {
+    case SERVICE_CONNECT_REQUEST:
+      connect(packet, length, from);
+      break;
+
+    case SERVICE_CONNECTIONSTATE_REQUEST:
+    case SERVICE_DISCONNECT_REQUEST: {
+      if (length < KNX_IP_HEADER_SIZE + 2 + HPAI_SIZE) {
+        return;
+      }
+      KnxIpTunnel* tunnel = findTunnel(packet[6]);
+      struct sockaddr_in control;
+      readHpai(packet + 8, &control, from);
+      int position = writeHeader(response, service + 1, KNX_IP_HEADER_SIZE + 2);
+      response[position++] = packet[6];
+      response[position++] = tunnel != NULL ? STATUS_OK : STATUS_CONNECTION_ID;
+      sendTo(_tunnelling_fd, response, position, &control);
+      if (tunnel != NULL) {
+        tunnel->lastActivity = millis();
+        if (service == SERVICE_DISCONNECT_REQUEST) {
+          closeTunnel(tunnel, false);
+        }
+      }
+      break;
+    }
+
+    case SERVICE_TUNNELLING_REQUEST:
+      tunnellingRequest(packet, length);
+      break;
+
+    case SERVICE_TUNNELLING_ACK:
+      tunnellingAck(packet, length);
+      break;
+  }
+}
+
+void KnxIpBridge::connect(uint8_t* packet, int length, struct sockaddr_in* from) {
+  if (length < KNX_IP_HEADER_SIZE + 2 * HPAI_SIZE + 4) {
+    return;
+  }
+  struct sockaddr_in control;
+  struct sockaddr_in data;
+  readHpai(packet + KNX_IP_HEADER_SIZE, &control, from);
+  readHpai(packet + KNX_IP_HEADER_SIZE + HPAI_SIZE, &data, from);
+  const uint8_t* cri = packet + KNX_IP_HEADER_SIZE + 2 * HPAI_SIZE;
+
+  uint8_t status = STATUS_OK;
+  KnxIpTunnel* tunnel = NULL;
+  if (cri[1] != TUNNEL_CONNECTION) {
+    status = STATUS_CONNECTION_TYPE;
+  }
+  else if (cri[2] != TUNNEL_LINKLAYER) {
+    status = STATUS_TUNNELLING_LAYER;
+  }
+  else {
+    for (int i = 0; i < KNX_IP_MAX_TUNNELS && tunnel == NULL; i++) {
+      if (!_tunnels[i].open) {
+        tunnel = &_tunnels[i];
+        tunnel->channel = i + 1;
+        tunnel->address = _tunnel_address + i;
+      }
+    }
+    if (tunnel == NULL) {
+      status = STATUS_NO_MORE_CONNECTIONS;
+    }
+  }
+
+  uint8_t response[KNX_IP_MAX_PACKET];
+  int position = KNX_IP_HEADER_SIZE;
+  response[position++] = tunnel != NULL ? tunnel->channel : 0;
+  response[position++] = status;
+  if (tunnel != NULL) {
+    tunnel->open = true;
+    tunnel->control = control;
+    tunnel->data = data;
+    tunnel->receiveSequence = 0;
+    tunnel->sendSequence = 0;
+    tunnel->lastActivity = millis();
+    tunnel->queueHead = 0;
+    tunnel->queueCount = 0;
+    tunnel->waiting = false;
+
+    struct sockaddr_in local;
+    socklen_t localLength = sizeof(local);
+    getsockname(_tunnelling_fd, (struct sockaddr*) &local, &localLength);
+    position += writeHpai(response + position, &local);
+
+    // CRD with the individual address of the tunnel
+    response[position++] = 4;
+    response[position++] = TUNNEL_CONNECTION;
+    response[position++] = tunnel->address >> 8;
+    response[position++] = tunnel->address & 0xFF;
+  }
+  writeHeader(response, SERVICE_CONNECT_RESPONSE, position);
+  sendTo(_tunnelling_fd, response, position, &control);
+}
+
+void KnxIpBridge::tunnellingRequest(uint8_t* packet, int length) {
+  if (length < KNX_IP_HEADER_SIZE + CONNECTION_HEADER_SIZE + 2) {
+    return;
+  }
+  KnxIpTunnel* tunnel = findTunnel(packet[7]);
+  if (tunnel == NULL) {
+    return;
+  }
+  uint8_t sequence = packet[8];
+  uint8_t* cemi = packet + KNX_IP_HEADER_SIZE + CONNECTION_HEADER_SIZE;
+  int cemiLength = length - KNX_IP_HEADER_SIZE - CONNECTION_HEADER_SIZE;
+
+  if (sequence == tunnel->receiveSequence) {
+    if (cemi[0] == KNX_CEMI_LDATA_REQ) {
+      // An empty source is the address of the tunnel
+      int source = 4 + cemi[1];
+      if (cemiLength > source + 1 && cemi[source] == 0 && cemi[source + 1] == 0) {
+        cemi[source] = tunnel->address >> 8;
+        cemi[source + 1] = tunnel->address & 0xFF;
+      }
+      if (!queueForBus(cemi, cemiLength, tunnel - _tunnels)) {
+        // Not acknowledged, the client repeats it
+        _stats.tunnelRefused++;
+        return;
+      }
+    }
+    tunnel->receiveSequence++;
+  }
+  else if (sequence != (uint8_t) (tunnel->receiveSequence - 1)) {
+    return;
+  }
+  // else: our ack got lost, acknowledge again
+
+  tunnel->lastActivity = millis();
+  uint8_t ack[KNX_IP_HEADER_SIZE + CONNECTION_HEADER_SIZE];
+  int position = writeHeader(ack, SERVICE_TUNNELLING_ACK, sizeof(ack));
+  ack[position++] = CONNECTION_HEADER_SIZE;
+  ack[position++] = tunnel->channel;
+  ack[position++] = sequence;
+  ack[position++] = STATUS_OK;
+  sendTo(_tunnelling_fd, ack, position, &tunnel->data);
+}
+
+void KnxIpBridge::tunnellingAck(uint8_t* packet, int length) {
+  if (length < KNX_IP_HEADER_SIZE + CONNECTION_HEADER_SIZE) {
+    return;
+  }
+  KnxIpTunnel* tunnel = findTunnel(packet[7]);
+  if (tunnel == NULL || !tunnel->waiting || packet[8] != tunnel->sendSequence) {
+    return;
+  }
+  tunnel->lastActivity = millis();
+  tunnel->waiting = false;
+  tunnel->sendSequence++;
+  tunnel->queueHead = (tunnel->queueHead + 1) % KNX_IP_TUNNEL_QUEUE_SIZE;
+  tunnel->queueCount--;
+  sendNext(tunnel);
+}
+
+KnxIpTunnel* KnxIpBridge::findTunnel(int channel) {
+  if (channel < 1 || channel > KNX_IP_MAX_TUNNELS || !_tunnels[channel - 1].open) {
+    return NULL;
+  }
+  return &_tunnels[channel - 1];
+}
+
+void KnxIpBridge::closeTunnel(KnxIpTunnel* tunnel, bool notify) {
+  if (notify) {
+    uint8_t request[KNX_IP_HEADER_SIZE + 2 + HPAI_SIZE];
+    int position = writeHeader(request, SERVICE_DISCONNECT_REQUEST, sizeof(request));
+    request[position++] = tunnel->channel;
+    request[position++] = 0;
+    struct sockaddr_in local;
+    socklen_t localLength = sizeof(local);
+    getsockname(_tunnelling_fd, (struct sockaddr*) &local, &localLength);
+    position += writeHpai(request + position, &local);
+    sendTo(_tunnelling_fd, request, position, &tunnel->control);
+  }
+  tunnel->open = false;
+
+  // Confirmations still to come are dropped
+  for (int i = 0; i < _pending_count; i++) {
+    KnxIpPending* pending = &_pending[(_pending_head + i) % TPUART_TX_QUEUE_SIZE];
+    if (pending->origin == tunnel - _tunnels) {
+      pending->origin = ORIGIN_NONE;
+    }
+  }
+}
+
+bool KnxIpBridge::enqueue(KnxIpTunnel* tunnel, const uint8_t* frame, uint8_t messageCode, bool error) {
+  if (tunnel->queueCount >= KNX_IP_TUNNEL_QUEUE_SIZE) {
+    _stats.tunnelDropped++;
+    return false;
+  }
+
+  // Built in place; the sequence number is filled in when it is sent
+  KnxIpPacket* packet = &tunnel->queue[(tunnel->queueHead + tunnel->queueCount) % KNX_IP_TUNNEL_QUEUE_SIZE];
+  uint8_t* p = packet->data + KNX_IP_HEADER_SIZE;
+  p[0] = CONNECTION_HEADER_SIZE;
+  p[1] = tunnel->channel;
+  p[2] = 0;
+  p[3] = 0;
+  int cemiLength = knxFrameToCemi(frame, messageCode, p + CONNECTION_HEADER_SIZE, KNX_CEMI_MAX_SIZE);
+  if (error) {
+    p[CONNECTION_HEADER_SIZE + 2] |= KNX_CEMI_CONFIRM_ERROR;
+  }
+  packet->length = KNX_IP_HEADER_SIZE + CONNECTION_HEADER_SIZE + cemiLength;
+  writeHeader(packet->data, SERVICE_TUNNELLING_REQUEST, packet->length);
+  tunnel->queueCount++;
+
+  if (!tunnel->waiting) {
+    sendNext(tunnel);
+  }
+  return true;
+}
+
+void KnxIpBridge::sendNext(KnxIpTunnel* tunnel) {
+  if (tunnel->queueCount == 0) {
+    return;
+  }
+  KnxIpPacket* packet = &tunnel->queue[tunnel->queueHead];
+  packet->data[KNX_IP_HEADER_SIZE + 2] = tunnel->sendSequence;
+  sendTo(_tunnelling_fd, packet->data, packet->length, &tunnel->data);
+  tunnel->waiting = true;
+  tunnel->repeats = 0;
+  tunnel->sentAt = millis();
+}
+
+// Bus side
+
+bool KnxIpBridge::queueForBus(uint8_t* cemi, int length, int origin) {
+  KnxIpPending* pending = &_pending[(_pending_head + _pending_count) % TPUART_TX_QUEUE_SIZE];
+  int frameLength = knxCemiToFrame(cemi, length, pending->frame);
+  if (frameLength == 0) {
+    // Not for TP1, but no reason to make the client repeat it
+    return true;
+  }
+
+  if (origin == ORIGIN_ROUTING && _queue->size() >= KNX_IP_BUSY_THRESHOLD
+      && millis() - _busy_sent_at >= KNX_IP_BUSY_WAIT_MS) {
+    uint8_t busy[6] = { 6, 0, KNX_IP_BUSY_WAIT_MS >> 8, KNX_IP_BUSY_WAIT_MS & 0xFF, 0, 0 };
+    sendRoutingService(SERVICE_ROUTING_BUSY, busy, sizeof(busy));
+    _busy_sent_at = millis();
+    _stats.routingBusy++;
+  }
+
+  if (_pending_count >= TPUART_TX_QUEUE_SIZE || !_queue->push(pending->frame, frameLength)) {
+    if (origin == ORIGIN_ROUTING) {
+      _stats.routingLost++;
+    }
+    return false;
+  }
+  pending->origin = origin;
+  pending->length = frameLength;
+  _pending_count++;
+  _stats.ipToBus++;
+  return true;
+}
+
+void KnxIpBridge::txConfirmed(const uint8_t* frame, int length, bool confirmed) {
+  // Frames queued by others (the sketch) are not in _pending
+  int origin = ORIGIN_NONE;
+  if (_pending_count > 0) {
+    KnxIpPending* pending = &_pending[_pending_head];
+    if (pending->length == length && memcmp(pending->frame, frame, length) == 0) {
+      origin = pending->origin;
+      _pending_head = (_pending_head + 1) % TPUART_TX_QUEUE_SIZE;
+      _pending_count--;
+    }
+  }
+
+  if (confirmed) {
+    _stats.confirmed++;
+  }
+  else {
+    _stats.notConfirmed++;
+  }
+  if (origin >= 0 && _tunnels[origin].open) {
+    enqueue(&_tunnels[origin], frame, KNX_CEMI_LDATA_CON, !confirmed);
+  }
+  if (confirmed) {
+    // The frame is on the bus now, the other clients see it there
+    indicate(frame, origin, origin != ORIGIN_ROUTING);
+  }
+}
+
+void KnxIpBridge::drainRing() {
+  KnxMonitorRecord record;
+  while (_ring.read(&record)) {
+    if (record.type == KNX_MONITOR_FRAME && KnxTelegramView(record.data).verifyChecksum()) {
+      indicate(record.data, -1, true);
+    }
+  }
+}
+
+void KnxIpBridge::indicate(const uint8_t* frame, int except, bool routing) {
+  _stats.busToIp++;
+  if (routing && _routing_fd >= 0) {
+    uint8_t packet[KNX_IP_MAX_PACKET];
+    int cemiLength = knxFrameToCemi(frame, KNX_CEMI_LDATA_IND, packet + KNX_IP_HEADER_SIZE, KNX_CEMI_MAX_SIZE);
+    int length = writeHeader(packet, SERVICE_ROUTING_INDICATION, KNX_IP_HEADER_SIZE + cemiLength) + cemiLength;
+    sendTo(_routing_fd, packet, length, &_routing_peer);
+  }
+  for (int i = 0; i < KNX_IP_MAX_TUNNELS; i++) {
+    if (_tunnels[i].open && i != except) {
+      enqueue(&_tunnels[i], frame, KNX_CEMI_LDATA_IND, false);
+    }
+  }
+}
+
+void KnxIpBridge::timers() {
+  unsigned long now = millis();
+  for (int i = 0; i < KNX_IP_MAX_TUNNELS; i++) {
+    KnxIpTunnel* tunnel = &_tunnels[i];
+    if (!tunnel->open) {
+      continue;
+    }
+    if (now - tunnel->lastActivity >= KNX_IP_CONNECTION_TIMEOUT_MS) {
+      closeTunnel(tunnel, true);
+      continue;
+    }
+    if (tunnel->waiting && now - tunnel->sentAt >= KNX_IP_ACK_TIMEOUT_MS) {
+      if (tunnel->repeats > 0) {
+        // Twice without ack, the client is gone
+        closeTunnel(tunnel, true);
+        continue;
+      }
+      KnxIpPacket* packet = &tunnel->queue[tunnel->queueHead];
+      sendTo(_tunnelling_fd, packet->data, packet->length, &tunnel->data);
+      tunnel->repeats++;
+      tunnel->sentAt = now;
+      _stats.tunnelRepeats++;
+    }
+  }
+
+  if (_stats.routingLost != _lost_reported && _routing_fd >= 0) {
+    unsigned long lost = _stats.routingLost - _lost_reported;
+    uint8_t body[4] = { 4, 0, (uint8_t) (lost >> 8), (uint8_t) lost };
+    sendRoutingService(SERVICE_ROUTING_LOST_MESSAGE, body, sizeof(body));
+    _lost_reported = _stats.routingLost;
+  }
+}
+
+// Packets
+
+void KnxIpBridge::sendTo(int fd, const uint8_t* packet, int length, struct sockaddr_in* to) {
+  // Datagrams, a full socket buffer loses the packet like the network would
+  sendto(fd, packet, length, 0, (struct sockaddr*) to, sizeof(*to));
+}
+
+int KnxIpBridge::writeHeader(uint8_t* packet, uint16_t service, int length) {
+  packet[0] = 0x06;
+  packet[1] = 0x10;
+  packet[2] = service >> 8;
+  packet[3] = service & 0xFF;
+  packet[4] = length >> 8;
+  packet[5] = length & 0xFF;
+  return KNX_IP_HEADER_SIZE;
+}
+
+int KnxIpBridge::writeHpai(uint8_t* out, struct sockaddr_in* address) {
+  // UDP over IPv4
+  out[0] = HPAI_SIZE;
+  out[1] = 0x01;
+  memcpy(out + 2, &address->sin_addr.s_addr, 4);
+  memcpy(out + 6, &address->sin_port, 2);
+  return HPAI_SIZE;
+}
+
+void KnxIpBridge::readHpai(const uint8_t* hpai, struct sockaddr_in* address, struct sockaddr_in* fallback) {
+  memset(address, 0, sizeof(*address));
+  address->sin_family = AF_INET;
+  memcpy(&address->sin_addr.s_addr, hpai + 2, 4);
+  memcpy(&address->sin_port, hpai + 6, 2);
+  if (address->sin_addr.s_addr == 0 || address->sin_port == 0) {
+    // Behind NAT: answer where the packet came from
+    *address = *fallback;
+  }
+}
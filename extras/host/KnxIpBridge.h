@@ -0,0 +1,157 @@
+// File: KnxIpBridge.h
+// KNXnet/IP routing (multicast) and tunnelling (UDP) for the TP-UART line
+// of a Linux gateway. Bus frames are taken from a KnxMonitorRing, so the
+// frames that arrive while a send waits for its confirmation get through
+// as well, and written as cEMI L_Data.ind straight into the outgoing
+// packets. Requests from IP are converted into TP1 frames and queued in
+// the transmit queue of the KnxTpUart; tunnel clients get their
+// L_Data.con once the TP-UART confirmed the frame.
+//
+// Flow control: a tunnelling request is only acknowledged if its frame
+// could be queued (the client repeats it otherwise), routing peers are
+// sent ROUTING_BUSY while the queue fills up and ROUTING_LOST_MESSAGE when
+// indications had to be dropped. The sockets are non-blocking and served
+// by a KnxEventLoop together with the serial port.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxIpBridge_h
+#define KnxIpBridge_h
+
+#include <netinet/in.h>
+#include <stdint.h>
+
+#include "KnxEventLoop.h"
+#include "KnxTpUart.h"
+
+#define KNX_IP_PORT 3671
+#define KNX_IP_MULTICAST_ADDRESS "224.0.23.12"
+
+// Simultaneous tunnelling connections
+#define KNX_IP_MAX_TUNNELS 4
+
+// Packets per tunnel waiting for the TUNNELLING_ACK of their predecessor
+#define KNX_IP_TUNNEL_QUEUE_SIZE 32
+
+#define KNX_IP_ACK_TIMEOUT_MS 1000
+#define KNX_IP_CONNECTION_TIMEOUT_MS 120000
+
+// ROUTING_BUSY is sent once this many frames wait in the transmit queue
+#define KNX_IP_BUSY_THRESHOLD (TPUART_TX_QUEUE_SIZE - 2)
+#define KNX_IP_BUSY_WAIT_MS 100
+
+#define KNX_IP_HEADER_SIZE 6
+#define KNX_IP_MAX_PACKET 64
+
+struct KnxIpStats {
+  unsigned long busToIp;        // Bus frames (received or sent) indicated
+  unsigned long ipToBus;        // Frames queued for the bus
+  unsigned long confirmed;
+  unsigned long notConfirmed;
+  unsigned long routingBusy;    // ROUTING_BUSY sent
+  unsigned long routingLost;    // Routing indications dropped, queue full
+  unsigned long tunnelRefused;  // Tunnelling requests not acknowledged, queue full
+  unsigned long tunnelDropped;  // Packets to a tunnel client dropped, its queue full
+  unsigned long tunnelRepeats;  // Packets repeated for lack of TUNNELLING_ACK
+};
+
+struct KnxIpPacket {
+  uint8_t length;
+  uint8_t data[KNX_IP_MAX_PACKET];
+};
+
+struct KnxIpTunnel {
+  bool open;
+  uint8_t channel;
+  uint16_t address;
+  struct sockaddr_in control;
+  struct sockaddr_in data;
+  uint8_t receiveSequence;
+  uint8_t sendSequence;
+  unsigned long lastActivity;
+  // Packets to the client, the first one is sent and waits for its ack
+  KnxIpPacket queue[KNX_IP_TUNNEL_QUEUE_SIZE];
+  uint8_t queueHead;
+  uint8_t queueCount;
+  bool waiting;
+  uint8_t repeats;
+  unsigned long sentAt;
+};
+
+// Frame queued from IP, matched against the transmit confirmations
+struct KnxIpPending {
+  int8_t origin;  // Tunnel index, or one of the origins below
+  uint8_t length;
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+};
+
+class KnxIpBridge {
+  public:
+    // queue must be the transmit queue of knx. The bridge takes over the
+    // monitor ring and the transmit confirm handler of knx.
+    KnxIpBridge(KnxTpUart* knx, KnxTxQueue* queue);
+    ~KnxIpBridge();
+
+    // Joins address if it is a multicast group, otherwise sends to it as
+    // unicast peer (loopback tests). localPort 0 picks a free port, -1
+    // means the same as port.
+    bool beginRouting(const char* address = KNX_IP_MULTICAST_ADDRESS, int port = KNX_IP_PORT, int localPort = -1);
+    bool beginTunnelling(int port = KNX_IP_PORT);
+    void end();
+    int getRoutingPort();
+    int getTunnellingPort();
+
+    // Individual address of the first tunnel, the others follow
+    void setTunnelAddress(uint16_t address);
+
+    // Registers the sockets; the serial port must be added by the caller
+    bool attach(KnxEventLoop* loop);
+    // Without a KnxEventLoop: serve readable sockets and the timers
+    void service(int fd, bool readable);
+
+    int getTunnelCount();
+    KnxIpStats getStats();
+
+  private:
+    KnxTpUart* _knx;
+    KnxTxQueue* _queue;
+    KnxMonitorRing _ring;
+    int _routing_fd;
+    int _tunnelling_fd;
+    struct sockaddr_in _routing_peer;
+    KnxIpTunnel _tunnels[KNX_IP_MAX_TUNNELS];
+    KnxIpPending _pending[TPUART_TX_QUEUE_SIZE];
+    uint8_t _pending_head;
+    uint8_t _pending_count;
+    uint16_t _tunnel_address;
+    unsigned long _busy_sent_at;
+    unsigned long _lost_reported;
+    KnxIpStats _stats;
+
+    static void socketHandler(int fd, bool readable, void* context);
+    static void txConfirmHandler(const uint8_t* frame, int length, bool confirmed, void* context);
+
+    void receivePackets(int fd);
+    void handleRouting(uint8_t* packet, int length);
+    void handleTunnelling(uint8_t* packet, int length, struct sockaddr_in* from);
+    void connect(uint8_t* packet, int length, struct sockaddr_in* from);
+    void tunnellingRequest(uint8_t* packet, int length);
+    void tunnellingAck(uint8_t* packet, int length);
+    bool queueForBus(uint8_t* cemi, int length, int origin);
+    void txConfirmed(const uint8_t* frame, int length, bool confirmed);
+    void indicate(const uint8_t* frame, int except, bool routing);
+    void drainRing();
+    void timers();
+
+    KnxIpTunnel* findTunnel(int channel);
+    void closeTunnel(KnxIpTunnel*, bool notify);
+    bool enqueue(KnxIpTunnel*, const uint8_t* frame, uint8_t messageCode, bool error);
+    void sendNext(KnxIpTunnel*);
+    void sendRoutingService(uint16_t service, const uint8_t* body, int length);
+    void sendTo(int fd, const uint8_t* packet, int length, struct sockaddr_in* to);
+    static int writeHeader(uint8_t* packet, uint16_t service, int length);
+    static int writeHpai(uint8_t* out, struct sockaddr_in* address);
+    static void readHpai(const uint8_t* hpai, struct sockaddr_in* address, struct sockaddr_in* fallback);
+};
+
+#endif
@@ -0,0 +1,194 @@
+// File: PosixSerial.cpp
+
+// Last modified: 18.10.2026
+
+#include "PosixSerial.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+static speed_t baudToSpeed(unsigned long baud) {
+  switch (baud) {
+    case 9600:
+      return B9600;
+    case 19200:
+      return B19200;
+    case 38400:
+      return B38400;
+    case 57600:
+      return B57600;
+    case 115200:
+      return B115200;
+    default:
+      return B0;
+  }
+}
+
+PosixSerial::PosixSerial() {
+  _fd = -1;
+  _owns_fd = false;
+  _head = 0;
+  _tail = 0;
+}
+
+PosixSerial::~PosixSerial() {
+  end();
+}
+
+bool PosixSerial::begin(const char* device, unsigned long baud) {
+  end();
+  int fd = open(device, O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (fd < 0) {
+    return false;
+  }
+  if (!attach(fd, baud)) {
+    close(fd);
+    return false;
+  }
+  _owns_fd = true;
+  return true;
+}
+
+bool PosixSerial::attach(int fd, unsigned long baud) {
+  end();
+  _fd = fd;
+  _owns_fd = false;
+  _head = 0;
+  _tail = 0;
+
+  int flags = fcntl(_fd, F_GETFL);
+  if (flags < 0 || fcntl(_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+    _fd = -1;
+    return false;
+  }
+  if (!configure(baud)) {
+    _fd = -1;
+    return false;
+  }
+  return true;
+}
+
+bool PosixSerial::configure(unsigned long baud) {
+  speed_t speed = baudToSpeed(baud);
+  if (speed == B0) {
+    return false;
+  }
+
+  struct termios tio;
+  if (tcgetattr(_fd, &tio) < 0) {
+    return false;
+  }
+
+  cfmakeraw(&tio);
+  // 8 data bits, even parity, 1 stop bit
+  tio.c_cflag &= ~(CSIZE | PARODD | CSTOPB | CRTSCTS);
+  tio.c_cflag |= CS8 | PARENB | CLOCAL | CREAD;
+  tio.c_iflag &= ~(IXON | IXOFF | IXANY);
+  tio.c_cc[VMIN] = 0;
+  tio.c_cc[VTIME] = 0;
+  cfsetispeed(&tio, speed);
+  cfsetospeed(&tio, speed);
+
+  return tcsetattr(_fd, TCSANOW, &tio) == 0;
+}
+
+void PosixSerial::end() {
+  if (_fd >= 0 && _owns_fd) {
+    close(_fd);
+  }
+  _fd = -1;
+  _owns_fd = false;
+}
+
+int PosixSerial::getFd() {
+  return _fd;
+}
+
+int PosixSerial::fill() {
+  if (_fd < 0) {
+    return -1;
+  }
+
+  // Compact so the free space is contiguous
+  if (_head > 0) {
+    memmove(_buffer, _buffer + _head, _tail - _head);
+    _tail -= _head;
+    _head = 0;
+  }
+  if (_tail >= POSIX_SERIAL_BUFFER_SIZE) {
+    return 0;
+  }
+
+  ssize_t n = ::read(_fd, _buffer + _tail, POSIX_SERIAL_BUFFER_SIZE - _tail);
+  if (n > 0) {
+    _tail += n;
+    return n;
+  }
+  if (n == 0) {
+    // End of file, the device hung up
+    return -1;
+  }
+  if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+    return 0;
+  }
+  return -1;
+}
+
+int PosixSerial::available() {
+  if (_head == _tail) {
+    fill();
+  }
+  return _tail - _head;
+}
+
+int PosixSerial::read() {
+  if (available() == 0) {
+    return -1;
+  }
+  return _buffer[_head++];
+}
+
+int PosixSerial::peek() {
+  if (available() == 0) {
+    return -1;
+  }
+  return _buffer[_head];
+}
+
+size_t PosixSerial::write(uint8_t b) {
+  return write(&b, 1);
+}
+
+size_t PosixSerial::write(const uint8_t* buffer, size_t size) {
+  if (_fd < 0) {
+    return 0;
+  }
+
+  size_t written = 0;
+  while (written < size) {
+    ssize_t n = ::write(_fd, buffer + written, size - written);
+    if (n > 0) {
+      written += n;
+    }
+    else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      struct pollfd pfd = { _fd, POLLOUT, 0 };
+      poll(&pfd, 1, 100);
+    }
+    else if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    else {
+      break;
+    }
+  }
+  return written;
+}
+
+void PosixSerial::flush() {
+  if (_fd >= 0) {
+    tcdrain(_fd);
+  }
+}
@@ -0,0 +1,49 @@
+// File: PosixSerial.h
+// Stream on top of a POSIX serial device (termios), so KnxTpUart can drive
+// a TP-UART from a Linux gateway. The descriptor is non-blocking; bytes are
+// buffered on read so peek() works like on the Arduino cores.
+
+// Last modified: 18.10.2026
+
+#ifndef PosixSerial_h
+#define PosixSerial_h
+
+#include "Arduino.h"
+
+#define POSIX_SERIAL_BUFFER_SIZE 256
+
+class PosixSerial : public Stream {
+  public:
+    PosixSerial();
+    ~PosixSerial();
+
+    // Opens and configures the device for 8E1 as the TP-UART expects
+    bool begin(const char* device, unsigned long baud = 19200);
+    // Takes over an already open descriptor, e.g. one side of a pty pair
+    bool attach(int fd, unsigned long baud = 19200);
+    void end();
+    int getFd();
+
+    // Moves whatever the descriptor has ready into the buffer, returns the
+    // number of bytes read or -1 if the device went away
+    int fill();
+
+    int available();
+    int read();
+    int peek();
+    size_t write(uint8_t b);
+    size_t write(const uint8_t* buffer, size_t size);
+    void flush();
+    using Print::write;
+
+  private:
+    int _fd;
+    bool _owns_fd;
+    uint8_t _buffer[POSIX_SERIAL_BUFFER_SIZE];
+    int _head;
+    int _tail;
+
+    bool configure(unsigned long baud);
+};
+
+#endif
@@ -0,0 +1,325 @@
+// File: TpUartSimulator.cpp
+
+// Last modified: 18.10.2026
+
+#include "TpUartSimulator.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+// UART services, see the TP-UART data sheet
+#define SIM_U_RESET_REQUEST 0x01
+#define SIM_U_STATE_REQUEST 0x02
+#define SIM_U_ACTIVATE_BUSMON 0x05
+#define SIM_U_PRODUCT_ID_REQUEST 0x20
+#define SIM_U_SET_ADDRESS 0xF1
+#define SIM_U_CONFIGURE_MASK 0xF8
+#define SIM_U_CONFIGURE 0x18
+#define SIM_U_ACK_INFORMATION_MASK 0xF8
+#define SIM_U_ACK_INFORMATION 0x10
+#define SIM_U_DATA_START_CONTINUE 0x80
+#define SIM_U_DATA_END 0x40
+
+#define SIM_RESET_INDICATION 0x03
+#define SIM_STATE_INDICATION 0x07
+#define SIM_CONFIRM_POSITIVE 0x8B
+#define SIM_CONFIRM_NEGATIVE 0x0B
+
+TpUartSimulator::TpUartSimulator() {
+  _master = -1;
+  _slave = -1;
+  _running = false;
+  _confirm_success = true;
+  _answer_reads = false;
+  _drop_answers = 0;
+  _frame_length = 0;
+  _expect_data = false;
+  _frame_end = false;
+  _reset_requests = 0;
+  _busmonitor = false;
+  _tpuart2 = false;
+  _address = -1;
+  _configuration = -1;
+  _hardware_acks = 0;
+  _address_bytes = 0;
+  _power_fail_frames = 0;
+}
+
+TpUartSimulator::~TpUartSimulator() {
+  stop();
+  if (_master >= 0) {
+    close(_master);
+  }
+  if (_slave >= 0) {
+    close(_slave);
+  }
+}
+
+int TpUartSimulator::openPty() {
+  if (openpty(&_master, &_slave, NULL, NULL, NULL) < 0) {
+    return -1;
+  }
+
+  struct termios tio;
+  tcgetattr(_master, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(_master, TCSANOW, &tio);
+  return _slave;
+}
+
+void TpUartSimulator::start() {
+  _running = true;
+  _thread = std::thread(&TpUartSimulator::run, this);
+}
+
+void TpUartSimulator::stop() {
+  _running = false;
+  if (_thread.joinable()) {
+    _thread.join();
+  }
+}
+
+void TpUartSimulator::run() {
+  while (_running) {
+    struct pollfd pfd = { _master, POLLIN, 0 };
+    if (poll(&pfd, 1, 20) <= 0) {
+      continue;
+    }
+
+    uint8_t buf[64];
+    ssize_t n = read(_master, buf, sizeof(buf));
+    if (n <= 0) {
+      if (n < 0 && errno != EAGAIN && errno != EINTR) {
+        return;
+      }
+      continue;
+    }
+
+    std::lock_guard<std::mutex> guard(_lock);
+    for (ssize_t i = 0; i < n; i++) {
+      handleByte(buf[i]);
+    }
+  }
+}
+
+void TpUartSimulator::handleByte(uint8_t b) {
+  if (_expect_data) {
+    _expect_data = false;
+    if (_frame_length < (int) sizeof(_frame)) {
+      _frame[_frame_length++] = b;
+    }
+    if (_frame_end) {
+      frameComplete();
+    }
+    return;
+  }
+
+  if (_address_bytes > 0) {
+    // Address high, address low, dummy
+    if (_address_bytes > 1) {
+      _address = ((_address << 8) | b) & 0xFFFF;
+    }
+    _address_bytes--;
+    return;
+  }
+
+  if (b == SIM_U_RESET_REQUEST) {
+    _reset_requests++;
+    chipReset();
+  }
+  else if (_busmonitor) {
+    // Only the reset request is served in busmonitor mode
+  }
+  else if (b == SIM_U_ACTIVATE_BUSMON) {
+    _busmonitor = true;
+  }
+  else if (_tpuart2 && b == SIM_U_PRODUCT_ID_REQUEST) {
+    uint8_t reply = SIM_TPUART2_PRODUCT_ID;
+    writeMaster(&reply, 1);
+  }
+  else if (_tpuart2 && b == SIM_U_SET_ADDRESS) {
+    _address = 0;
+    _address_bytes = 3;
+  }
+  else if (_tpuart2 && (b & SIM_U_CONFIGURE_MASK) == SIM_U_CONFIGURE) {
+    _configuration = b & ~SIM_U_CONFIGURE_MASK;
+  }
+  else if (b == SIM_U_STATE_REQUEST) {
+    uint8_t reply = SIM_STATE_INDICATION;
+    writeMaster(&reply, 1);
+  }
+  else if ((b & SIM_U_ACK_INFORMATION_MASK) == SIM_U_ACK_INFORMATION) {
+    _ack_bytes.push_back(b);
+  }
+  else if (b & (SIM_U_DATA_START_CONTINUE | SIM_U_DATA_END)) {
+    // The low six bits carry the position of the following data byte
+    if ((b & 0x3F) == 0) {
+      _frame_length = 0;
+    }
+    _frame_end = (b & SIM_U_DATA_END) != 0;
+    _expect_data = true;
+  }
+}
+
+void TpUartSimulator::chipReset() {
+  _busmonitor = false;
+  _address = -1;
+  _configuration = -1;
+  _frame_length = 0;
+  uint8_t reply = SIM_RESET_INDICATION;
+  writeMaster(&reply, 1);
+}
+
+void TpUartSimulator::powerFail(int lostFrames) {
+  std::lock_guard<std::mutex> guard(_lock);
+  _power_fail_frames = lostFrames;
+  if (lostFrames == 0) {
+    chipReset();
+  }
+}
+
+void TpUartSimulator::frameComplete() {
+  if (_power_fail_frames > 0) {
+    // Never reaches the bus
+    _frame_length = 0;
+    if (--_power_fail_frames == 0) {
+      chipReset();
+    }
+    return;
+  }
+
+  _sent_frames.push_back(std::vector<uint8_t>(_frame, _frame + _frame_length));
+
+  uint8_t checksum = 0xFF;
+  for (int i = 0; i < _frame_length - 1; i++) {
+    checksum ^= _frame[i];
+  }
+  bool valid = _frame_length > 0 && checksum == _frame[_frame_length - 1];
+
+  if (!_before_confirmation.empty()) {
+    // Won the arbitration against the host's frame
+    writeMaster(_before_confirmation.data(), _before_confirmation.size());
+    _before_confirmation.clear();
+  }
+
+  uint8_t confirmation = (valid && _confirm_success) ? SIM_CONFIRM_POSITIVE : SIM_CONFIRM_NEGATIVE;
+  writeMaster(&confirmation, 1);
+
+  bool groupRead = _frame_length == 9 && (_frame[5] & 0x80) && (_frame[6] & 0x03) == 0 && (_frame[7] & 0xC0) == 0;
+  if (valid && groupRead && _answer_reads) {
+    answerRead();
+  }
+  _frame_length = 0;
+}
+
+void TpUartSimulator::answerRead() {
+  if (_drop_answers > 0) {
+    _drop_answers--;
+    return;
+  }
+
+  uint8_t answer[10];
+  answer[0] = 0xBC;
+  answer[1] = 0x11;  // From 1.1.250
+  answer[2] = 0xFA;
+  answer[3] = _frame[3];
+  answer[4] = _frame[4];
+  answer[5] = 0xE2;  // Group, routing counter 6, 3 byte payload
+  answer[6] = 0x00;
+  answer[7] = 0x40;  // Answer
+  answer[8] = _frame[4];
+  answer[9] = 0xFF;
+  for (int i = 0; i < 9; i++) {
+    answer[9] ^= answer[i];
+  }
+  writeMaster(answer, sizeof(answer));
+}
+
+void TpUartSimulator::writeMaster(const uint8_t* data, int length) {
+  int written = 0;
+  while (written < length) {
+    ssize_t n = write(_master, data + written, length - written);
+    if (n > 0) {
+      written += n;
+    }
+    else if (n < 0 && errno != EAGAIN && errno != EINTR) {
+      return;
+    }
+  }
+}
+
+void TpUartSimulator::setAnswerReads(bool answer, int dropCount) {
+  std::lock_guard<std::mutex> guard(_lock);
+  _answer_reads = answer;
+  _drop_answers = dropCount;
+}
+
+void TpUartSimulator::inject(const uint8_t* frame, int length) {
+  std::lock_guard<std::mutex> guard(_lock);
+  bool individual = length >= 6 && !(frame[5] & 0x80);
+  if (_tpuart2 && _address >= 0 && individual && ((frame[3] << 8) | frame[4]) == _address) {
+    _hardware_acks++;
+  }
+  writeMaster(frame, length);
+}
+
+void TpUartSimulator::injectBeforeConfirmation(const uint8_t* frame, int length) {
+  std::lock_guard<std::mutex> guard(_lock);
+  _before_confirmation.assign(frame, frame + length);
+}
+
+void TpUartSimulator::setTpUart2(bool tpuart2) {
+  std::lock_guard<std::mutex> guard(_lock);
+  _tpuart2 = tpuart2;
+}
+
+int TpUartSimulator::getAddress() {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _address;
+}
+
+int TpUartSimulator::getConfiguration() {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _configuration;
+}
+
+int TpUartSimulator::getHardwareAckCount() {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _hardware_acks;
+}
+
+void TpUartSimulator::setConfirmSuccess(bool success) {
+  std::lock_guard<std::mutex> guard(_lock);
+  _confirm_success = success;
+}
+
+std::vector<std::vector<uint8_t> > TpUartSimulator::getSentFrames() {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _sent_frames;
+}
+
+std::vector<uint8_t> TpUartSimulator::getAckBytes() {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _ack_bytes;
+}
+
+int TpUartSimulator::getResetRequestCount() {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _reset_requests;
+}
+
+bool TpUartSimulator::isBusmonitor() {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _busmonitor;
+}
+
+void TpUartSimulator::clearRecords() {
+  std::lock_guard<std::mutex> guard(_lock);
+  _sent_frames.clear();
+  _ack_bytes.clear();
+  _reset_requests = 0;
+}
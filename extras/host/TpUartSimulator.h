@@ -0,0 +1,90 @@
+// File: TpUartSimulator.h
+// Simulated TP-UART for host tests and tools. It sits on the other end of a
+// pty pair (or any descriptor), answers the UART services like the chip,
+// confirms transmitted frames and injects bus traffic on request.
+
+// Last modified: 18.10.2026
+
+#ifndef TpUartSimulator_h
+#define TpUartSimulator_h
+
+#include <stdint.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Product id the simulated TP-UART2 answers with
+#define SIM_TPUART2_PRODUCT_ID 0x41
+
+class TpUartSimulator {
+  public:
+    TpUartSimulator();
+    ~TpUartSimulator();
+
+    // Creates a pty pair, the simulator keeps the master side. Returns the
+    // slave descriptor for PosixSerial::attach(), or -1.
+    int openPty();
+    void start();
+    void stop();
+
+    // Bus side
+    void inject(const uint8_t* frame, int length);
+    // Sent once, between the next frame from the host and its confirmation
+    void injectBeforeConfirmation(const uint8_t* frame, int length);
+    void setConfirmSuccess(bool success);
+    // Let a simulated device answer every group read with its sub group as
+    // 1 byte value; the first dropCount answers are lost on the bus
+    void setAnswerReads(bool answer, int dropCount = 0);
+    // Behave like a TP-UART2: answer the product id request and acknowledge
+    // injected frames to the address set with U_SetAddress
+    void setTpUart2(bool tpuart2);
+    // Bus voltage dip: the next lostFrames frames are swallowed without a
+    // confirmation, then the chip resets and sends a reset indication
+    void powerFail(int lostFrames = 0);
+
+    // What the host sent
+    std::vector<std::vector<uint8_t> > getSentFrames();
+    std::vector<uint8_t> getAckBytes();
+    int getResetRequestCount();
+    bool isBusmonitor();
+    int getAddress();  // Set by U_SetAddress, -1 if none
+    int getConfiguration();
+    int getHardwareAckCount();
+    void clearRecords();
+
+  private:
+    int _master;
+    int _slave;
+    std::thread _thread;
+    volatile bool _running;
+    std::mutex _lock;
+
+    bool _confirm_success;
+    bool _answer_reads;
+    int _drop_answers;
+    uint8_t _frame[64];
+    int _frame_length;
+    bool _expect_data;
+    bool _frame_end;
+    int _reset_requests;
+    bool _busmonitor;
+    bool _tpuart2;
+    int _address;
+    int _configuration;
+    int _hardware_acks;
+    int _address_bytes;  // Still to come after U_SetAddress, incl. dummy
+    int _power_fail_frames;
+    std::vector<uint8_t> _before_confirmation;
+    std::vector<std::vector<uint8_t> > _sent_frames;
+    std::vector<uint8_t> _ack_bytes;
+
+    void run();
+    void handleByte(uint8_t b);
+    void frameComplete();
+    void chipReset();
+    void answerRead();
+    void writeMaster(const uint8_t* data, int length);
+};
+
+#endif
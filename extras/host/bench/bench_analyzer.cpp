@@ -0,0 +1,99 @@
+// File: bench_analyzer.cpp
+// Offline analytics throughput over a synthetic 24 hour capture of a busy
+// line, written to a temporary file and memory-mapped like a real one.
+
+// Last modified: 18.10.2026
+
+#include "KnxCaptureAnalyzer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <thread>
+
+#define CAPTURE_SECONDS (24UL * 3600)
+#define FRAMES_PER_SECOND 50
+#define ROUNDS 5
+
+class FilePrint : public Print {
+  public:
+    FILE* file;
+
+    size_t write(uint8_t b) {
+      return fputc(b, file) == EOF ? 0 : 1;
+    }
+    size_t write(const uint8_t* buffer, size_t size) {
+      return fwrite(buffer, 1, size, file);
+    }
+};
+
+static double nowSeconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double measure(KnxCaptureAnalyzer* analyzer, int threads) {
+  double best = 1e9;
+  for (int i = 0; i < ROUNDS; i++) {
+    double start = nowSeconds();
+    analyzer->run(threads);
+    double seconds = nowSeconds() - start;
+    if (seconds < best) {
+      best = seconds;
+    }
+  }
+  return best;
+}
+
+int main() {
+  char path[] = "/tmp/knxbenchXXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0) {
+    return 1;
+  }
+
+  FilePrint out;
+  out.file = fdopen(fd, "wb");
+  KnxCaptureWriter writer;
+  writer.begin(&out);
+
+  unsigned long frames = CAPTURE_SECONDS * FRAMES_PER_SECOND;
+  unsigned long timestamp = 0;
+  uint8_t ack = KNX_BUS_ACK;
+  for (unsigned long i = 0; i < frames; i++) {
+    KnxTelegram tg;
+    tg.setSourceAddress(1, (i / 7) % 16, (i * 13) % 250);
+    tg.setTargetGroupAddress(i % 32, (i / 3) % 8, (i * 7) % 256);
+    tg.setCommand(i % 5 == 0 ? KNX_COMMAND_READ : KNX_COMMAND_WRITE);
+    tg.set2ByteFloatValue((i % 500) / 10.0);
+    tg.setRepeated(i % 97 == 0);
+    tg.createChecksum();
+    writer.write(0, tg.getBuffer(), tg.getTotalLength(), timestamp);
+    writer.write(KNX_CAPTURE_ACK_CHAR, &ack, 1, timestamp + 13000);
+    timestamp += 1000000 / FRAMES_PER_SECOND;
+  }
+  fclose(out.file);
+
+  KnxCaptureAnalyzer analyzer;
+  if (!analyzer.open(path)) {
+    unlink(path);
+    return 1;
+  }
+  unlink(path);
+
+  int cores = std::max(1u, std::thread::hardware_concurrency());
+  double single = measure(&analyzer, 1);
+  double parallel = measure(&analyzer, cores);
+
+  uint16_t top[1];
+  analyzer.getTopGroups(top, 1);
+  printf("capture:  %lu frames, %lu h, busiest group %d/%d/%d\n", analyzer.getFrameCount(),
+         CAPTURE_SECONDS / 3600, top[0] >> 11, (top[0] >> 8) & 0x07, top[0] & 0xFF);
+  printf("1 thread: %.3f s, %.1f M frames/s\n", single, frames / single / 1e6);
+  printf("%d threads: %.3f s, %.1f M frames/s, %.1f M frames/s per core\n",
+         cores, parallel, frames / parallel / 1e6, frames / parallel / 1e6 / cores);
+  return 0;
+}
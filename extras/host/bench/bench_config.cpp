@@ -0,0 +1,74 @@
+// File: bench_config.cpp
+// Cold start: constructing KnxTpUart from an address string and adding a
+// full listen table with addListenGroupAddress(String), against the
+// uint16_t constructor followed by loadConfig() of a saved blob.
+
+// Last modified: 18.10.2026
+
+#include "KnxTpUart.h"
+#include "tests/KnxTestSupport.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define ITERATIONS 20000
+
+static double nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static NullStream out;
+static unsigned long checksums = 0;
+
+static void report(const char* name, double ns, double baseline) {
+  printf("%-34s %8.1f us/start", name, ns / ITERATIONS / 1000);
+  if (baseline > 0) {
+    printf("  %5.1fx faster", baseline / ns);
+  }
+  printf("\n");
+}
+
+int main() {
+  char addresses[MAX_LISTEN_GROUP_ADDRESSES][12];
+  for (int i = 0; i < MAX_LISTEN_GROUP_ADDRESSES; i++) {
+    snprintf(addresses[i], sizeof(addresses[i]), "%d/%d/%d", i % 32, i % 8, (i * 37) % 256);
+  }
+
+  uint8_t blob[KNX_CONFIG_SIZE(MAX_LISTEN_GROUP_ADDRESSES)];
+  int length;
+  {
+    KnxTpUart knx(&out, "1.1.199");
+    for (int i = 0; i < MAX_LISTEN_GROUP_ADDRESSES; i++) {
+      knx.addListenGroupAddress(addresses[i]);
+    }
+    length = knx.saveConfig(blob, sizeof(blob));
+  }
+
+  double start = nowNs();
+  for (int n = 0; n < ITERATIONS; n++) {
+    KnxTpUart knx(&out, "1.1.199");
+    for (int i = 0; i < MAX_LISTEN_GROUP_ADDRESSES; i++) {
+      knx.addListenGroupAddress(addresses[i]);
+    }
+    checksums += knx.getIndividualAddress();
+  }
+  double strings = nowNs() - start;
+
+  start = nowNs();
+  for (int n = 0; n < ITERATIONS; n++) {
+    KnxTpUart knx(&out, (uint16_t) 0);
+    if (!knx.loadConfig(blob, length)) {
+      printf("loadConfig failed\n");
+      return 1;
+    }
+    checksums += knx.getIndividualAddress();
+  }
+  double loaded = nowNs() - start;
+
+  report("String constructor + listen table", strings, 0);
+  report("loadConfig()", loaded, strings);
+  printf("(checksum %lu)\n", checksums);
+  return 0;
+}
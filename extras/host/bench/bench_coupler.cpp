@@ -0,0 +1,61 @@
+// File: bench_coupler.cpp
+// Cost of the coupler decision per received frame: filter lookup, echo
+// history, routing counter update and queueing for the other line. The
+// queues are emptied right away, so no serial I/O is measured.
+
+// Last modified: 18.10.2026
+
+#include "KnxTpUart.h"
+#include "tests/KnxTestSupport.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define ITERATIONS 2000000
+
+static double nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main() {
+  NullStream out;
+  KnxTpUart a(&out, "1.1.0");
+  KnxTpUart b(&out, "1.0.0");
+  KnxTxQueue queueA;
+  KnxTxQueue queueB;
+  KnxCoupler coupler;
+  coupler.addPort(&a, &queueA, "1.1");
+  coupler.addPort(&b, &queueB, "1.0");
+  for (int i = 0; i < MAX_COUPLER_FILTER_ADDRESSES; i++) {
+    coupler.addFilterGroupAddress((uint16_t) (0x0800 + 2 * i));
+  }
+
+  // Half of the frames pass the filter, each one differs in its value
+  KnxTelegram tg;
+  tg.setSourceAddress(1, 1, 20);
+  tg.setCommand(KNX_COMMAND_WRITE);
+  tg.set2ByteIntValue(0);
+
+  double start = nowNs();
+  for (int n = 0; n < ITERATIONS; n++) {
+    int port = n & 1;
+    tg.setTargetGroupAddress(1, 0, n % 256);
+    tg.setBufferByte(8, n >> 8);
+    tg.setBufferByte(9, n);
+    tg.createChecksum();
+    coupler.received(port, tg.getBuffer());
+    KnxTxQueue* queue = port == 0 ? &queueB : &queueA;
+    if (queue->front() != NULL) {
+      queue->pop();
+    }
+  }
+  double ns = nowNs() - start;
+
+  KnxCouplerStats up = coupler.getStats(0);
+  KnxCouplerStats down = coupler.getStats(1);
+  printf("coupler %8.1f ns/frame, forwarded %lu, filtered %lu, echoes %lu\n", ns / ITERATIONS,
+         up.forwarded + down.forwarded, up.filtered + down.filtered, up.echoes + down.echoes);
+  return 0;
+}
@@ -0,0 +1,94 @@
+// File: bench_frame_template.cpp
+// Cost of building a frame with groupWrite*() (createKNXMessageFrame())
+// against patching a KnxFrameTemplate. Frames go into a transmit queue that
+// is emptied right away, so no serial I/O is measured.
+
+// Last modified: 18.10.2026
+
+#include "KnxTpUart.h"
+#include "tests/KnxTestSupport.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define ITERATIONS 1000000
+
+static double nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static NullStream out;
+static KnxTpUart knx(&out, "1.1.199");
+static KnxTxQueue queue;
+static unsigned long checksums = 0;
+
+static void drain() {
+  KnxTxSlot* slot = queue.front();
+  checksums += slot->frame[slot->length - 1];
+  queue.pop();
+}
+
+static void report(const char* name, double ns, double baseline) {
+  printf("%-34s %8.1f ns/frame", name, ns / ITERATIONS);
+  if (baseline > 0) {
+    printf("  %5.1fx faster", baseline / ns);
+  }
+  printf("\n");
+}
+
+int main() {
+  knx.setTxQueue(&queue);
+
+  KnxFrameTemplate brightness;
+  brightness.begin(knx.getIndividualAddress(), "1/2/3", KNX_COMMAND_WRITE, 1);
+  KnxFrameTemplate temperature;
+  temperature.begin(knx.getIndividualAddress(), "1/2/4", KNX_COMMAND_WRITE, 2);
+
+  double start = nowNs();
+  for (int i = 0; i < ITERATIONS; i++) {
+    knx.groupWrite1ByteInt("1/2/3", i & 0xFF);
+    drain();
+  }
+  double groupWrite1Byte = nowNs() - start;
+
+  String address = "1/2/3";
+  start = nowNs();
+  for (int i = 0; i < ITERATIONS; i++) {
+    knx.groupWrite1ByteInt(address, i & 0xFF);
+    drain();
+  }
+  double groupWrite1ByteString = nowNs() - start;
+
+  start = nowNs();
+  for (int i = 0; i < ITERATIONS; i++) {
+    brightness.set1ByteIntValue(i & 0xFF);
+    knx.sendTemplate(&brightness);
+    drain();
+  }
+  double template1Byte = nowNs() - start;
+
+  start = nowNs();
+  for (int i = 0; i < ITERATIONS; i++) {
+    knx.groupWrite2ByteFloat("1/2/4", (i & 0x3FF) * 0.1f);
+    drain();
+  }
+  double groupWriteFloat = nowNs() - start;
+
+  start = nowNs();
+  for (int i = 0; i < ITERATIONS; i++) {
+    temperature.set2ByteFloatValue((i & 0x3FF) * 0.1f);
+    knx.sendTemplate(&temperature);
+    drain();
+  }
+  double templateFloat = nowNs() - start;
+
+  report("groupWrite1ByteInt(literal)", groupWrite1Byte, 0);
+  report("groupWrite1ByteInt(String)", groupWrite1ByteString, 0);
+  report("template set1ByteIntValue", template1Byte, groupWrite1Byte);
+  report("groupWrite2ByteFloat", groupWriteFloat, 0);
+  report("template set2ByteFloatValue", templateFloat, groupWriteFloat);
+  printf("(checksum sum %lu)\n", checksums);
+  return 0;
+}
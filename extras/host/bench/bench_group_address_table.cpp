@@ -0,0 +1,91 @@
+// File: bench_group_address_table.cpp
+// Name and address lookups in a generated table of 1000 group addresses,
+// against the pattern of the examples: formatting the received target as
+// a "main/middle/sub" String and comparing it in a loop.
+
+// Last modified: 18.10.2026
+
+#include "KnxGroupAddressTable.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#define COUNT 1000
+#define ITERATIONS 200000
+
+static double nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main() {
+  // Built the way knxgatable emits it
+  std::vector<uint16_t> addresses;
+  std::vector<std::string> names;
+  std::string blob;
+  std::vector<KnxGroupAddressEntry> entries;
+  for (int i = 0; i < COUNT; i++) {
+    uint16_t address = (uint16_t) ((i / 100) << 11 | ((i / 10) % 8) << 8 | (i * 7) % 256);
+    if (std::find(addresses.begin(), addresses.end(), address) != addresses.end()) {
+      address = (uint16_t) (0x7800 + i);
+    }
+    addresses.push_back(address);
+  }
+  std::sort(addresses.begin(), addresses.end());
+  for (int i = 0; i < COUNT; i++) {
+    char name[32];
+    snprintf(name, sizeof(name), "Room %03d channel %d", (i * 37) % COUNT, i % 4);
+    names.push_back(name);
+    KnxGroupAddressEntry entry = { addresses[i], (uint16_t) blob.size(), 1, 9 };
+    entries.push_back(entry);
+    blob += name;
+    blob += '\0';
+  }
+  std::vector<uint16_t> byName(COUNT);
+  for (int i = 0; i < COUNT; i++) {
+    byName[i] = i;
+  }
+  std::stable_sort(byName.begin(), byName.end(), [&](uint16_t a, uint16_t b) { return names[a] < names[b]; });
+  KnxGroupAddressTable table(entries.data(), byName.data(), blob.data(), COUNT);
+
+  std::vector<String> strings;
+  for (int i = 0; i < COUNT; i++) {
+    strings.push_back(String(addresses[i] >> 11) + "/" + String((addresses[i] >> 8) & 0x07) + "/"
+                      + String(addresses[i] & 0xFF));
+  }
+
+  unsigned long found = 0;
+  double start = nowNs();
+  for (int n = 0; n < ITERATIONS; n++) {
+    found += table.findAddress(addresses[(n * 7919) % COUNT]) >= 0;
+  }
+  double byAddress = (nowNs() - start) / ITERATIONS;
+
+  start = nowNs();
+  for (int n = 0; n < ITERATIONS; n++) {
+    found += table.findName(names[(n * 7919) % COUNT].c_str()) >= 0;
+  }
+  double byNameNs = (nowNs() - start) / ITERATIONS;
+
+  start = nowNs();
+  for (int n = 0; n < ITERATIONS / 100; n++) {
+    uint16_t address = addresses[(n * 7919) % COUNT];
+    String target = String(address >> 11) + "/" + String((address >> 8) & 0x07) + "/" + String(address & 0xFF);
+    for (int i = 0; i < COUNT; i++) {
+      if (strings[i] == target) {
+        found++;
+        break;
+      }
+    }
+  }
+  double linear = (nowNs() - start) / (ITERATIONS / 100);
+
+  printf("%d addresses: by address %6.1f ns, by name %6.1f ns, String loop %8.1f ns (%lu found)\n", COUNT,
+         byAddress, byNameNs, linear, found);
+  return 0;
+}
@@ -0,0 +1,160 @@
+// File: bench_ip_bridge.cpp
+// Latency through the KNXnet/IP bridge on loopback against the TP-UART
+// simulator: tunnelling request to L_Data.con, and a bus frame to its
+// routing indication. Includes the simulated serial transfer.
+
+// Last modified: 18.10.2026
+
+#include "KnxEventLoop.h"
+#include "KnxIpBridge.h"
+#include "KnxTpUart.h"
+#include "PosixSerial.h"
+#include "TpUartSimulator.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <vector>
+
+#define ITERATIONS 200
+
+static double nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static struct sockaddr_in loopback(int port) {
+  struct sockaddr_in a;
+  memset(&a, 0, sizeof(a));
+  a.sin_family = AF_INET;
+  a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  a.sin_port = htons(port);
+  return a;
+}
+
+static int openClient() {
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  struct sockaddr_in local = loopback(0);
+  bind(fd, (struct sockaddr*) &local, sizeof(local));
+  return fd;
+}
+
+static void sendPacket(int fd, int port, uint16_t service, const uint8_t* body, int length) {
+  uint8_t packet[KNX_IP_MAX_PACKET] = { 0x06, 0x10, (uint8_t) (service >> 8), (uint8_t) service,
+                                        (uint8_t) ((length + 6) >> 8), (uint8_t) (length + 6) };
+  memcpy(packet + 6, body, length);
+  struct sockaddr_in to = loopback(port);
+  sendto(fd, packet, length + 6, 0, (struct sockaddr*) &to, sizeof(to));
+}
+
+// Runs the loop until fd has a packet of the service, returns its length
+static int waitFor(KnxEventLoop* loop, int fd, uint16_t service, uint8_t* packet) {
+  unsigned long start = millis();
+  while (millis() - start < 1000) {
+    int length = recv(fd, packet, KNX_IP_MAX_PACKET, 0);
+    if (length >= 6 && ((packet[2] << 8) | packet[3]) == service) {
+      return length;
+    }
+    if (length < 0) {
+      loop->runOnce(1);
+    }
+  }
+  return 0;
+}
+
+static void report(const char* name, std::vector<double>& samples) {
+  std::sort(samples.begin(), samples.end());
+  double sum = 0;
+  for (size_t i = 0; i < samples.size(); i++) {
+    sum += samples[i];
+  }
+  printf("%-12s mean %8.1f us, p99 %8.1f us\n", name, sum / samples.size() / 1000,
+         samples[samples.size() * 99 / 100] / 1000);
+}
+
+int main() {
+  TpUartSimulator sim;
+  PosixSerial serial;
+  KnxTpUart knx(&serial, "1.1.250");
+  KnxTxQueue queue;
+  KnxEventLoop loop;
+  serial.attach(sim.openPty());
+  sim.start();
+  knx.setTxQueue(&queue);
+  knx.setTxInterval(0);
+  loop.add(&serial, &knx, NULL);
+
+  int routing = openClient();
+  int tunnel = openClient();
+  struct sockaddr_in local;
+  socklen_t localLength = sizeof(local);
+  getsockname(routing, (struct sockaddr*) &local, &localLength);
+
+  KnxIpBridge bridge(&knx, &queue);
+  bridge.beginRouting("127.0.0.1", ntohs(local.sin_port), 0);
+  bridge.beginTunnelling(0);
+  bridge.attach(&loop);
+
+  uint8_t packet[KNX_IP_MAX_PACKET];
+  uint8_t connect[20] = { 8, 1, 0, 0, 0, 0, 0, 0, 8, 1, 0, 0, 0, 0, 0, 0, 4, 4, 2, 0 };
+  sendPacket(tunnel, bridge.getTunnellingPort(), 0x0205, connect, sizeof(connect));
+  if (waitFor(&loop, tunnel, 0x0206, packet) < 8 || packet[7] != 0) {
+    printf("tunnel connection refused\n");
+    return 1;
+  }
+  uint8_t channel = packet[6];
+
+  KnxTelegram tg;
+  tg.setSourceAddress(1, 1, 20);
+  tg.setTargetGroupAddress(1, 2, 3);
+  tg.setCommand(KNX_COMMAND_WRITE);
+  tg.set1ByteIntValue(0);
+  tg.createChecksum();
+
+  std::vector<double> tunnelling;
+  uint8_t body[4 + KNX_CEMI_MAX_SIZE] = { 4, channel, 0, 0 };
+  for (int n = 0; n < ITERATIONS; n++) {
+    body[2] = n;
+    int length = knxFrameToCemi(tg.getBuffer(), KNX_CEMI_LDATA_REQ, body + 4, KNX_CEMI_MAX_SIZE);
+    double start = nowNs();
+    sendPacket(tunnel, bridge.getTunnellingPort(), 0x0420, body, 4 + length);
+    uint8_t sequence = 0;
+    while (waitFor(&loop, tunnel, 0x0420, packet) > 0) {
+      if (packet[10] == KNX_CEMI_LDATA_CON) {
+        sequence = packet[8];
+        break;
+      }
+    }
+    tunnelling.push_back(nowNs() - start);
+    uint8_t ack[4] = { 4, channel, sequence, 0 };
+    sendPacket(tunnel, bridge.getTunnellingPort(), 0x0421, ack, sizeof(ack));
+  }
+
+  std::vector<double> routed;
+  for (int n = 0; n < ITERATIONS; n++) {
+    tg.set1ByteIntValue(n);
+    tg.createChecksum();
+    while (recv(routing, packet, sizeof(packet), 0) > 0) {
+    }
+    double start = nowNs();
+    sim.inject(tg.getBuffer(), tg.getTotalLength());
+    waitFor(&loop, routing, 0x0530, packet);
+    routed.push_back(nowNs() - start);
+  }
+
+  report("tunnelling", tunnelling);
+  report("bus to ip", routed);
+  KnxIpStats stats = bridge.getStats();
+  printf("bus to ip %lu, ip to bus %lu, confirmed %lu\n", stats.busToIp, stats.ipToBus, stats.confirmed);
+  close(routing);
+  close(tunnel);
+  return 0;
+}
@@ -0,0 +1,71 @@
+// File: bench_replay.cpp
+// Replays a synthetic 24 hour capture of a busy line (50 frames per second,
+// each followed by its ack character) through serialEvent() as fast as
+// possible.
+
+// Last modified: 18.10.2026
+
+#include "KnxCaptureReplayer.h"
+#include "tests/KnxTestSupport.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#include <vector>
+
+#define CAPTURE_SECONDS (24UL * 3600)
+#define FRAMES_PER_SECOND 50
+
+static unsigned long telegrams = 0;
+
+static void countTelegram(KnxTpUart*, KnxTpUartSerialEventType event, void*) {
+  if (event == KNX_TELEGRAM) {
+    telegrams++;
+  }
+}
+
+static double nowSeconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main() {
+  VectorPrint capture;
+  KnxCaptureWriter writer;
+  writer.begin(&capture);
+
+  unsigned long frames = CAPTURE_SECONDS * FRAMES_PER_SECOND;
+  capture.data.reserve(frames * 24);
+  unsigned long timestamp = 0;
+  uint8_t ack = KNX_BUS_ACK;
+  for (unsigned long i = 0; i < frames; i++) {
+    KnxTelegram tg;
+    tg.setSourceAddress(1, 1, i % 200);
+    tg.setTargetGroupAddress(1, i % 8, i % 256);
+    tg.setCommand(KNX_COMMAND_WRITE);
+    tg.set2ByteFloatValue((i % 500) / 10.0);
+    tg.createChecksum();
+    writer.write(0, tg.getBuffer(), tg.getTotalLength(), timestamp);
+    writer.write(KNX_CAPTURE_ACK_CHAR, &ack, 1, timestamp + 13000);
+    timestamp += 1000000 / FRAMES_PER_SECOND;
+  }
+
+  NullStream out;
+  KnxTpUart knx(&out, "1.1.199");
+  for (int i = 0; i < MAX_LISTEN_GROUP_ADDRESSES; i++) {
+    knx.addListenGroupAddress(String("1/0/") + String(i * 10));
+  }
+  KnxCaptureReplayer replayer(&knx);
+  replayer.setEventHandler(countTelegram);
+  replayer.begin(capture.data.data(), capture.data.size());
+
+  double start = nowSeconds();
+  unsigned long records = replayer.run();
+  double seconds = nowSeconds() - start;
+
+  printf("capture: %lu frames, %.1f MB, %lu h\n", frames, capture.data.size() / 1e6, CAPTURE_SECONDS / 3600);
+  printf("replay:  %lu records in %.2f s, %.0f frames/s, %lu telegrams listened\n",
+         records, seconds, frames / seconds, telegrams);
+  return 0;
+}
@@ -0,0 +1,67 @@
+// File: bench_secure.cpp
+// KNX Data Secure throughput: securing and verifying a group write with
+// the cached key schedule, against expanding the key for every frame.
+// A loaded TP1 line carries about 50 frames per second.
+
+// Last modified: 18.10.2026
+
+#include "KnxSecure.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define ITERATIONS 200000
+
+static double nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static const uint8_t key[16] = {
+  0x5C, 0x1A, 0x9E, 0x44, 0x03, 0xB7, 0x61, 0xF0, 0x2D, 0x88, 0xC4, 0x17, 0x6A, 0xE9, 0x30, 0x5B
+};
+
+int main() {
+  KnxSecure sender;
+  KnxSecure receiver;
+  sender.addGroupAddress(0x0A03, sender.addKey(key));
+  receiver.addGroupAddress(0x0A03, receiver.addKey(key));
+  receiver.addSource(0x1114);
+
+  KnxTelegram tg;
+  tg.setSourceAddress(1, 1, 20);
+  tg.setTargetGroupAddress(1, 2, 3);
+  tg.setCommand(KNX_COMMAND_WRITE);
+  tg.set1ByteIntValue(0);
+  tg.createChecksum();
+
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  unsigned long ok = 0;
+  double start = nowNs();
+  for (int n = 0; n < ITERATIONS; n++) {
+    sender.secure(tg.getBuffer(), frame);
+  }
+  double secureNs = (nowNs() - start) / ITERATIONS;
+
+  sender.setSequence(1);
+  start = nowNs();
+  for (int n = 0; n < ITERATIONS; n++) {
+    sender.secure(tg.getBuffer(), frame);
+    ok += receiver.unsecure(frame) == KNX_SECURE_OK;
+  }
+  double roundTripNs = (nowNs() - start) / ITERATIONS - secureNs;
+
+  // What every frame would cost without the cached schedule
+  KnxAesKey expanded;
+  start = nowNs();
+  for (int n = 0; n < ITERATIONS; n++) {
+    knxAesExpandKey(key, &expanded);
+  }
+  double expandNs = (nowNs() - start) / ITERATIONS;
+
+  printf("secure   %7.1f ns/frame  %9.0f frames/s\n", secureNs, 1e9 / secureNs);
+  printf("verify   %7.1f ns/frame  %9.0f frames/s (%lu ok)\n", roundTripNs, 1e9 / roundTripNs, ok);
+  printf("key expansion %7.1f ns, +%.0f%% per frame if not cached\n", expandNs, 100.0 * expandNs / secureNs);
+  return 0;
+}
@@ -0,0 +1,89 @@
+// File: bench_traffic_stats.cpp
+// Replays a synthetic hour of a busy line through serialEvent() with and
+// without traffic accounting, and times KnxTrafficStats::record() alone.
+
+// Last modified: 18.10.2026
+
+#include "KnxCaptureReplayer.h"
+#include "tests/KnxTestSupport.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#include <vector>
+
+#define REPEATS 5
+
+#define CAPTURE_SECONDS 3600UL
+#define FRAMES_PER_SECOND 50
+
+static double nowSeconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double replay(const std::vector<uint8_t>& capture, KnxTrafficStats* stats) {
+  NullStream out;
+  KnxTpUart knx(&out, "1.1.199");
+  for (int i = 0; i < MAX_LISTEN_GROUP_ADDRESSES; i++) {
+    knx.addListenGroupAddress(String("1/0/") + String(i * 10));
+  }
+  knx.setTrafficStats(stats);
+  KnxCaptureReplayer replayer(&knx);
+  replayer.begin(capture.data(), capture.size());
+
+  double start = nowSeconds();
+  replayer.run();
+  return nowSeconds() - start;
+}
+
+int main() {
+  VectorPrint capture;
+  KnxCaptureWriter writer;
+  writer.begin(&capture);
+
+  // 200 senders, 256 group addresses, every tenth frame repeated
+  unsigned long frames = CAPTURE_SECONDS * FRAMES_PER_SECOND;
+  unsigned long timestamp = 0;
+  uint8_t ack = KNX_BUS_ACK;
+  std::vector<KnxTelegram> telegrams(256);
+  for (unsigned long i = 0; i < frames; i++) {
+    KnxTelegram tg;
+    tg.setSourceAddress(1, 1, i % 200);
+    tg.setTargetGroupAddress(1, i % 8, i % 256);
+    tg.setCommand(KNX_COMMAND_WRITE);
+    tg.set2ByteFloatValue((i % 500) / 10.0);
+    tg.setRepeated(i % 10 == 0);
+    tg.createChecksum();
+    writer.write(0, tg.getBuffer(), tg.getTotalLength(), timestamp);
+    writer.write(KNX_CAPTURE_ACK_CHAR, &ack, 1, timestamp + 13000);
+    timestamp += 1000000 / FRAMES_PER_SECOND;
+    telegrams[i % 256] = tg;
+  }
+
+  KnxTrafficStats stats;
+  double plain = 1e9;
+  double counted = 1e9;
+  for (int i = 0; i < REPEATS; i++) {
+    double seconds = replay(capture.data, NULL);
+    plain = seconds < plain ? seconds : plain;
+    stats.clear();
+    seconds = replay(capture.data, &stats);
+    counted = seconds < counted ? seconds : counted;
+  }
+  printf("replay:  %lu frames, %.0f ns/frame without, %.0f ns/frame with accounting\n",
+         frames, plain * 1e9 / frames, counted * 1e9 / frames);
+
+  stats.clear();
+  double start = nowSeconds();
+  for (unsigned long i = 0; i < frames; i++) {
+    KnxTelegram* tg = &telegrams[i % 256];
+    stats.record(tg->getBuffer(), tg->getTotalLength());
+  }
+  double seconds = nowSeconds() - start;
+  printf("record:  %.0f ns/frame\n", seconds * 1e9 / frames);
+
+  stats.print(&Serial, 5);
+  return 0;
+}
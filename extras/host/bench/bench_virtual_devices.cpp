@@ -0,0 +1,58 @@
+// File: bench_virtual_devices.cpp
+// Cost of resolving received group frames to their virtual devices as
+// devices are added. Every device listens to 6 group addresses; the frames
+// cycle over all addresses on the bus, half of them listened to.
+
+// Last modified: 18.10.2026
+
+#include "KnxTpUart.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define ITERATIONS 4000000
+#define ADDRESSES_PER_DEVICE 6
+
+static double nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static unsigned long deliveries = 0;
+
+static void count(int, KnxTelegram*, void*) {
+  deliveries++;
+}
+
+int main() {
+  KnxTpUart knx(&Serial, "1.1.199");
+  KnxTelegram frames[2 * ADDRESSES_PER_DEVICE * MAX_VIRTUAL_DEVICES];
+  int frameCount = sizeof(frames) / sizeof(frames[0]);
+  for (int i = 0; i < frameCount; i++) {
+    frames[i].setSourceAddress(1, 1, 20);
+    frames[i].setTargetGroupAddress(2, i / 256, i % 256);
+    frames[i].setCommand(KNX_COMMAND_WRITE);
+    frames[i].set1ByteIntValue(i);
+  }
+
+  for (int deviceCount = 1; deviceCount <= MAX_VIRTUAL_DEVICES; deviceCount *= 2) {
+    KnxVirtualDevices devices(&knx);
+    for (int d = 0; d < deviceCount; d++) {
+      devices.addDevice((uint16_t) (0x1200 + d), count);
+    }
+    // The listened addresses are spread over the whole frame set
+    for (int a = 0; a < ADDRESSES_PER_DEVICE * MAX_VIRTUAL_DEVICES; a++) {
+      devices.addListenGroupAddress(a % deviceCount, (uint16_t) (0x1000 + 2 * a));
+    }
+
+    deliveries = 0;
+    double start = nowNs();
+    for (int n = 0; n < ITERATIONS; n++) {
+      devices.received(&frames[n % frameCount]);
+    }
+    double ns = nowNs() - start;
+    printf("%2d devices %8.1f ns/frame (%lu delivered)\n", deviceCount, ns / ITERATIONS, deliveries);
+  }
+  return 0;
+}
@@ -0,0 +1,162 @@
+// File: Arduino.cpp
+// Host implementation of the minimal Arduino core, see Arduino.h.
+
+// Last modified: 18.10.2026
+
+#include "Arduino.h"
+#include "HardwareSerial.h"
+
+#include <mutex>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+static bool hostClockVirtual = false;
+static unsigned long long hostClockVirtualUs = 0;
+static std::recursive_mutex hostInterruptLock;
+
+static unsigned long long monotonicMicros() {
+  static unsigned long long origin = 0;
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  unsigned long long now = (unsigned long long) ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+  if (origin == 0) {
+    origin = now;
+  }
+  return now - origin;
+}
+
+unsigned long micros() {
+  if (hostClockVirtual) {
+    return (unsigned long) hostClockVirtualUs;
+  }
+  return (unsigned long) monotonicMicros();
+}
+
+unsigned long millis() {
+  if (hostClockVirtual) {
+    return (unsigned long) (hostClockVirtualUs / 1000);
+  }
+  return (unsigned long) (monotonicMicros() / 1000);
+}
+
+void delay(unsigned long ms) {
+  if (hostClockVirtual) {
+    hostClockVirtualUs += (unsigned long long) ms * 1000;
+    return;
+  }
+  usleep(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+  if (hostClockVirtual) {
+    hostClockVirtualUs += us;
+    return;
+  }
+  usleep(us);
+}
+
+void noInterrupts() {
+  hostInterruptLock.lock();
+}
+
+void interrupts() {
+  hostInterruptLock.unlock();
+}
+
+void hostClockSetVirtual(bool enabled) {
+  hostClockVirtualUs = monotonicMicros();
+  hostClockVirtual = enabled;
+}
+
+bool hostClockIsVirtual() {
+  return hostClockVirtual;
+}
+
+void hostClockAdvance(unsigned long us) {
+  hostClockVirtualUs += us;
+}
+
+static std::string formatNumber(unsigned long value, unsigned char base) {
+  if (base < 2) {
+    base = 10;
+  }
+  char buf[8 * sizeof(unsigned long) + 1];
+  char* p = &buf[sizeof(buf) - 1];
+  *p = 0;
+  do {
+    int digit = value % base;
+    *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+    value /= base;
+  } while (value);
+  return std::string(p);
+}
+
+String::String(int value, unsigned char base) : String((long) value, base) {}
+
+String::String(unsigned int value, unsigned char base) : String((unsigned long) value, base) {}
+
+String::String(long value, unsigned char base) {
+  if (value < 0 && base == DEC) {
+    _s = "-" + formatNumber((unsigned long) -value, base);
+  }
+  else {
+    _s = formatNumber((unsigned long) value, base);
+  }
+}
+
+String::String(unsigned long value, unsigned char base) : _s(formatNumber(value, base)) {}
+
+String::String(double value, unsigned char decimals) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", decimals, value);
+  _s = buf;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to) {
+    unsigned int tmp = from;
+    from = to;
+    to = tmp;
+  }
+  if (from >= _s.length()) {
+    return String();
+  }
+  if (to > _s.length()) {
+    to = _s.length();
+  }
+  return String(_s.substr(from, to - from));
+}
+
+void String::toCharArray(char* buf, unsigned int size) const {
+  if (size == 0) {
+    return;
+  }
+  unsigned int n = _s.length() < size - 1 ? _s.length() : size - 1;
+  memcpy(buf, _s.c_str(), n);
+  buf[n] = 0;
+}
+
+void String::trim() {
+  size_t first = _s.find_first_not_of(" \t\r\n");
+  if (first == std::string::npos) {
+    _s.clear();
+    return;
+  }
+  size_t last = _s.find_last_not_of(" \t\r\n");
+  _s = _s.substr(first, last - first + 1);
+}
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t n = 0;
+  while (size--) {
+    n += write(*buffer++);
+  }
+  return n;
+}
+
+size_t HardwareSerial::write(uint8_t b) {
+  return fwrite(&b, 1, 1, stdout);
+}
+
+HardwareSerial Serial;
@@ -0,0 +1,125 @@
+// File: Arduino.h
+// Minimal Arduino core for building the library on a POSIX host.
+// Only what the library, the host tests and the host tools use is provided.
+
+// Last modified: 18.10.2026
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+
+#define KNX_HOST_BUILD
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+// Flash and RAM are the same address space, as on the ARM and ESP cores
+#define PROGMEM
+#define PGM_P const char*
+#define pgm_read_byte(address) (*(const uint8_t*) (address))
+#define pgm_read_word(address) (*(const uint16_t*) (address))
+#define strcmp_P strcmp
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// There are no interrupts on the host; producers and the drainer run in
+// threads, so the critical section maps to one process wide recursive lock.
+void noInterrupts();
+void interrupts();
+
+// Host clock control. In virtual mode millis()/micros() only move when
+// delay() is called or the clock is advanced explicitly, which makes tests
+// deterministic and lets captures replay faster than real time.
+void hostClockSetVirtual(bool enabled);
+bool hostClockIsVirtual();
+void hostClockAdvance(unsigned long us);
+
+class String {
+  public:
+    String() {}
+    String(const char* s) : _s(s ? s : "") {}
+    String(const std::string& s) : _s(s) {}
+    String(char c) : _s(1, c) {}
+    String(int value, unsigned char base = DEC);
+    String(unsigned int value, unsigned char base = DEC);
+    String(long value, unsigned char base = DEC);
+    String(unsigned long value, unsigned char base = DEC);
+    String(double value, unsigned char decimals = 2);
+
+    unsigned int length() const { return _s.length(); }
+    const char* c_str() const { return _s.c_str(); }
+    char charAt(unsigned int index) const { return index < _s.length() ? _s[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+
+    int indexOf(char c) const { return find(_s.find(c)); }
+    int indexOf(char c, unsigned int from) const { return find(_s.find(c, from)); }
+    int indexOf(const String& s) const { return find(_s.find(s._s)); }
+    int lastIndexOf(char c) const { return find(_s.rfind(c)); }
+    String substring(unsigned int from) const { return substring(from, _s.length()); }
+    String substring(unsigned int from, unsigned int to) const;
+    long toInt() const { return atol(_s.c_str()); }
+    float toFloat() const { return (float) atof(_s.c_str()); }
+    void toCharArray(char* buf, unsigned int size) const;
+    void trim();
+
+    String& operator+=(const String& rhs) { _s += rhs._s; return *this; }
+    String& operator+=(const char* rhs) { _s += rhs; return *this; }
+    String& operator+=(char rhs) { _s += rhs; return *this; }
+    friend String operator+(const String& lhs, const String& rhs) { return String(lhs._s + rhs._s); }
+    friend String operator+(const String& lhs, const char* rhs) { return String(lhs._s + rhs); }
+    friend String operator+(const char* lhs, const String& rhs) { return String(lhs + rhs._s); }
+    bool operator==(const String& rhs) const { return _s == rhs._s; }
+    bool operator==(const char* rhs) const { return _s == rhs; }
+    bool operator!=(const String& rhs) const { return _s != rhs._s; }
+    bool operator!=(const char* rhs) const { return _s != rhs; }
+    bool operator<(const String& rhs) const { return _s < rhs._s; }
+
+  private:
+    std::string _s;
+    static int find(size_t pos) { return pos == std::string::npos ? -1 : (int) pos; }
+};
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t b) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return write((const uint8_t*) str, strlen(str)); }
+    virtual void flush() {}
+
+    size_t print(const String& s) { return write(s.c_str()); }
+    size_t print(const char* s) { return write(s); }
+    size_t print(char c) { return write((uint8_t) c); }
+    size_t print(int n, int base = DEC) { return print(String((long) n, base)); }
+    size_t print(unsigned int n, int base = DEC) { return print(String((unsigned long) n, base)); }
+    size_t print(long n, int base = DEC) { return print(String(n, base)); }
+    size_t print(unsigned long n, int base = DEC) { return print(String(n, base)); }
+    size_t print(double n, int digits = 2) { return print(String(n, digits)); }
+    size_t println() { return write("\r\n"); }
+    template<typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+    template<typename T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    using Print::write;
+};
+
+#endif
@@ -0,0 +1,24 @@
+// File: HardwareSerial.h
+// Host stand-in for the Arduino serial port. Serial writes to stdout and
+// never receives anything; the TP-UART is driven through PosixSerial.
+
+// Last modified: 18.10.2026
+
+#ifndef HardwareSerial_h
+#define HardwareSerial_h
+
+#include "Arduino.h"
+
+class HardwareSerial : public Stream {
+  public:
+    void begin(unsigned long) {}
+    int available() { return 0; }
+    int read() { return -1; }
+    int peek() { return -1; }
+    size_t write(uint8_t b);
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,68 @@
+#!/bin/sh
+# File: size_matrix.sh
+# Builds sizes/sketch.cpp against the library once per feature
+# configuration (see src/KnxFeatures.h) and prints its size:
+#
+#   object  text of KnxTpUart.o and KnxTelegram.o, what a toolchain
+#           without section garbage collection links
+#   text, data, bss  of the linked sketch, -ffunction-sections and
+#           --gc-sections like the Arduino toolchains
+#   class   sizeof(KnxTpUart)
+#
+# The numbers are for the host compiler. They show the differences
+# between the configurations, not what an AVR or ESP build will take.
+#
+#   make sizes
+#   CXX=clang++ sh sizes/size_matrix.sh
+
+# Last modified: 18.10.2026
+
+set -e
+
+CXX=${CXX:-g++}
+SIZE=${SIZE:-size}
+HERE=$(cd "$(dirname "$0")/.." && pwd)
+SRC="$HERE/../../src"
+OUT="$HERE/build/sizes"
+FLAGS="-Os -ffunction-sections -fdata-sections -I$HERE/core -I$SRC"
+
+NONE="-DKNX_FEATURE_DPT_EXTENDED=0 -DKNX_FEATURE_ASYNC_READ=0 -DKNX_FEATURE_RX_RING=0 \
+      -DKNX_FEATURE_TX_QUEUE=0 -DKNX_FEATURE_SECURE=0 -DKNX_FEATURE_DEVICE_SERVICES=0 \
+      -DKNX_FEATURE_VIRTUAL_DEVICES=0 -DKNX_FEATURE_COUPLER=0 -DKNX_FEATURE_RESET_RECOVERY=0 \
+      -DKNX_DIAGNOSTICS=0"
+
+mkdir -p "$OUT"
+$CXX -std=gnu++17 $FLAGS -c "$HERE/core/Arduino.cpp" -o "$OUT/Arduino.o"
+
+printf "%-28s %8s %8s %6s %6s %6s\n" configuration object text data bss class
+
+row() {
+  name=$1
+  shift
+  dir="$OUT/$name"
+  mkdir -p "$dir"
+  for source in "$SRC"/*.cpp "$HERE/sizes/sketch.cpp"; do
+    $CXX -std=gnu++11 $FLAGS "$@" -c "$source" -o "$dir/$(basename "$source" .cpp).o" &
+  done
+  wait
+  $CXX -Wl,--gc-sections "$dir"/*.o "$OUT/Arduino.o" -pthread -o "$dir/sketch"
+
+  object=$($SIZE "$dir/KnxTpUart.o" "$dir/KnxTelegram.o" | awk 'NR > 1 { sum += $1 } END { print sum }')
+  linked=$($SIZE "$dir/sketch" | awk 'NR == 2 { print $1, $2, $3 }')
+  class=$("$dir/sketch" class)
+  printf "%-28s %8s %8s %6s %6s %6s\n" "$name" "$object" $linked "$class"
+}
+
+row full
+row no-dpt-extended -DKNX_FEATURE_DPT_EXTENDED=0
+row no-async-read -DKNX_FEATURE_ASYNC_READ=0
+row no-rx-ring -DKNX_FEATURE_RX_RING=0
+row no-secure -DKNX_FEATURE_SECURE=0
+row no-device-services -DKNX_FEATURE_DEVICE_SERVICES=0
+row no-virtual-devices -DKNX_FEATURE_VIRTUAL_DEVICES=0
+row no-coupler -DKNX_FEATURE_COUPLER=0
+row no-reset-recovery -DKNX_FEATURE_RESET_RECOVERY=0
+row no-tx-queue -DKNX_FEATURE_TX_QUEUE=0 -DKNX_FEATURE_COUPLER=0
+row diagnostics-0 -DKNX_DIAGNOSTICS=0
+row minimal $NONE
+row minimal-8-addresses $NONE -DMAX_LISTEN_GROUP_ADDRESSES=8
@@ -0,0 +1,26 @@
+// File: sketch.cpp
+// Smallest useful sketch for size_matrix.sh: listen to a group address,
+// receive and answer with a write. Only uses what every configuration has.
+
+// Last modified: 18.10.2026
+
+#include "KnxTpUart.h"
+
+#include <stdio.h>
+
+KnxTpUart knx(&Serial, "1.1.199");
+
+int main(int argc, char**) {
+  if (argc > 1) {
+    printf("%u\n", (unsigned) sizeof(KnxTpUart));
+    return 0;
+  }
+
+  knx.uartReset();
+  knx.addListenGroupAddress("1/2/3");
+  while (true) {
+    if (knx.serialEvent() == KNX_TELEGRAM) {
+      knx.groupWriteBool("1/2/4", knx.getReceivedTelegram()->getBool());
+    }
+  }
+}
@@ -0,0 +1,72 @@
+// File: KnxTest.h
+// Tiny test runner for the host build, modelled on the ArduinoUnit macros
+// used by examples/UnitTests so the tests read the same on both sides.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxTest_h
+#define KnxTest_h
+
+#include <stdio.h>
+
+struct KnxTestCase {
+  const char* name;
+  void (*function)();
+  KnxTestCase* next;
+};
+
+inline KnxTestCase*& knxTestList() {
+  static KnxTestCase* list = NULL;
+  return list;
+}
+
+inline bool& knxTestFailed() {
+  static bool failed = false;
+  return failed;
+}
+
+struct KnxTestRegistration {
+  KnxTestRegistration(KnxTestCase* test) {
+    // Keep declaration order
+    KnxTestCase** tail = &knxTestList();
+    while (*tail != NULL) {
+      tail = &(*tail)->next;
+    }
+    *tail = test;
+  }
+};
+
+#define test(name) \
+  static void test_##name(); \
+  static KnxTestCase testCase_##name = { #name, test_##name, NULL }; \
+  static KnxTestRegistration testRegistration_##name(&testCase_##name); \
+  static void test_##name()
+
+#define KNX_TEST_FAIL(text) \
+  do { \
+    printf("  %s:%d: %s\n", __FILE__, __LINE__, text); \
+    knxTestFailed() = true; \
+    return; \
+  } while (0)
+
+#define assertTrue(condition) \
+  do { if (!(condition)) KNX_TEST_FAIL("assertTrue(" #condition ")"); } while (0)
+
+#define assertEquals(expected, actual) \
+  do { if (!((expected) == (actual))) KNX_TEST_FAIL("assertEquals(" #expected ", " #actual ")"); } while (0)
+
+inline int knxTestRun() {
+  int failures = 0;
+  int count = 0;
+  for (KnxTestCase* test = knxTestList(); test != NULL; test = test->next) {
+    knxTestFailed() = false;
+    test->function();
+    printf("Test %s %s\n", test->name, knxTestFailed() ? "failed" : "passed");
+    failures += knxTestFailed() ? 1 : 0;
+    count++;
+  }
+  printf("%d tests, %d failed\n", count, failures);
+  return failures == 0 ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,151 @@
+// File: KnxTestSupport.h
+// Shared pieces of the host tests and benchmarks. KnxTestBus is the
+// simulated line most tests run on: a TpUartSimulator behind a pty, a
+// KnxTpUart on it and an event loop that counts what serialEvent()
+// reports. A test derives its Fixture from it and adds only what it needs.
+// The streams discard or collect what the library prints.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxTestSupport_h
+#define KnxTestSupport_h
+
+#include <string>
+#include <vector>
+
+#include "KnxEventLoop.h"
+#include "KnxTpUart.h"
+#include "PosixSerial.h"
+#include "TpUartSimulator.h"
+
+// A KnxTpUart without a TP-UART: writes vanish, nothing is ever received
+class NullStream : public Stream {
+  public:
+    size_t write(uint8_t) {
+      return 1;
+    }
+    int available() {
+      return 0;
+    }
+    int read() {
+      return -1;
+    }
+    int peek() {
+      return -1;
+    }
+};
+
+class StringPrint : public Print {
+  public:
+    std::string text;
+
+    size_t write(uint8_t c) {
+      text += (char) c;
+      return 1;
+    }
+};
+
+class VectorPrint : public Print {
+  public:
+    std::vector<uint8_t> data;
+
+    size_t write(uint8_t b) {
+      data.push_back(b);
+      return 1;
+    }
+    size_t write(const uint8_t* buffer, size_t size) {
+      data.insert(data.end(), buffer, buffer + size);
+      return size;
+    }
+};
+
+struct KnxTestBus {
+  TpUartSimulator sim;
+  PosixSerial serial;
+  KnxTpUart knx;
+  KnxEventLoop loop;
+  KnxTpUartSerialEventType lastEvent;
+  int events;
+  int telegrams;  // KNX_TELEGRAM events
+  int resets;     // TPUART_RESET_INDICATION events
+
+  explicit KnxTestBus(const char* address = "1.1.199") : knx(&serial, address) {
+    lastEvent = TPUART_UNKNOWN_EVENT;
+    events = 0;
+    telegrams = 0;
+    resets = 0;
+    serial.attach(sim.openPty());
+    sim.start();
+    loop.add(&serial, &knx, onEvent, this);
+  }
+
+  virtual ~KnxTestBus() {}
+
+  // For every KNX_TELEGRAM event, the telegram is in knx
+  virtual void telegram() {}
+  // On every pass of runUntil()
+  virtual void poll() {}
+
+  static void onEvent(KnxTpUart*, KnxTpUartSerialEventType event, void* context) {
+    KnxTestBus* bus = (KnxTestBus*) context;
+    bus->lastEvent = event;
+    bus->events++;
+    if (event == KNX_TELEGRAM) {
+      bus->telegrams++;
+      bus->telegram();
+    }
+    else if (event == TPUART_RESET_INDICATION) {
+      bus->resets++;
+    }
+  }
+
+  void inject(KnxTelegram* tg) {
+    sim.inject(tg->getBuffer(), tg->getTotalLength());
+  }
+
+  // A 1 byte value from 1.1.20 to a group address
+  void injectGroup(KnxCommandType command, int main, int middle, int sub, int value) {
+    KnxTelegram tg;
+    tg.setSourceAddress(1, 1, 20);
+    tg.setTargetGroupAddress(main, middle, sub);
+    tg.setCommand(command);
+    tg.set1ByteIntValue(value);
+    tg.createChecksum();
+    inject(&tg);
+  }
+
+  // Runs the loop until done() or the timeout, false on the timeout
+  template <typename Condition>
+  bool runUntil(Condition done, unsigned long timeoutMs = 1000, int pollMs = 10) {
+    unsigned long start = millis();
+    while (!done()) {
+      if (millis() - start >= timeoutMs) {
+        return false;
+      }
+      loop.runOnce(pollMs);
+      poll();
+    }
+    return true;
+  }
+
+  // Runs the loop for a while, for things that must not happen
+  void settle(unsigned long ms) {
+    runUntil([] { return false; }, ms);
+  }
+
+  // Without the loop: the simulator thread sees what we wrote a moment
+  // later
+  template <typename Condition>
+  bool waitUntil(Condition done, unsigned long timeoutMs = 1000) {
+    unsigned long start = millis();
+    while (!done()) {
+      if (millis() - start >= timeoutMs) {
+        return false;
+      }
+      delay(1);
+    }
+    return true;
+  }
+};
+
+#endif
@@ -0,0 +1,117 @@
+// File: test_analyzer.cpp
+// Offline capture statistics, single and multi threaded.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "KnxCaptureAnalyzer.h"
+#include "KnxTestSupport.h"
+
+static void writeFrame(KnxCaptureWriter* writer, int member, int sub, KnxCommandType command, int value, bool repeated) {
+  KnxTelegram tg;
+  tg.setSourceAddress(1, 1, member);
+  tg.setTargetGroupAddress(2, 0, sub);
+  tg.setCommand(command);
+  if (command != KNX_COMMAND_READ) {
+    tg.set2ByteIntValue(value);
+  }
+  tg.setRepeated(repeated);
+  tg.createChecksum();
+  writer->write(0, tg.getBuffer(), tg.getTotalLength(), 0);
+}
+
+// 3000 writes to 2/0/1 from 1.1.10, every tenth repeated, then 1000
+// reads of 2/0/2 from 1.1.11 answered by 1.1.12, plus acks and junk
+static void buildCapture(VectorPrint* out) {
+  KnxCaptureWriter writer;
+  writer.begin(out);
+  uint8_t ack = KNX_BUS_ACK;
+  for (int i = 0; i < 3000; i++) {
+    writeFrame(&writer, 10, 1, KNX_COMMAND_WRITE, i, i % 10 == 0);
+    writer.write(KNX_CAPTURE_ACK_CHAR, &ack, 1, 0);
+  }
+  for (int i = 0; i < 1000; i++) {
+    writeFrame(&writer, 11, 2, KNX_COMMAND_READ, 0, false);
+    writeFrame(&writer, 12, 2, KNX_COMMAND_ANSWER, 7000 + i, false);
+  }
+
+  uint8_t broken[9] = { 0xBC, 0x11, 0x0A, 0x10, 0x01, 0xE1, 0x00, 0x81, 0x00 };
+  writer.write(0, broken, sizeof(broken), 0);
+  writer.write(0, broken, 4, 0);
+}
+
+static bool sameStats(const KnxAddressStats& a, const KnxAddressStats& b) {
+  return a.frames == b.frames && a.repeats == b.repeats && a.bytes == b.bytes
+         && a.reads == b.reads && a.writes == b.writes && a.answers == b.answers
+         && a.lastValue == b.lastValue && a.lastValueLength == b.lastValueLength;
+}
+
+test(aggregatesPerAddress) {
+  VectorPrint capture;
+  buildCapture(&capture);
+
+  KnxCaptureAnalyzer analyzer;
+  assertTrue(analyzer.begin(capture.data.data(), capture.data.size()));
+  assertEquals(5000UL, analyzer.run(1));
+  assertEquals(3000UL, analyzer.getAckCount());
+  assertEquals(2UL, analyzer.getBadFrameCount());
+
+  const KnxAddressStats& write = analyzer.getGroupStats((2 << 11) | 1);
+  assertEquals(3000u, write.frames);
+  assertEquals(3000u, write.writes);
+  assertEquals(300u, write.repeats);
+  assertEquals(3000u * 11, write.bytes);
+  assertEquals(2999u, write.lastValue);
+  assertEquals(2, write.lastValueLength);
+
+  const KnxAddressStats& read = analyzer.getGroupStats((2 << 11) | 2);
+  assertEquals(1000u, read.reads);
+  assertEquals(1000u, read.answers);
+  assertEquals(7999u, read.lastValue);
+
+  assertEquals(300u, analyzer.getSourceStats(0x110A).repeats);
+  assertEquals(1000u, analyzer.getSourceStats(0x110C).frames);
+
+  uint16_t top[4];
+  assertEquals(3, analyzer.getTopSources(top, 4));
+  assertEquals(0x110A, top[0]);
+  assertEquals(0x110B, top[1]);
+  assertEquals(0x110C, top[2]);
+  assertEquals(2, analyzer.getTopGroups(top, 4));
+  assertEquals((2 << 11) | 1, top[0]);
+}
+
+test(threadsGiveSameResult) {
+  VectorPrint capture;
+  buildCapture(&capture);
+
+  char path[] = "/tmp/knxcaptureXXXXXX";
+  int fd = mkstemp(path);
+  assertTrue(fd >= 0);
+  assertTrue(write(fd, capture.data.data(), capture.data.size()) == (ssize_t) capture.data.size());
+  close(fd);
+
+  KnxCaptureAnalyzer single;
+  KnxCaptureAnalyzer parallel;
+  assertTrue(single.begin(capture.data.data(), capture.data.size()));
+  assertTrue(parallel.open(path));
+  unlink(path);
+
+  assertEquals(single.run(1), parallel.run(7));
+  assertEquals(single.getAckCount(), parallel.getAckCount());
+  assertEquals(single.getBadFrameCount(), parallel.getBadFrameCount());
+  for (int a = 0; a < KNX_ANALYZER_ADDRESSES; a++) {
+    assertTrue(sameStats(single.getGroupStats(a), parallel.getGroupStats(a)));
+    assertTrue(sameStats(single.getSourceStats(a), parallel.getSourceStats(a)));
+  }
+}
+
+int main() {
+  return knxTestRun();
+}
@@ -0,0 +1,111 @@
+// File: test_busmonitor.cpp
+// Busmonitor and passive listen modes with the monitor capture ring.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include <string>
+
+#include "KnxTestSupport.h"
+
+static int buildWrite(uint8_t* frame, int sub, int value) {
+  KnxTelegram tg;
+  tg.setSourceAddress(1, 1, 20);
+  tg.setTargetGroupAddress(1, 2, sub);
+  tg.setCommand(KNX_COMMAND_WRITE);
+  tg.set1ByteIntValue(value);
+  tg.createChecksum();
+  for (int i = 0; i < tg.getTotalLength(); i++) {
+    frame[i] = tg.getBufferByte(i);
+  }
+  return tg.getTotalLength();
+}
+
+struct Fixture : KnxTestBus {
+  KnxMonitorRing ring;
+
+  Fixture() {
+    knx.setMonitorRing(&ring);
+    knx.addListenGroupAddress("1/2/3");
+  }
+
+  bool waitForRecords(int count) {
+    return runUntil([&] { return ring.available() >= count; });
+  }
+};
+
+test(busmonitorRecordsFramesAndAcks) {
+  Fixture f;
+  f.knx.uartActivateBusmonitor();
+  assertTrue(f.waitUntil([&] { return f.sim.isBusmonitor(); }));
+
+  uint8_t bus[2 * MAX_KNX_TELEGRAM_SIZE + 2];
+  int length = buildWrite(bus, 3, 10);
+  bus[length++] = KNX_BUS_ACK;
+  int second = length;
+  length += buildWrite(bus + length, 4, 11);
+  bus[length++] = KNX_BUS_NAK;
+  f.sim.inject(bus, length);
+
+  assertTrue(f.waitForRecords(4));
+  KnxMonitorRecord record;
+  assertTrue(f.ring.read(&record));
+  assertEquals(KNX_MONITOR_FRAME, record.type);
+  assertEquals(10, record.length);
+  assertEquals(3, KnxTelegramView(record.data).getTargetAddress() & 0xFF);
+  assertTrue(f.ring.read(&record));
+  assertEquals(KNX_MONITOR_ACK, record.type);
+  assertEquals(KNX_BUS_ACK, record.data[0]);
+  assertTrue(f.ring.read(&record));
+  assertEquals(KNX_MONITOR_FRAME, record.type);
+  assertEquals(bus[second + 8], record.data[8]);
+  assertTrue(f.ring.read(&record));
+  assertEquals(KNX_BUS_NAK, record.data[0]);
+
+  // Nothing is acknowledged and nothing can be sent
+  assertEquals(0u, f.sim.getAckBytes().size());
+  assertTrue(!f.knx.groupWrite1ByteInt("1/2/3", 1));
+
+  f.knx.uartReset();
+  assertEquals(KNX_MODE_NORMAL, f.knx.getMode());
+}
+
+test(passiveListenDoesNotAck) {
+  Fixture f;
+  f.knx.setPassiveListen(true);
+
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  int length = buildWrite(frame, 3, 42);
+  f.sim.inject(frame, length);
+
+  assertTrue(f.waitForRecords(1));
+  assertEquals(42, f.knx.getReceivedTelegram()->get1ByteIntValue());
+  delay(20);
+  assertEquals(0u, f.sim.getAckBytes().size());
+}
+
+test(exportStreamsRecords) {
+  KnxMonitorRing ring;
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  int length = buildWrite(frame, 3, 10);
+  uint8_t ack = KNX_BUS_ACK;
+  ring.push(KNX_MONITOR_FRAME, frame, length, 1000);
+  ring.push(KNX_MONITOR_ACK, &ack, 1, 5000);
+
+  StringPrint out;
+  assertEquals(1, ring.exportTo(&out, 1));
+  assertEquals(1, ring.exportTo(&out, 10));
+  assertEquals(0, ring.exportTo(&out, 10));
+  assertTrue(out.text == "1000 F BC 11 14 0A 03 E2 00 80 0A 27\r\n5000 A CC\r\n");
+
+  for (int i = 0; i < TPUART_MONITOR_RING_SIZE; i++) {
+    ring.push(KNX_MONITOR_ACK, &ack, 1, i);
+  }
+  assertEquals(TPUART_MONITOR_RING_SIZE - 1, ring.available());
+  assertEquals(1UL, ring.getDroppedCount());
+}
+
+int main() {
+  return knxTestRun();
+}
@@ -0,0 +1,172 @@
+// File: test_capture.cpp
+// Capture format, the recorder hooks in KnxTpUart and the replayer.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include <chrono>
+#include <vector>
+
+#include "KnxCaptureReplayer.h"
+#include "KnxTestSupport.h"
+
+static int buildWrite(uint8_t* frame, int sub, int value) {
+  KnxTelegram tg;
+  tg.setSourceAddress(1, 1, 20);
+  tg.setTargetGroupAddress(1, 2, sub);
+  tg.setCommand(KNX_COMMAND_WRITE);
+  tg.set1ByteIntValue(value);
+  tg.createChecksum();
+  for (int i = 0; i < tg.getTotalLength(); i++) {
+    frame[i] = tg.getBufferByte(i);
+  }
+  return tg.getTotalLength();
+}
+
+test(writerReaderRoundTrip) {
+  VectorPrint out;
+  KnxCaptureWriter writer;
+  writer.begin(&out);
+
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  int length = buildWrite(frame, 3, 9);
+  uint8_t ack = KNX_BUS_ACK;
+  writer.write(0, frame, length, 0xFFFFFF00UL);
+  writer.write(KNX_CAPTURE_ACK_CHAR, &ack, 1, 0x00000100UL);
+  assertEquals(2UL, writer.getRecordCount());
+  assertEquals((size_t) (KNX_CAPTURE_HEADER_SIZE + 2 * KNX_CAPTURE_RECORD_HEADER_SIZE + length + 1), out.data.size());
+
+  KnxCaptureReader reader;
+  assertTrue(reader.begin(out.data.data(), out.data.size()));
+  KnxCaptureRecord record;
+  assertTrue(reader.next(&record));
+  assertEquals(0xFFFFFF00UL, record.timestamp);
+  assertEquals(length, record.length);
+  assertEquals(frame[8], record.data[8]);
+  assertTrue(reader.next(&record));
+  assertEquals(KNX_CAPTURE_ACK_CHAR, record.flags);
+  assertEquals(0x200u, (uint32_t) (record.timestamp - 0xFFFFFF00UL));
+  assertTrue(!reader.next(&record));
+
+  // A record cut off at the end of the file is not returned
+  assertTrue(reader.begin(out.data.data(), out.data.size() - 1));
+  assertTrue(reader.next(&record));
+  assertTrue(!reader.next(&record));
+
+  out.data[4] = KNX_CAPTURE_VERSION + 1;
+  assertTrue(!reader.begin(out.data.data(), out.data.size()));
+}
+
+test(recorderSeesReceiveAndTransmit) {
+  KnxTestBus f;
+  VectorPrint out;
+  KnxCaptureWriter writer;
+  writer.begin(&out);
+  f.knx.setCaptureWriter(&writer);
+  f.knx.addListenGroupAddress("1/2/3");
+
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  f.sim.inject(frame, buildWrite(frame, 3, 5));
+  f.runUntil([&] { return writer.getRecordCount() >= 1; });
+  f.sim.setConfirmSuccess(false);
+  assertTrue(!f.knx.groupWrite1ByteInt("1/2/4", 6));
+
+  KnxCaptureReader reader;
+  KnxCaptureRecord record;
+  assertTrue(reader.begin(out.data.data(), out.data.size()));
+  assertTrue(reader.next(&record));
+  assertEquals(KNX_CAPTURE_ACKNOWLEDGED, record.flags);
+  assertEquals(5, record.data[8]);
+  assertTrue(reader.next(&record));
+  assertEquals(KNX_CAPTURE_TX | KNX_CAPTURE_NOT_CONFIRMED, record.flags);
+  assertEquals(6, record.data[8]);
+}
+
+struct EventCounts {
+  int telegrams;
+  int irrelevant;
+  int other;
+  unsigned long lastStart;
+};
+
+static void countEvent(KnxTpUart* knx, KnxTpUartSerialEventType event, void* context) {
+  EventCounts* counts = (EventCounts*) context;
+  if (event == KNX_TELEGRAM) {
+    counts->telegrams++;
+    counts->lastStart = knx->getReceivedTelegram()->getStartTime();
+  }
+  else if (event == IRRELEVANT_KNX_TELEGRAM) {
+    counts->irrelevant++;
+  }
+  else {
+    counts->other++;
+  }
+}
+
+static void buildCapture(VectorPrint* out) {
+  KnxCaptureWriter writer;
+  writer.begin(out);
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  uint8_t ack = KNX_BUS_ACK;
+  writer.write(0, frame, buildWrite(frame, 3, 1), 1000);
+  writer.write(KNX_CAPTURE_ACK_CHAR, &ack, 1, 13000);
+  writer.write(KNX_CAPTURE_TX, frame, buildWrite(frame, 9, 2), 50000);
+  writer.write(0, frame, buildWrite(frame, 4, 3), 100000);
+  writer.write(0, frame, buildWrite(frame, 3, 4), 100000 + 60000000UL);
+}
+
+test(replayFeedsSerialEvent) {
+  VectorPrint capture;
+  buildCapture(&capture);
+
+  NullStream out;
+  KnxTpUart knx(&out, "1.1.199");
+  knx.addListenGroupAddress("1/2/3");
+  KnxCaptureReplayer replayer(&knx);
+  EventCounts counts = { 0, 0, 0, 0 };
+  replayer.setEventHandler(countEvent, &counts);
+  assertTrue(replayer.begin(capture.data.data(), capture.data.size()));
+
+  // A minute of capture replays at once, the clock follows the capture
+  hostClockSetVirtual(true);
+  unsigned long clockStart = micros();
+  std::chrono::steady_clock::time_point realStart = std::chrono::steady_clock::now();
+  assertEquals(4UL, replayer.run());
+  assertTrue(std::chrono::steady_clock::now() - realStart < std::chrono::seconds(1));
+  hostClockSetVirtual(false);
+
+  assertEquals(1UL, replayer.getSkippedCount());
+  assertEquals(2, counts.telegrams);
+  assertEquals(1, counts.irrelevant);
+  assertEquals(1, counts.other);
+  assertEquals(60099000UL, counts.lastStart - clockStart);
+  assertEquals(4, knx.getReceivedTelegram()->get1ByteIntValue());
+}
+
+test(replayKeepsScaledSpacing) {
+  VectorPrint capture;
+  KnxCaptureWriter writer;
+  writer.begin(&capture);
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  int length = buildWrite(frame, 3, 1);
+  writer.write(0, frame, length, 0);
+  writer.write(0, frame, length, 200000);
+
+  NullStream out;
+  KnxTpUart knx(&out, "1.1.199");
+  KnxCaptureReplayer replayer(&knx);
+  replayer.setSpeed(10);
+  assertTrue(replayer.begin(capture.data.data(), capture.data.size()));
+
+  std::chrono::steady_clock::time_point realStart = std::chrono::steady_clock::now();
+  assertEquals(2UL, replayer.run());
+  std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - realStart;
+  assertTrue(elapsed >= std::chrono::milliseconds(20));
+  assertTrue(elapsed < std::chrono::milliseconds(500));
+  assertTrue(!hostClockIsVirtual());
+}
+
+int main() {
+  return knxTestRun();
+}
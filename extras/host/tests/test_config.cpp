@@ -0,0 +1,91 @@
+// File: test_config.cpp
+// Configuration blob: round trip, integrity checks, byte reader variant.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include <string.h>
+
+#include "KnxTestSupport.h"
+#include "KnxTpUart.h"
+
+static NullStream out;
+
+static int configure(KnxTpUart* knx, uint8_t* blob, int size) {
+  knx->addListenGroupAddress("1/2/3");
+  knx->addListenGroupAddress("0/0/1");
+  knx->addListenGroupAddress("31/7/255");
+  knx->setListenToBroadcasts(true);
+  knx->setTxInterval(40);
+  return knx->saveConfig(blob, size);
+}
+
+test(roundTrip) {
+  KnxTpUart source(&out, "1.1.199");
+  uint8_t blob[KNX_CONFIG_SIZE(MAX_LISTEN_GROUP_ADDRESSES)];
+  int length = configure(&source, blob, sizeof(blob));
+  assertEquals(KNX_CONFIG_SIZE(3), length);
+
+  KnxTpUart knx(&out, (uint16_t) 0xFFFF);
+  assertTrue(knx.loadConfig(blob, length));
+  assertEquals(source.getIndividualAddress(), knx.getIndividualAddress());
+  assertTrue(knx.isListeningToGroupAddress(1, 2, 3));
+  assertTrue(knx.isListeningToGroupAddress(0, 0, 1));
+  assertTrue(knx.isListeningToGroupAddress(31, 7, 255));
+  assertTrue(!knx.isListeningToGroupAddress(1, 2, 4));
+
+  uint8_t again[sizeof(blob)];
+  assertEquals(length, knx.saveConfig(again, sizeof(again)));
+  assertEquals(0, memcmp(blob, again, length));
+}
+
+test(corruptBlobKeepsConfiguration) {
+  KnxTpUart source(&out, "1.1.199");
+  uint8_t blob[64];
+  int length = configure(&source, blob, sizeof(blob));
+
+  KnxTpUart knx(&out, "2.3.4");
+  knx.addListenGroupAddress("5/5/5");
+
+  blob[KNX_CONFIG_HEADER_SIZE] ^= 0x01;
+  assertTrue(!knx.loadConfig(blob, length));
+  blob[KNX_CONFIG_HEADER_SIZE] ^= 0x01;
+
+  blob[2] = KNX_CONFIG_VERSION + 1;
+  assertTrue(!knx.loadConfig(blob, length));
+  blob[2] = KNX_CONFIG_VERSION;
+
+  assertTrue(!knx.loadConfig(blob, length - 1));
+
+  assertEquals(0x2304, knx.getIndividualAddress());
+  assertTrue(knx.isListeningToGroupAddress(5, 5, 5));
+  assertTrue(!knx.isListeningToGroupAddress(1, 2, 3));
+  assertTrue(knx.loadConfig(blob, length));
+}
+
+test(bufferTooSmall) {
+  KnxTpUart knx(&out, "1.1.199");
+  uint8_t blob[64];
+  assertEquals(0, configure(&knx, blob, KNX_CONFIG_SIZE(3) - 1));
+}
+
+static uint8_t eeprom[128];
+
+static uint8_t readEeprom(int address) {
+  return eeprom[address];
+}
+
+test(byteReader) {
+  KnxTpUart source(&out, "1.1.199");
+  configure(&source, eeprom + 16, sizeof(eeprom) - 16);
+
+  KnxTpUart knx(&out, (uint16_t) 0);
+  assertTrue(knx.loadConfig(readEeprom, 16));
+  assertEquals(0x11C7, knx.getIndividualAddress());
+  assertTrue(knx.isListeningToGroupAddress(31, 7, 255));
+}
+
+int main() {
+  return knxTestRun();
+}
@@ -0,0 +1,221 @@
+// File: test_coupler.cpp
+// Line coupler: filter table, routing counter, individual routing, echoes.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include "KnxEventLoop.h"
+#include "KnxTestSupport.h"
+#include "KnxTpUart.h"
+#include "PosixSerial.h"
+#include "TpUartSimulator.h"
+
+static void groupWrite(KnxTelegram* tg, int main, int middle, int sub, int counter) {
+  tg->clear();
+  tg->setSourceAddress(1, 1, 20);
+  tg->setTargetGroupAddress(main, middle, sub);
+  tg->setRoutingCounter(counter);
+  tg->setCommand(KNX_COMMAND_WRITE);
+  tg->set1ByteIntValue(42);
+  tg->createChecksum();
+}
+
+static void individual(KnxTelegram* tg, int area, int line, int member, int counter) {
+  tg->clear();
+  tg->setSourceAddress(1, 1, 20);
+  tg->setTargetIndividualAddress(area, line, member);
+  tg->setRoutingCounter(counter);
+  tg->setCommand(KNX_COMMAND_MASK_VERSION_READ);
+  tg->createChecksum();
+}
+
+struct Lines {
+  NullStream out;
+  KnxTpUart a;
+  KnxTpUart b;
+  KnxTxQueue queueA;
+  KnxTxQueue queueB;
+  KnxCoupler coupler;
+
+  Lines() : a(&out, "1.1.0"), b(&out, "1.0.0") {
+    coupler.addPort(&a, &queueA, "1.1");
+    coupler.addPort(&b, &queueB, "1.0");
+    coupler.setMainPort(1);
+  }
+};
+
+test(filterAndRoutingCounter) {
+  Lines l;
+  l.coupler.addFilterGroupAddress("1/2/3");
+  KnxTelegram tg;
+
+  groupWrite(&tg, 1, 2, 3, 6);
+  assertEquals(KNX_COUPLER_ACCEPT, l.coupler.accepts(0, tg.getBuffer()));
+  l.coupler.received(0, tg.getBuffer());
+  groupWrite(&tg, 1, 2, 4, 6);
+  assertEquals(KNX_COUPLER_IGNORE, l.coupler.accepts(0, tg.getBuffer()));
+  l.coupler.received(0, tg.getBuffer());
+
+  assertEquals(1, l.queueB.size());
+  assertEquals(0, l.queueA.size());
+  KnxTelegramView view(l.queueB.front()->frame);
+  assertEquals(tg.getTotalLength(), l.queueB.front()->length);
+  assertEquals(5, view.getRoutingCounter());
+  assertTrue(view.verifyChecksum());
+  assertEquals(0x0A03, view.getTargetAddress());
+
+  // 7 is not decremented, 0 is not forwarded
+  groupWrite(&tg, 1, 2, 3, 7);
+  tg.setBufferByte(8, 43);
+  tg.createChecksum();
+  l.coupler.received(1, tg.getBuffer());
+  assertEquals(7, KnxTelegramView(l.queueA.front()->frame).getRoutingCounter());
+  groupWrite(&tg, 1, 2, 3, 0);
+  assertEquals(KNX_COUPLER_IGNORE, l.coupler.accepts(1, tg.getBuffer()));
+  l.coupler.received(1, tg.getBuffer());
+  assertEquals(1, l.queueA.size());
+
+  KnxCouplerStats up = l.coupler.getStats(0);
+  assertEquals(2ul, up.received);
+  assertEquals(1ul, up.forwarded);
+  assertEquals(1ul, up.filtered);
+  KnxCouplerStats down = l.coupler.getStats(1);
+  assertEquals(1ul, down.forwarded);
+  assertEquals(1ul, down.expired);
+}
+
+test(individualRouting) {
+  Lines l;
+  KnxTelegram tg;
+
+  // Local to the line
+  individual(&tg, 1, 1, 5, 6);
+  assertEquals(KNX_COUPLER_IGNORE, l.coupler.accepts(0, tg.getBuffer()));
+  l.coupler.received(0, tg.getBuffer());
+  assertEquals(0, l.queueB.size());
+
+  // Other line: up to the main line, and from there down
+  individual(&tg, 1, 2, 5, 6);
+  l.coupler.received(0, tg.getBuffer());
+  assertEquals(1, l.queueB.size());
+  individual(&tg, 1, 1, 6, 6);
+  l.coupler.received(1, tg.getBuffer());
+  assertEquals(1, l.queueA.size());
+  individual(&tg, 1, 3, 6, 6);
+  assertEquals(KNX_COUPLER_IGNORE, l.coupler.accepts(1, tg.getBuffer()));
+}
+
+test(echoesAndRepetitions) {
+  Lines l;
+  l.coupler.setPassAllGroups(true);
+  KnxTelegram tg;
+
+  groupWrite(&tg, 2, 0, 0, 6);
+  l.coupler.received(0, tg.getBuffer());
+  tg.setRepeated(true);
+  tg.createChecksum();
+  l.coupler.received(0, tg.getBuffer());
+  assertEquals(1, l.queueB.size());
+  assertEquals(1ul, l.coupler.getStats(0).echoes);
+
+  // Back from the main line through another coupler
+  groupWrite(&tg, 2, 0, 0, 4);
+  l.coupler.received(1, tg.getBuffer());
+  assertEquals(0, l.queueA.size());
+  assertEquals(1ul, l.coupler.getStats(1).echoes);
+
+  // The same value written again is a new frame
+  groupWrite(&tg, 2, 0, 0, 6);
+  l.coupler.received(0, tg.getBuffer());
+  assertEquals(2, l.queueB.size());
+}
+
+test(busyWhenQueueFull) {
+  Lines l;
+  l.coupler.setPassAllGroups(true);
+  KnxTelegram tg;
+
+  // Nobody drains line B
+  for (int i = 0; i < TPUART_TX_QUEUE_SIZE; i++) {
+    groupWrite(&tg, 2, 0, i, 6);
+    assertEquals(KNX_COUPLER_ACCEPT, l.coupler.accepts(0, tg.getBuffer()));
+    l.coupler.received(0, tg.getBuffer());
+  }
+  groupWrite(&tg, 2, 0, 100, 6);
+  assertEquals(KNX_COUPLER_BUSY, l.coupler.accepts(0, tg.getBuffer()));
+  // KnxTpUart hands every complete frame to received()
+  l.coupler.received(0, tg.getBuffer());
+  assertEquals(1ul, l.coupler.getStats(0).busy);
+  assertEquals(TPUART_TX_QUEUE_SIZE, l.queueB.size());
+  // The other direction still has room
+  assertEquals(KNX_COUPLER_ACCEPT, l.coupler.accepts(1, tg.getBuffer()));
+
+  // Room again for the repetition, which is forwarded and not an echo
+  l.queueB.pop();
+  tg.setRepeated(true);
+  tg.createChecksum();
+  assertEquals(KNX_COUPLER_ACCEPT, l.coupler.accepts(0, tg.getBuffer()));
+  l.coupler.received(0, tg.getBuffer());
+  assertEquals(TPUART_TX_QUEUE_SIZE, l.queueB.size());
+  assertEquals(0ul, l.coupler.getStats(0).echoes);
+  assertEquals((unsigned long) TPUART_TX_QUEUE_SIZE + 1, l.coupler.getStats(0).forwarded);
+  for (int i = 1; i < TPUART_TX_QUEUE_SIZE; i++) {
+    l.queueB.pop();
+  }
+  assertEquals(0x1064, KnxTelegramView(l.queueB.front()->frame).getTargetAddress());
+}
+
+test(forwardOverTpUarts) {
+  TpUartSimulator simA;
+  TpUartSimulator simB;
+  PosixSerial serialA;
+  PosixSerial serialB;
+  KnxTpUart a(&serialA, "1.1.0");
+  KnxTpUart b(&serialB, "1.0.0");
+  KnxTxQueue queueA;
+  KnxTxQueue queueB;
+  KnxEventLoop loop;
+  serialA.attach(simA.openPty());
+  serialB.attach(simB.openPty());
+  simA.start();
+  simB.start();
+  loop.add(&serialA, &a, NULL);
+  loop.add(&serialB, &b, NULL);
+
+  KnxCoupler coupler;
+  coupler.addPort(&a, &queueA, "1.1");
+  coupler.addPort(&b, &queueB, "1.0");
+  coupler.addFilterGroupAddress("1/2/3");
+
+  KnxTelegram tg;
+  for (int i = 0; i < 5; i++) {
+    groupWrite(&tg, 1, 2, 3, 6);
+    tg.setBufferByte(8, i);
+    tg.createChecksum();
+    simA.inject(tg.getBuffer(), tg.getTotalLength());
+    groupWrite(&tg, 1, 2, 3, 6);
+    tg.setBufferByte(8, 100 + i);
+    tg.createChecksum();
+    simB.inject(tg.getBuffer(), tg.getTotalLength());
+  }
+
+  unsigned long start = millis();
+  while ((simA.getSentFrames().size() < 5 || simB.getSentFrames().size() < 5) && millis() - start < 2000) {
+    loop.runOnce(10);
+  }
+  std::vector<std::vector<uint8_t> > toB = simB.getSentFrames();
+  std::vector<std::vector<uint8_t> > toA = simA.getSentFrames();
+  assertEquals(5u, toB.size());
+  assertEquals(5u, toA.size());
+  for (int i = 0; i < 5; i++) {
+    assertEquals(i, toB[i][8]);
+    assertEquals(100 + i, toA[i][8]);
+    assertEquals(5, KnxTelegramView(&toB[i][0]).getRoutingCounter());
+  }
+  assertEquals(0b00010001, simA.getAckBytes()[0]);
+}
+
+int main() {
+  return knxTestRun();
+}
@@ -0,0 +1,202 @@
+// File: test_device_memory.cpp
+// Memory and property services on the device image, lazy flushing.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include <vector>
+
+#include "KnxTestSupport.h"
+
+struct FlushCall {
+  uint16_t offset;
+  uint16_t length;
+};
+
+static std::vector<FlushCall> flushes;
+
+static bool recordFlush(uint16_t offset, const uint8_t*, uint16_t length) {
+  FlushCall call = { offset, length };
+  flushes.push_back(call);
+  return true;
+}
+
+static void memoryRequest(KnxTelegram* tg, KnxCommandType command, unsigned int address, int count, const uint8_t* data) {
+  tg->clear();
+  tg->setSourceAddress(1, 1, 250);
+  tg->setTargetIndividualAddress(1, 1, 199);
+  tg->setCommand(command);
+  tg->setFirstDataByte(count);
+  tg->setBufferByte(8, address >> 8);
+  tg->setBufferByte(9, address & 0xFF);
+  int n = data != NULL ? count : 0;
+  for (int i = 0; i < n; i++) {
+    tg->setBufferByte(10 + i, data[i]);
+  }
+  tg->setPayloadLength(4 + n);
+  tg->createChecksum();
+}
+
+static void propertyRequest(KnxTelegram* tg, int service, int id, int count, int start, const uint8_t* data, int length) {
+  tg->clear();
+  tg->setSourceAddress(1, 1, 250);
+  tg->setTargetIndividualAddress(1, 1, 199);
+  tg->setCommand(KNX_COMMAND_ESCAPE);
+  tg->setFirstDataByte(service);
+  tg->setBufferByte(8, 0);
+  tg->setBufferByte(9, id);
+  tg->setBufferByte(10, (count << 4) | (start >> 8));
+  tg->setBufferByte(11, start & 0xFF);
+  for (int i = 0; i < length; i++) {
+    tg->setBufferByte(12 + i, data[i]);
+  }
+  tg->setPayloadLength(6 + length);
+  tg->createChecksum();
+}
+
+static const KnxProperty properties[] = {
+  { 0, 11, 0, 6, 1, 0x00 },                      // Serial number, read only
+  { 0, 50, KNX_PROPERTY_WRITABLE, 2, 4, 0x10 },  // Four 2 byte parameters
+};
+
+test(memoryReadWrite) {
+  uint8_t image[256] = { 0 };
+  KnxDeviceMemory memory(image, sizeof(image), 0x4000);
+  KnxTelegram request;
+  KnxTelegram response;
+
+  uint8_t data[12] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+  memoryRequest(&request, KNX_COMMAND_MEMORY_WRITE, 0x4020, 12, data);
+  assertEquals(KNX_SERVICE_DONE, memory.handle(&request, &response));
+  assertEquals(12, image[0x2B]);
+
+  memoryRequest(&request, KNX_COMMAND_MEMORY_READ, 0x4024, 12, NULL);
+  assertEquals(KNX_SERVICE_RESPOND, memory.handle(&request, &response));
+  assertEquals(KNX_COMMAND_MEMORY_RESPONSE, response.getCommand());
+  assertEquals(12, response.getFirstDataByte());
+  assertEquals(16, response.getPayloadLength());
+  assertEquals(0x40, response.getBufferByte(8));
+  assertEquals(0x24, response.getBufferByte(9));
+  assertEquals(5, response.getBufferByte(10));
+  assertEquals(0, response.getBufferByte(21));
+  assertEquals(250, response.getTargetMember());
+  assertTrue(!response.isTargetGroup());
+  assertTrue(response.verifyChecksum());
+
+  // Outside the image: answered without data
+  memoryRequest(&request, KNX_COMMAND_MEMORY_READ, 0x40FA, 12, NULL);
+  assertEquals(KNX_SERVICE_RESPOND, memory.handle(&request, &response));
+  assertEquals(0, response.getFirstDataByte());
+  assertEquals(4, response.getPayloadLength());
+
+  request.setTargetGroupAddress(1, 2, 3);
+  assertEquals(KNX_SERVICE_IGNORED, memory.handle(&request, &response));
+}
+
+test(propertyReadWrite) {
+  uint8_t image[64] = { 0x00, 0xFA, 0x01, 0x02, 0x03, 0x04 };
+  KnxDeviceMemory memory(image, sizeof(image));
+  memory.setProperties(properties, 2);
+  KnxTelegram request;
+  KnxTelegram response;
+
+  propertyRequest(&request, KNX_EXT_COMMAND_PROPERTY_VALUE_READ, 11, 1, 1, NULL, 0);
+  assertEquals(KNX_SERVICE_RESPOND, memory.handle(&request, &response));
+  assertEquals(KNX_EXT_COMMAND_PROPERTY_VALUE_RESPONSE, response.getFirstDataByte());
+  assertEquals(0x10, response.getBufferByte(10));
+  assertEquals(12, response.getPayloadLength());
+  assertEquals(0xFA, response.getBufferByte(13));
+
+  // Number of elements
+  propertyRequest(&request, KNX_EXT_COMMAND_PROPERTY_VALUE_READ, 50, 1, 0, NULL, 0);
+  memory.handle(&request, &response);
+  assertEquals(4, response.getBufferByte(13));
+
+  uint8_t value[4] = { 0x12, 0x34, 0x56, 0x78 };
+  propertyRequest(&request, KNX_EXT_COMMAND_PROPERTY_VALUE_WRITE, 50, 2, 3, value, 4);
+  assertEquals(KNX_SERVICE_RESPOND, memory.handle(&request, &response));
+  assertEquals(0x20, response.getBufferByte(10));
+  assertEquals(0x78, response.getBufferByte(15));
+  assertEquals(0x12, image[0x14]);
+  assertEquals(0x78, image[0x17]);
+
+  // Read only, beyond the last element, unknown property
+  propertyRequest(&request, KNX_EXT_COMMAND_PROPERTY_VALUE_WRITE, 11, 1, 1, value, 4);
+  memory.handle(&request, &response);
+  assertEquals(0x00, response.getBufferByte(10) & 0xF0);
+  assertEquals(0xFA, image[1]);
+  propertyRequest(&request, KNX_EXT_COMMAND_PROPERTY_VALUE_READ, 50, 2, 4, NULL, 0);
+  memory.handle(&request, &response);
+  assertEquals(0x00, response.getBufferByte(10) & 0xF0);
+  propertyRequest(&request, KNX_EXT_COMMAND_PROPERTY_VALUE_READ, 99, 1, 1, NULL, 0);
+  memory.handle(&request, &response);
+  assertEquals(6, response.getPayloadLength());
+}
+
+test(flushCoalescesBlocks) {
+  uint8_t image[DEVICE_MEMORY_BLOCK_SIZE * 8] = { 0 };
+  KnxDeviceMemory memory(image, sizeof(image));
+  memory.setFlushCallback(recordFlush);
+  memory.setFlushDelay(30);
+  flushes.clear();
+
+  // A download of three adjacent blocks and one further away
+  KnxTelegram request;
+  KnxTelegram response;
+  uint8_t data[12] = { 0 };
+  for (unsigned int address = 0; address < 3 * DEVICE_MEMORY_BLOCK_SIZE; address += 12) {
+    memoryRequest(&request, KNX_COMMAND_MEMORY_WRITE, address, 12, data);
+    memory.handle(&request, &response);
+  }
+  memoryRequest(&request, KNX_COMMAND_MEMORY_WRITE, 6 * DEVICE_MEMORY_BLOCK_SIZE + 4, 1, data);
+  memory.handle(&request, &response);
+
+  memory.poll();
+  assertEquals(0u, flushes.size());
+  delay(40);
+  memory.poll();
+  assertEquals(2u, flushes.size());
+  assertEquals(0, flushes[0].offset);
+  assertEquals(3 * DEVICE_MEMORY_BLOCK_SIZE, flushes[0].length);
+  assertEquals(6 * DEVICE_MEMORY_BLOCK_SIZE, flushes[1].offset);
+  assertEquals(DEVICE_MEMORY_BLOCK_SIZE, flushes[1].length);
+  assertTrue(!memory.isDirty());
+}
+
+test(answeredThroughConnection) {
+  KnxTestBus f;
+  KnxTransport transport(&f.knx);
+  uint8_t image[64] = { 0 };
+  image[0x10] = 0xAB;
+  KnxDeviceMemory memory(image, sizeof(image));
+  f.knx.setTransport(&transport);
+  f.knx.setDeviceMemory(&memory);
+
+  KnxTelegram tg;
+  tg.setSourceAddress(1, 1, 250);
+  tg.setTargetIndividualAddress(1, 1, 199);
+  tg.setCommunicationType(KNX_COMM_UCD);
+  tg.setControlData(KNX_CONTROLDATA_CONNECT);
+  tg.setPayloadLength(1);
+  tg.createChecksum();
+  f.inject(&tg);
+
+  memoryRequest(&tg, KNX_COMMAND_MEMORY_READ, 0x10, 1, NULL);
+  tg.setCommunicationType(KNX_COMM_NDP);
+  tg.createChecksum();
+  f.inject(&tg);
+
+  // T_ACK for the request, then the response as numbered data
+  f.runUntil([&] { return f.sim.getSentFrames().size() >= 2; });
+  std::vector<std::vector<uint8_t> > sent = f.sim.getSentFrames();
+  assertEquals(2u, sent.size());
+  assertEquals(0xC2, sent[0][6]);
+  assertEquals(0x42, sent[1][6]);
+  assertEquals(0x41, sent[1][7]);
+  assertEquals(0xAB, sent[1][10]);
+}
+
+int main() {
+  return knxTestRun();
+}
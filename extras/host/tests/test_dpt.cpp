@@ -0,0 +1,113 @@
+// File: test_dpt.cpp
+// Lighting, counter, scene and date-time codecs, each in one frame.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include <math.h>
+
+#include "KnxTestSupport.h"
+#include "KnxTpUart.h"
+
+test(scene) {
+  KnxTelegram tg;
+  tg.set1ByteSceneValue(63, true);
+  assertEquals(3, tg.getPayloadLength());
+  assertEquals(0xBF, tg.getBufferByte(8));
+  assertEquals(63, tg.get1ByteSceneNumberValue());
+  assertTrue(tg.get1ByteSceneLearnValue());
+
+  tg.set1ByteSceneValue(5, false);
+  assertEquals(5, tg.get1ByteSceneNumberValue());
+  assertTrue(!tg.get1ByteSceneLearnValue());
+}
+
+test(rgb) {
+  KnxTelegram tg;
+  tg.set3ByteColorValue(255, 128, 1);
+  assertEquals(5, tg.getPayloadLength());
+  assertEquals(255, tg.get3ByteRedValue());
+  assertEquals(128, tg.get3ByteGreenValue());
+  assertEquals(1, tg.get3ByteBlueValue());
+}
+
+test(counters) {
+  KnxTelegram tg;
+  tg.set4ByteUIntValue(0xDEADBEEF);
+  assertEquals(6, tg.getPayloadLength());
+  assertEquals(0xDE, tg.getBufferByte(8));
+  assertEquals(0xEF, tg.getBufferByte(11));
+  assertEquals(0xDEADBEEFu, tg.get4ByteUIntValue());
+
+  tg.set4ByteIntValue(-123456789);
+  assertEquals(-123456789, tg.get4ByteIntValue());
+}
+
+test(rgbw) {
+  KnxTelegram tg;
+  tg.set6ByteRGBWValue(10, 20, 30, 40);
+  assertEquals(8, tg.getPayloadLength());
+  assertEquals(10, tg.get6ByteRedValue());
+  assertEquals(20, tg.get6ByteGreenValue());
+  assertEquals(30, tg.get6ByteBlueValue());
+  assertEquals(40, tg.get6ByteWhiteValue());
+  assertEquals(0x0F, tg.getBufferByte(13));
+}
+
+test(xyY) {
+  KnxTelegram tg;
+  tg.set6ByteXYYValue(0.3127, 0.329, 200);
+  assertEquals(8, tg.getPayloadLength());
+  assertTrue(fabs(tg.get6ByteColorXValue() - 0.3127) < 0.0001);
+  assertTrue(fabs(tg.get6ByteColorYValue() - 0.329) < 0.0001);
+  assertEquals(200, tg.get6ByteBrightnessValue());
+  assertEquals(0x03, tg.getBufferByte(13));
+
+  tg.set6ByteXYYValue(1.5, -1, 0);
+  assertEquals(0xFF, tg.getBufferByte(8));
+  assertEquals(0x00, tg.getBufferByte(10));
+}
+
+test(dateTime) {
+  KnxTelegram tg;
+  tg.set8ByteDateTime(2026, 10, 18, 7, 23, 59, 58);
+  assertEquals(10, tg.getPayloadLength());
+  assertEquals(126, tg.getBufferByte(8));
+  assertEquals(2026, tg.get8ByteYearValue());
+  assertEquals(10, tg.get8ByteMonthValue());
+  assertEquals(18, tg.get8ByteDayValue());
+  assertEquals(7, tg.get8ByteWeekdayValue());
+  assertEquals(23, tg.get8ByteHourValue());
+  assertEquals(59, tg.get8ByteMinuteValue());
+  assertEquals(58, tg.get8ByteSecondValue());
+
+  // Other value types are rejected by the payload length check
+  tg.set3ByteColorValue(1, 2, 3);
+  assertEquals(0, tg.get8ByteYearValue());
+}
+
+test(singleFrame) {
+  NullStream out;
+  KnxTpUart knx(&out, "1.1.199");
+  KnxTxQueue queue;
+  knx.setTxQueue(&queue);
+
+  assertTrue(knx.groupWrite6ByteRGBW("1/2/3", 255, 0, 0, 64));
+  assertTrue(knx.groupAnswer8ByteDateTime("1/2/4", 2026, 1, 1, 4, 0, 0, 0));
+  assertEquals(2, queue.size());
+
+  KnxTxSlot* slot = queue.front();
+  assertEquals(KNX_TELEGRAM_HEADER_SIZE + 8 + 1, slot->length);
+  assertEquals(KNX_COMMAND_WRITE, KnxTelegramView(slot->frame).getCommand());
+  assertTrue(KnxTelegramView(slot->frame).verifyChecksum());
+  queue.pop();
+
+  slot = queue.front();
+  assertEquals(KNX_TELEGRAM_HEADER_SIZE + 10 + 1, slot->length);
+  assertEquals(KNX_COMMAND_ANSWER, KnxTelegramView(slot->frame).getCommand());
+}
+
+int main() {
+  return knxTestRun();
+}
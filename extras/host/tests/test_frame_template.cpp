@@ -0,0 +1,122 @@
+// File: test_frame_template.cpp
+// KnxFrameTemplate must produce the same bytes as the groupWrite*() calls.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include <vector>
+
+#include "KnxTestSupport.h"
+
+// Frames stay in the queue, the loop never runs
+struct Fixture : KnxTestBus {
+  KnxTxQueue queue;
+
+  Fixture() {
+    knx.setTxQueue(&queue);
+  }
+
+  std::vector<uint8_t> take() {
+    KnxTxSlot* slot = queue.front();
+    std::vector<uint8_t> frame(slot->frame, slot->frame + slot->length);
+    queue.pop();
+    return frame;
+  }
+};
+
+test(templateBoolMatchesGroupWrite) {
+  Fixture f;
+  KnxFrameTemplate t;
+  t.begin(f.knx.getIndividualAddress(), "2/6/0", KNX_COMMAND_WRITE, 0);
+
+  for (int value = 0; value < 2; value++) {
+    f.knx.groupWriteBool("2/6/0", value);
+    t.setBool(value);
+    f.knx.sendTemplate(&t);
+    std::vector<uint8_t> expected = f.take();
+    assertTrue(expected == f.take());
+  }
+}
+
+test(template1ByteMatchesGroupWrite) {
+  Fixture f;
+  KnxFrameTemplate t;
+  t.begin(f.knx.getIndividualAddress(), "5/6/7", KNX_COMMAND_WRITE, 1);
+
+  for (int value = 0; value < 256; value += 17) {
+    f.knx.groupWrite1ByteInt("5/6/7", value);
+    t.set1ByteIntValue(value);
+    f.knx.sendTemplate(&t);
+    std::vector<uint8_t> expected = f.take();
+    assertTrue(expected == f.take());
+  }
+}
+
+test(templateFloatAnswerMatchesGroupAnswer) {
+  Fixture f;
+  KnxFrameTemplate t2;
+  t2.begin(f.knx.getIndividualAddress(), "31/7/255", KNX_COMMAND_ANSWER, 2);
+  KnxFrameTemplate t4;
+  t4.begin(f.knx.getIndividualAddress(), "31/7/254", KNX_COMMAND_ANSWER, 4);
+
+  float values[] = { -30.5f, 0.0f, 21.37f, 670760.0f };
+  for (int i = 0; i < 4; i++) {
+    f.knx.groupAnswer2ByteFloat("31/7/255", values[i]);
+    t2.set2ByteFloatValue(values[i]);
+    f.knx.sendTemplate(&t2);
+    std::vector<uint8_t> expected = f.take();
+    assertTrue(expected == f.take());
+
+    f.knx.groupAnswer4ByteFloat("31/7/254", values[i]);
+    t4.set4ByteFloatValue(values[i]);
+    f.knx.sendTemplate(&t4);
+    expected = f.take();
+    assertTrue(expected == f.take());
+  }
+}
+
+test(mixedSettersKeepChecksum) {
+  Fixture f;
+  uint16_t source = f.knx.getIndividualAddress();
+
+  // Every setter leaves a valid frame, whatever was set before
+  KnxFrameTemplate t2;
+  t2.begin(source, "1/2/3", KNX_COMMAND_WRITE, 2);
+  t2.set2ByteIntValue(0x1234);
+  assertTrue(KnxTelegramView(t2.getFrame()).verifyChecksum());
+  t2.set2ByteFloatValue(21.5f);
+  assertTrue(KnxTelegramView(t2.getFrame()).verifyChecksum());
+  // Setters of another size are ignored
+  std::vector<uint8_t> before(t2.getFrame(), t2.getFrame() + t2.getLength());
+  t2.set1ByteIntValue(5);
+  t2.setBool(true);
+  t2.set4ByteFloatValue(1.0f);
+  assertTrue(before == std::vector<uint8_t>(t2.getFrame(), t2.getFrame() + t2.getLength()));
+
+  // set1ByteIntValue() must not write the checksum of a short frame
+  KnxFrameTemplate t0;
+  t0.begin(source, "1/2/4", KNX_COMMAND_WRITE, 0);
+  t0.setBool(true);
+  t0.set1ByteIntValue(5);
+  t0.set4ByteFloatValue(1.0f);
+  assertEquals(KNX_TELEGRAM_HEADER_SIZE + 3, t0.getLength());
+  assertTrue(KnxTelegramView(t0.getFrame()).verifyChecksum());
+  assertEquals(1, t0.getFrame()[7] & 0b00111111);
+
+  KnxFrameTemplate t1;
+  t1.begin(source, "1/2/5", KNX_COMMAND_WRITE, 1);
+  t1.set1ByteIntValue(7);
+  t1.setBool(true);
+  assertTrue(KnxTelegramView(t1.getFrame()).verifyChecksum());
+  assertEquals(0, t1.getFrame()[7] & 0b00111111);
+  uint8_t data = 9;
+  t1.setData(&data);
+  t1.set1ByteIntValue(8);
+  assertTrue(KnxTelegramView(t1.getFrame()).verifyChecksum());
+  assertEquals(8, t1.getFrame()[8]);
+}
+
+int main() {
+  return knxTestRun();
+}
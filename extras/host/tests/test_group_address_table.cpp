@@ -0,0 +1,58 @@
+// File: test_group_address_table.cpp
+// Lookups in the table generated from the example's ETS export.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include "../../examples/GroupAddressNames/GroupAddresses.h"
+#include "KnxTestSupport.h"
+
+test(findAddress) {
+  assertEquals(12, knxGroupAddresses.getCount());
+  int index = knxGroupAddresses.findAddress(GA_OUTDOOR_TEMPERATURE);
+  assertTrue(index != KNX_GROUP_ADDRESS_NOT_FOUND);
+  assertEquals((2 << 11) | 10, knxGroupAddresses.getAddress(index));
+  assertEquals(9, knxGroupAddresses.getDptMain(index));
+  assertEquals(1, knxGroupAddresses.getDptSub(index));
+  assertEquals(0, strcmp("Outdoor temperature", knxGroupAddresses.getName(index)));
+
+  // First, last and missing entries
+  assertEquals(0, knxGroupAddresses.findAddress(GA_ALL_LIGHTS_OFF));
+  assertEquals(11, knxGroupAddresses.findAddress(GA_TIME));
+  assertEquals(KNX_GROUP_ADDRESS_NOT_FOUND, knxGroupAddresses.findAddress(0x0803));
+  assertEquals(KNX_GROUP_ADDRESS_NOT_FOUND, knxGroupAddresses.findAddress(0));
+  assertEquals(KNX_GROUP_ADDRESS_NOT_FOUND, knxGroupAddresses.findAddress(0xFFFF));
+}
+
+test(findName) {
+  for (int i = 0; i < knxGroupAddresses.getCount(); i++) {
+    char name[64];
+    knxGroupAddresses.copyName(i, name, sizeof(name));
+    assertEquals(i, knxGroupAddresses.findName(name));
+  }
+  assertEquals(GA_KITCHEN_LIGHT, knxGroupAddresses.addressOf("Kitchen light"));
+  assertEquals(GA_BATHROOM_COMFORT_SETPOINT, knxGroupAddresses.addressOf("Bathroom \"comfort\" setpoint"));
+  assertEquals(GA_HEATING_VALVE_K_CHE, knxGroupAddresses.addressOf("Heating valve K\xC3\xBC" "che"));
+  assertEquals(0, knxGroupAddresses.addressOf("Kitchen"));
+  assertEquals(0, knxGroupAddresses.addressOf("Kitchen light!"));
+  assertEquals(0, knxGroupAddresses.addressOf(""));
+  assertEquals(0, knxGroupAddresses.addressOf("ZZZ"));
+}
+
+test(copyAndPrintName) {
+  int index = knxGroupAddresses.findAddress(GA_KITCHEN_LIGHT);
+  char name[8];
+  assertEquals(7, knxGroupAddresses.copyName(index, name, sizeof(name)));
+  assertEquals(0, strcmp("Kitchen", name));
+
+  StringPrint out;
+  knxGroupAddresses.printName(&out, GA_KITCHEN_LIGHT);
+  out.print(',');
+  knxGroupAddresses.printName(&out, (4 << 11) | (5 << 8) | 6);
+  assertTrue(out.text == "Kitchen light,4/5/6");
+}
+
+int main() {
+  return knxTestRun();
+}
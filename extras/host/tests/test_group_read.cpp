@@ -0,0 +1,103 @@
+// File: test_group_read.cpp
+// groupReadAsync() request/answer correlation against TpUartSimulator.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include "KnxTestSupport.h"
+
+struct Fixture : KnxTestBus {
+  void answer(int main, int middle, int sub, int value) {
+    injectGroup(KNX_COMMAND_ANSWER, main, middle, sub, value);
+  }
+
+  bool waitWhilePending(KnxReadHandle handle) {
+    return runUntil([&] { return knx.getReadState(handle) != KNX_READ_PENDING; });
+  }
+};
+
+test(answerCompletesRead) {
+  Fixture f;
+  KnxReadHandle handle = f.knx.groupReadAsync("5/6/0");
+  assertTrue(handle >= 0);
+  assertEquals(KNX_READ_PENDING, f.knx.getReadState(handle));
+
+  f.answer(5, 6, 0, 77);
+  assertTrue(f.waitWhilePending(handle));
+  assertEquals(KNX_READ_DONE, f.knx.getReadState(handle));
+
+  KnxTelegram answer;
+  assertTrue(f.knx.getReadAnswer(handle, &answer));
+  assertEquals(77, answer.get1ByteIntValue());
+
+  f.knx.releaseRead(handle);
+  assertEquals(KNX_READ_FREE, f.knx.getReadState(handle));
+}
+
+test(severalReadsInFlight) {
+  Fixture f;
+  KnxReadHandle a = f.knx.groupReadAsync("1/0/1");
+  KnxReadHandle b = f.knx.groupReadAsync("1/0/2");
+  KnxReadHandle c = f.knx.groupReadAsync("1/0/3");
+
+  // Answers in a different order than the requests
+  f.answer(1, 0, 3, 3);
+  f.answer(1, 0, 1, 1);
+  assertTrue(f.waitWhilePending(a));
+  assertTrue(f.waitWhilePending(c));
+  assertEquals(KNX_READ_PENDING, f.knx.getReadState(b));
+
+  KnxTelegram answer;
+  assertTrue(f.knx.getReadAnswer(a, &answer));
+  assertEquals(1, answer.get1ByteIntValue());
+  assertTrue(f.knx.getReadAnswer(c, &answer));
+  assertEquals(3, answer.get1ByteIntValue());
+  assertTrue(!f.knx.getReadAnswer(b, &answer));
+}
+
+test(readTimesOut) {
+  Fixture f;
+  KnxReadHandle handle = f.knx.groupReadAsync("2/2/2", 50);
+  assertTrue(f.waitWhilePending(handle));
+  assertEquals(KNX_READ_TIMEOUT, f.knx.getReadState(handle));
+  f.knx.releaseRead(handle);
+}
+
+test(timeoutStartsWhenSent) {
+  Fixture f;
+  KnxTxQueue queue;
+  f.knx.setTxQueue(&queue);
+  f.knx.setTxInterval(0);
+
+  // Longer in the queue than the timeout
+  KnxReadHandle handle = f.knx.groupReadAsync("2/2/3", 50);
+  delay(100);
+  assertEquals(KNX_READ_PENDING, f.knx.getReadState(handle));
+
+  assertTrue(f.knx.processTxQueue());
+  assertEquals(KNX_READ_PENDING, f.knx.getReadState(handle));
+  f.answer(2, 2, 3, 9);
+  assertTrue(f.waitWhilePending(handle));
+  assertEquals(KNX_READ_DONE, f.knx.getReadState(handle));
+}
+
+test(tableFullAndStaleHandles) {
+  Fixture f;
+  KnxReadHandle handles[MAX_PENDING_GROUP_READS];
+  for (int i = 0; i < MAX_PENDING_GROUP_READS; i++) {
+    handles[i] = f.knx.groupReadAsync("3/0/" + String(i));
+    assertTrue(handles[i] >= 0);
+  }
+  assertTrue(f.knx.groupReadAsync("3/0/9") < 0);
+
+  f.knx.releaseRead(handles[0]);
+  KnxReadHandle reused = f.knx.groupReadAsync("3/0/9");
+  assertTrue(reused >= 0);
+  assertTrue(reused != handles[0]);
+  assertEquals(KNX_READ_FREE, f.knx.getReadState(handles[0]));
+}
+
+int main() {
+  return knxTestRun();
+}
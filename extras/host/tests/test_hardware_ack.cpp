@@ -0,0 +1,87 @@
+// File: test_hardware_ack.cpp
+// TP-UART2 hardware acknowledge and the software fallback on TP-UART.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include "KnxTestSupport.h"
+
+struct Fixture : KnxTestBus {
+  Fixture(bool tpuart2) {
+    sim.setTpUart2(tpuart2);
+    knx.addListenGroupAddress("1/2/3");
+  }
+
+  void injectTo(int area, int line, int member) {
+    KnxTelegram tg;
+    tg.setSourceAddress(1, 1, 20);
+    tg.setTargetIndividualAddress(area, line, member);
+    tg.setCommand(KNX_COMMAND_MASK_VERSION_READ);
+    tg.createChecksum();
+    inject(&tg);
+  }
+
+  bool waitFor(int count) {
+    bool done = runUntil([&] { return telegrams >= count; });
+    // Give the last ack byte time to cross the pty
+    delay(20);
+    return done;
+  }
+
+  bool waitForAddress() {
+    return runUntil([&] { return sim.getAddress() >= 0; });
+  }
+};
+
+test(tpuartFallsBackToSoftwareAck) {
+  Fixture f(false);
+  assertTrue(!f.knx.uartEnableHardwareAck());
+  assertTrue(!f.knx.hasHardwareAck());
+  assertEquals(-1, f.knx.getProductId());
+
+  f.injectTo(1, 1, 199);
+  assertTrue(f.waitFor(1));
+  assertEquals(1u, f.sim.getAckBytes().size());
+  assertEquals(0b00010001, f.sim.getAckBytes()[0]);
+  assertEquals(0, f.sim.getHardwareAckCount());
+}
+
+test(tpuart2AcknowledgesOwnAddress) {
+  Fixture f(true);
+  assertTrue(f.knx.uartEnableHardwareAck());
+  assertEquals(SIM_TPUART2_PRODUCT_ID, f.knx.getProductId());
+  assertTrue(f.waitForAddress());
+  assertEquals(0x11C7, f.sim.getAddress());
+  // Not taken for the dummy byte of U_SetAddress
+  f.waitUntil([&] { return f.sim.getConfiguration() >= 0; });
+  assertEquals(TPUART2_CONFIGURE_FLAGS, f.sim.getConfiguration());
+
+  // Individual frames are left to the chip, groups still need the host
+  f.injectTo(1, 1, 199);
+  f.injectTo(1, 1, 198);
+  f.injectGroup(KNX_COMMAND_WRITE, 1, 2, 3, 1);
+  assertTrue(f.waitFor(2));
+  assertEquals(1, f.sim.getHardwareAckCount());
+  assertEquals(1u, f.sim.getAckBytes().size());
+  assertEquals(0b00010001, f.sim.getAckBytes()[0]);
+}
+
+test(addressRestoredAfterReset) {
+  Fixture f(true);
+  assertTrue(f.knx.uartEnableHardwareAck());
+  assertTrue(f.waitForAddress());
+
+  f.knx.uartReset();
+  assertTrue(f.waitUntil([&] { return f.sim.getResetRequestCount() > 0; }));
+  assertTrue(f.waitForAddress());
+  assertEquals(0x11C7, f.sim.getAddress());
+
+  f.knx.setIndividualAddress(1, 1, 50);
+  f.waitUntil([&] { return f.sim.getAddress() == 0x1132; });
+  assertEquals(0x1132, f.sim.getAddress());
+}
+
+int main() {
+  return knxTestRun();
+}
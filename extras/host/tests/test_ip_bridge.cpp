@@ -0,0 +1,254 @@
+// File: test_ip_bridge.cpp
+// cEMI conversion and the KNXnet/IP bridge over loopback UDP.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "KnxIpBridge.h"
+#include "KnxTestSupport.h"
+
+static void groupWrite(KnxTelegram* tg, int sub, int value) {
+  tg->clear();
+  tg->setSourceAddress(1, 1, 20);
+  tg->setTargetGroupAddress(1, 2, sub);
+  tg->setCommand(KNX_COMMAND_WRITE);
+  tg->set1ByteIntValue(value);
+  tg->createChecksum();
+}
+
+struct Client {
+  int fd;
+
+  Client() {
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    struct sockaddr_in local = address(0);
+    bind(fd, (struct sockaddr*) &local, sizeof(local));
+  }
+
+  ~Client() {
+    close(fd);
+  }
+
+  static struct sockaddr_in address(int port) {
+    struct sockaddr_in a;
+    memset(&a, 0, sizeof(a));
+    a.sin_family = AF_INET;
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    a.sin_port = htons(port);
+    return a;
+  }
+
+  int port() {
+    struct sockaddr_in local;
+    socklen_t length = sizeof(local);
+    getsockname(fd, (struct sockaddr*) &local, &length);
+    return ntohs(local.sin_port);
+  }
+
+  void send(int port, uint16_t service, const uint8_t* body, int length) {
+    uint8_t packet[KNX_IP_MAX_PACKET];
+    packet[0] = 0x06;
+    packet[1] = 0x10;
+    packet[2] = service >> 8;
+    packet[3] = service & 0xFF;
+    packet[4] = (length + 6) >> 8;
+    packet[5] = (length + 6) & 0xFF;
+    memcpy(packet + 6, body, length);
+    struct sockaddr_in to = address(port);
+    sendto(fd, packet, length + 6, 0, (struct sockaddr*) &to, sizeof(to));
+  }
+
+  std::vector<uint8_t> receive() {
+    uint8_t packet[256];
+    int length = recv(fd, packet, sizeof(packet), 0);
+    if (length < 0) {
+      return std::vector<uint8_t>();
+    }
+    return std::vector<uint8_t>(packet, packet + length);
+  }
+};
+
+struct Fixture : KnxTestBus {
+  KnxTxQueue queue;
+  Client routing;
+  Client tunnel;
+  KnxIpBridge bridge;
+
+  Fixture() : KnxTestBus("1.1.250"), bridge(&knx, &queue) {
+    knx.setTxQueue(&queue);
+    knx.setTxInterval(0);
+    bridge.beginRouting("127.0.0.1", routing.port(), 0);
+    bridge.beginTunnelling(0);
+    bridge.attach(&loop);
+  }
+
+  // Runs the loop until client has a packet of the service
+  std::vector<uint8_t> waitFor(Client* client, uint16_t service) {
+    std::vector<uint8_t> packet;
+    bool found = runUntil([&] {
+      // Packets of other services are skipped
+      while (!(packet = client->receive()).empty()) {
+        if (packet.size() >= 6 && ((packet[2] << 8) | packet[3]) == service) {
+          return true;
+        }
+      }
+      return false;
+    }, 1000, 5);
+    return found ? packet : std::vector<uint8_t>();
+  }
+
+  int connect() {
+    uint8_t body[20] = { 8, 1, 0, 0, 0, 0, 0, 0, 8, 1, 0, 0, 0, 0, 0, 0, 4, 4, 2, 0 };
+    tunnel.send(bridge.getTunnellingPort(), 0x0205, body, sizeof(body));
+    std::vector<uint8_t> response = waitFor(&tunnel, 0x0206);
+    return response.size() >= 8 && response[7] == 0 ? response[6] : -1;
+  }
+};
+
+test(cemiRoundTrip) {
+  KnxTelegram tg;
+  groupWrite(&tg, 3, 0x42);
+  tg.setPriority(KNX_PRIORITY_ALARM);
+  tg.createChecksum();
+
+  uint8_t cemi[KNX_CEMI_MAX_SIZE];
+  int length = knxFrameToCemi(tg.getBuffer(), KNX_CEMI_LDATA_IND, cemi, sizeof(cemi));
+  assertEquals(KNX_CEMI_HEADER_SIZE + 2, length);
+  assertEquals(KNX_CEMI_LDATA_IND, cemi[0]);
+  assertEquals(0, cemi[1]);
+  assertEquals(0xB8, cemi[2]);
+  assertEquals(0xE0, cemi[3]);
+  assertEquals(0x11, cemi[4]);
+  assertEquals(20, cemi[5]);
+  assertEquals(0x0A, cemi[6]);
+  assertEquals(0x03, cemi[7]);
+  assertEquals(2, cemi[8]);
+  assertEquals(0x42, cemi[11]);
+  assertEquals(0, knxFrameToCemi(tg.getBuffer(), KNX_CEMI_LDATA_IND, cemi, length - 1));
+
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  assertEquals(tg.getTotalLength(), knxCemiToFrame(cemi, length, frame));
+  assertEquals(0, memcmp(tg.getBuffer(), frame, tg.getTotalLength()));
+
+  // Additional info is skipped, other message codes are refused
+  uint8_t withInfo[KNX_CEMI_MAX_SIZE + 3] = { KNX_CEMI_LDATA_REQ, 3, 0x03, 0x01, 0x00 };
+  memcpy(withInfo + 5, cemi + 2, length - 2);
+  assertEquals(tg.getTotalLength(), knxCemiToFrame(withInfo, length + 3, frame));
+  assertEquals(0x42, frame[8]);
+  cemi[0] = 0xFC;
+  assertEquals(0, knxCemiToFrame(cemi, length, frame));
+}
+
+test(routing) {
+  Fixture f;
+  KnxTelegram tg;
+
+  // Bus to IP
+  groupWrite(&tg, 3, 7);
+  f.sim.inject(tg.getBuffer(), tg.getTotalLength());
+  std::vector<uint8_t> packet = f.waitFor(&f.routing, 0x0530);
+  assertEquals(6u + 12u, packet.size());
+  assertEquals(KNX_CEMI_LDATA_IND, packet[6]);
+  assertEquals(7, packet[17]);
+
+  // IP to bus
+  uint8_t cemi[KNX_CEMI_MAX_SIZE];
+  groupWrite(&tg, 4, 9);
+  int length = knxFrameToCemi(tg.getBuffer(), KNX_CEMI_LDATA_IND, cemi, sizeof(cemi));
+  f.routing.send(f.bridge.getRoutingPort(), 0x0530, cemi, length);
+  f.runUntil([&] { return !f.sim.getSentFrames().empty(); }, 1000, 5);
+  std::vector<std::vector<uint8_t> > sent = f.sim.getSentFrames();
+  assertEquals(1u, sent.size());
+  assertEquals(0, memcmp(tg.getBuffer(), &sent[0][0], tg.getTotalLength()));
+  assertEquals(1ul, f.bridge.getStats().confirmed);
+}
+
+test(routingFlowControl) {
+  Fixture f;
+  KnxTelegram tg;
+  uint8_t cemi[KNX_CEMI_MAX_SIZE];
+  for (int i = 0; i < 20; i++) {
+    groupWrite(&tg, 5, i);
+    int length = knxFrameToCemi(tg.getBuffer(), KNX_CEMI_LDATA_IND, cemi, sizeof(cemi));
+    f.routing.send(f.bridge.getRoutingPort(), 0x0530, cemi, length);
+  }
+
+  std::vector<uint8_t> busy = f.waitFor(&f.routing, 0x0532);
+  assertEquals(12u, busy.size());
+  assertEquals(KNX_IP_BUSY_WAIT_MS, (busy[8] << 8) | busy[9]);
+  std::vector<uint8_t> lost = f.waitFor(&f.routing, 0x0531);
+  assertEquals(10u, lost.size());
+  KnxIpStats stats = f.bridge.getStats();
+  assertEquals(20ul, stats.ipToBus + stats.routingLost);
+  assertEquals(stats.routingLost, (unsigned long) ((lost[8] << 8) | lost[9]));
+  assertTrue(stats.routingLost > 0);
+}
+
+test(tunnelling) {
+  Fixture f;
+  int channel = f.connect();
+  assertEquals(1, channel);
+  assertEquals(1, f.bridge.getTunnelCount());
+
+  // L_Data.req without source: sent with the tunnel address
+  KnxTelegram tg;
+  groupWrite(&tg, 6, 1);
+  uint8_t body[4 + KNX_CEMI_MAX_SIZE] = { 4, (uint8_t) channel, 0, 0 };
+  int length = knxFrameToCemi(tg.getBuffer(), KNX_CEMI_LDATA_REQ, body + 4, KNX_CEMI_MAX_SIZE);
+  body[4 + 4] = 0;
+  body[4 + 5] = 0;
+  f.tunnel.send(f.bridge.getTunnellingPort(), 0x0420, body, 4 + length);
+
+  std::vector<uint8_t> ack = f.waitFor(&f.tunnel, 0x0421);
+  assertEquals(10u, ack.size());
+  assertEquals(0, ack[8]);
+  assertEquals(0, ack[9]);
+
+  std::vector<uint8_t> con = f.waitFor(&f.tunnel, 0x0420);
+  assertEquals(KNX_CEMI_LDATA_CON, con[10]);
+  assertEquals(0, con[12] & KNX_CEMI_CONFIRM_ERROR);
+  assertEquals(0x11, con[14]);
+  assertEquals(251, con[15]);
+  uint8_t conAck[4] = { 4, (uint8_t) channel, con[8], 0 };
+  f.tunnel.send(f.bridge.getTunnellingPort(), 0x0421, conAck, sizeof(conAck));
+  std::vector<std::vector<uint8_t> > sent = f.sim.getSentFrames();
+  assertEquals(1u, sent.size());
+  assertEquals(251, sent[0][2]);
+
+  // The routing side saw the frame on the bus
+  std::vector<uint8_t> indication = f.waitFor(&f.routing, 0x0530);
+  assertEquals(251, indication[11]);
+
+  // Bus frames follow with the next sequence number
+  groupWrite(&tg, 7, 2);
+  f.sim.inject(tg.getBuffer(), tg.getTotalLength());
+  std::vector<uint8_t> ind = f.waitFor(&f.tunnel, 0x0420);
+  assertEquals(1, ind[8]);
+  assertEquals(KNX_CEMI_LDATA_IND, ind[10]);
+
+  // A repeated request is acknowledged again but not sent twice
+  f.tunnel.send(f.bridge.getTunnellingPort(), 0x0420, body, 4 + length);
+  ack = f.waitFor(&f.tunnel, 0x0421);
+  assertEquals(0, ack[8]);
+  assertEquals(1u, f.sim.getSentFrames().size());
+
+  uint8_t disconnect[10] = { (uint8_t) channel, 0, 8, 1, 0, 0, 0, 0, 0, 0 };
+  f.tunnel.send(f.bridge.getTunnellingPort(), 0x0209, disconnect, sizeof(disconnect));
+  std::vector<uint8_t> response = f.waitFor(&f.tunnel, 0x020A);
+  assertEquals(0, response[7]);
+  assertEquals(0, f.bridge.getTunnelCount());
+}
+
+int main() {
+  return knxTestRun();
+}
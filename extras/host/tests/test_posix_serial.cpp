@@ -0,0 +1,160 @@
+// File: test_posix_serial.cpp
+// End-to-end tests of KnxTpUart over a pty pair against TpUartSimulator.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include <pty.h>
+#include <unistd.h>
+
+#include "KnxTestSupport.h"
+
+struct Fixture : KnxTestBus {
+  bool waitForEvents(int count) {
+    return runUntil([&] { return events >= count; }, 1000, 50);
+  }
+
+  // The simulator thread sees our acknowledge a moment later
+  bool waitForAcks(int count) {
+    return waitUntil([&] { return (int) sim.getAckBytes().size() >= count; });
+  }
+};
+
+static int buildGroupWrite(uint8_t* frame, int main, int middle, int sub, bool value) {
+  KnxTelegram tg;
+  tg.setSourceAddress(1, 1, 5);
+  tg.setTargetGroupAddress(main, middle, sub);
+  tg.setCommand(KNX_COMMAND_WRITE);
+  tg.setFirstDataByte(value ? 1 : 0);
+  tg.createChecksum();
+  for (int i = 0; i < tg.getTotalLength(); i++) {
+    frame[i] = tg.getBufferByte(i);
+  }
+  return tg.getTotalLength();
+}
+
+test(resetIndication) {
+  Fixture f;
+  f.knx.uartReset();
+  assertTrue(f.waitForEvents(1));
+  assertEquals(TPUART_RESET_INDICATION, f.lastEvent);
+  assertEquals(1, f.sim.getResetRequestCount());
+}
+
+test(receiveAddressedGroupWrite) {
+  Fixture f;
+  f.knx.addListenGroupAddress("2/6/0");
+
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  int length = buildGroupWrite(frame, 2, 6, 0, true);
+  f.sim.inject(frame, length);
+
+  assertTrue(f.waitForEvents(1));
+  assertEquals(KNX_TELEGRAM, f.lastEvent);
+  assertTrue(f.knx.getReceivedTelegram()->getBool());
+  assertTrue(f.waitForAcks(1));
+  assertEquals(1, (int) f.sim.getAckBytes().size());
+  assertEquals(0b00010001, f.sim.getAckBytes()[0]);
+}
+
+test(receiveForeignGroupWrite) {
+  Fixture f;
+  f.knx.addListenGroupAddress("2/6/0");
+
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  int length = buildGroupWrite(frame, 3, 1, 1, true);
+  f.sim.inject(frame, length);
+
+  assertTrue(f.waitForEvents(1));
+  assertEquals(IRRELEVANT_KNX_TELEGRAM, f.lastEvent);
+  assertTrue(f.waitForAcks(1));
+  assertEquals(0b00010000, f.sim.getAckBytes()[0]);
+}
+
+test(groupWriteIsConfirmed) {
+  Fixture f;
+  assertTrue(f.knx.groupWrite2ByteInt("5/6/7", 0x1234));
+
+  std::vector<std::vector<uint8_t> > sent = f.sim.getSentFrames();
+  assertEquals(1, (int) sent.size());
+
+  KnxTelegram tg;
+  for (size_t i = 0; i < sent[0].size(); i++) {
+    tg.setBufferByte(i, sent[0][i]);
+  }
+  assertTrue(tg.verifyChecksum());
+  assertEquals(5, tg.getTargetMainGroup());
+  assertEquals(6, tg.getTargetMiddleGroup());
+  assertEquals(7, tg.getTargetSubGroup());
+  assertEquals(0x1234, tg.get2ByteIntValue());
+}
+
+test(groupWriteNegativeConfirmation) {
+  Fixture f;
+  f.sim.setConfirmSuccess(false);
+  assertTrue(!f.knx.groupWriteBool("5/6/7", true));
+}
+
+test(frameBeforeConfirmationIsReported) {
+  Fixture f;
+  f.knx.addListenGroupAddress("2/6/0");
+
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  int length = buildGroupWrite(frame, 2, 6, 0, true);
+  f.sim.injectBeforeConfirmation(frame, length);
+  assertTrue(f.knx.groupWriteBool("5/6/7", false));
+
+  // Acknowledged during the send, reported afterwards
+  assertTrue(f.knx.hasDeferredFrames());
+  assertTrue(f.waitForAcks(1));
+  assertEquals(0b00010001, f.sim.getAckBytes()[0]);
+  assertTrue(f.waitForEvents(1));
+  assertEquals(KNX_TELEGRAM, f.lastEvent);
+  assertEquals(2, f.knx.getReceivedTelegram()->getTargetMainGroup());
+  assertTrue(f.knx.getReceivedTelegram()->getBool());
+  assertTrue(!f.knx.hasDeferredFrames());
+  assertEquals(1, (int) f.sim.getSentFrames().size());
+}
+
+test(queuedWriteIsDrainedByLoop) {
+  Fixture f;
+  KnxTxQueue queue;
+  f.knx.setTxQueue(&queue);
+  f.knx.setTxInterval(0);
+
+  assertTrue(f.knx.groupWriteBool("1/0/1", true));
+  assertTrue(f.knx.groupWriteBool("1/0/2", false));
+  assertEquals(2, queue.size());
+
+  f.loop.runOnce(0);
+  assertTrue(queue.isEmpty());
+  assertEquals(2, (int) f.sim.getSentFrames().size());
+}
+
+test(idleLoopSleeps) {
+  Fixture f;
+  unsigned long start = millis();
+  assertEquals(0, f.loop.runOnce(100));
+  assertTrue(millis() - start >= 90);
+}
+
+test(hangupFailsLoop) {
+  int master;
+  int slave;
+  assertTrue(openpty(&master, &slave, NULL, NULL, NULL) == 0);
+  PosixSerial serial;
+  serial.attach(slave);
+  KnxTpUart knx(&serial, "1.1.199");
+  KnxEventLoop loop;
+  loop.add(&serial, &knx, NULL);
+
+  // Like an unplugged USB adapter
+  close(master);
+  assertEquals(-1, loop.runOnce(100));
+  assertEquals(-1, serial.fill());
+}
+
+int main() {
+  return knxTestRun();
+}
@@ -0,0 +1,200 @@
+// File: test_reset_recovery.cpp
+// Recovery after a TP-UART reset indication: chip configuration, replay of
+// unconfirmed frames by priority, limits and the state re-sync.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include <vector>
+
+#include "KnxStateSync.h"
+#include "KnxTestSupport.h"
+
+static void groupWrite(KnxTelegram* tg, int sub, int value, KnxPriorityType priority) {
+  tg->clear();
+  tg->setSourceAddress(1, 1, 199);
+  tg->setTargetGroupAddress(1, 2, sub);
+  tg->setCommand(KNX_COMMAND_WRITE);
+  tg->set1ByteIntValue(value);
+  tg->setPriority(priority);
+  tg->createChecksum();
+}
+
+struct Fixture : KnxTestBus {
+  KnxTxQueue queue;
+  KnxResetRecovery recovery;
+
+  Fixture(bool tpuart2 = false) {
+    sim.setTpUart2(tpuart2);
+    knx.setTxQueue(&queue);
+    knx.setTxInterval(0);
+    knx.setResetRecovery(&recovery);
+  }
+
+  bool runUntilReset(int count) {
+    return runUntil([&] { return resets >= count; });
+  }
+
+  bool runUntilSent(size_t count) {
+    return runUntil([&] { return sim.getSentFrames().size() >= count; });
+  }
+};
+
+test(chipConfiguredAgain) {
+  Fixture f(true);
+  assertTrue(f.knx.uartEnableHardwareAck());
+  delay(20);
+  assertEquals(0x11C7, f.sim.getAddress());
+
+  f.sim.powerFail();
+  assertTrue(f.runUntilReset(1));
+  delay(20);
+  assertEquals(0x11C7, f.sim.getAddress());
+
+  // Busmonitor mode is entered again as well
+  f.knx.uartActivateBusmonitor();
+  delay(20);
+  assertTrue(f.sim.isBusmonitor());
+  f.sim.powerFail();
+  assertTrue(f.runUntilReset(2));
+  delay(20);
+  assertTrue(f.sim.isBusmonitor());
+  assertEquals(KNX_MODE_BUSMONITOR, f.knx.getMode());
+}
+
+test(unconfirmedFramesReplayedByPriority) {
+  Fixture f;
+  KnxTelegram tg;
+  groupWrite(&tg, 3, 1, KNX_PRIORITY_NORMAL);
+  f.queue.push(&tg);
+  groupWrite(&tg, 4, 2, KNX_PRIORITY_ALARM);
+  f.queue.push(&tg);
+  groupWrite(&tg, 5, 3, KNX_PRIORITY_NORMAL);
+  f.queue.push(&tg);
+
+  // Both of the first frames vanish, the third waits in the queue
+  f.sim.powerFail(2);
+  assertTrue(f.runUntilReset(1));
+  f.runUntilSent(3);
+
+  std::vector<std::vector<uint8_t> > sent = f.sim.getSentFrames();
+  assertEquals(3u, sent.size());
+  assertEquals(2, sent[0][8]);  // Alarm first
+  assertEquals(1, sent[1][8]);
+  assertEquals(3, sent[2][8]);  // Then the queue goes on
+
+  KnxRecoveryStats stats = f.recovery.getStats();
+  assertEquals(1ul, stats.resets);
+  assertEquals(2ul, stats.replayed);
+  assertEquals(0ul, stats.lost);
+  assertTrue(stats.lastRecoveryUs > 0);
+  assertEquals(stats.lastRecoveryUs, stats.maxRecoveryUs);
+  assertEquals(0, f.recovery.getCount());
+}
+
+struct Retry {
+  KnxTxQueue* queue;
+  std::vector<bool> reports;
+};
+
+static void retryOnce(const uint8_t* frame, int length, bool confirmed, void* context) {
+  Retry* retry = (Retry*) context;
+  retry->reports.push_back(confirmed);
+  if (!confirmed && retry->reports.size() == 1) {
+    retry->queue->push(frame, length);
+  }
+}
+
+test(replayReportedOnce) {
+  Fixture f;
+  Retry retry;
+  retry.queue = &f.queue;
+  f.knx.setTxConfirmHandler(retryOnce, &retry);
+  KnxTelegram tg;
+  groupWrite(&tg, 3, 1, KNX_PRIORITY_NORMAL);
+  f.queue.push(&tg);
+
+  // The frame and its retry vanish, then the chip resets
+  f.sim.powerFail(2);
+  assertTrue(f.runUntilReset(1));
+  f.runUntilSent(1);
+  f.settle(50);
+
+  // Replayed once, and only the two attempts of the caller are reported
+  assertEquals(1u, f.sim.getSentFrames().size());
+  assertEquals(2u, retry.reports.size());
+  assertTrue(!retry.reports[0]);
+  assertTrue(!retry.reports[1]);
+  assertEquals(1ul, f.recovery.getStats().replayed);
+  assertEquals(0, f.recovery.getCount());
+}
+
+test(stateSyncRestarted) {
+  Fixture f;
+  f.sim.setAnswerReads(true);
+  static const char* const addresses[] = {"1/2/3", "1/2/4"};
+  uint8_t status[2];
+  KnxStateSync sync(&f.knx);
+  sync.begin(addresses, status, 2);
+  f.recovery.setStateSync(&sync);
+  f.runUntil([&] { sync.poll(); return sync.isComplete(); });
+  assertEquals(2, sync.getAnsweredCount());
+
+  f.sim.powerFail();
+  assertTrue(f.runUntilReset(1));
+  assertTrue(!sync.isComplete());
+  f.runUntil([&] { sync.poll(); return sync.isComplete(); });
+  assertEquals(2, sync.getAnsweredCount());
+}
+
+test(limits) {
+  hostClockSetVirtual(true);
+  KnxResetRecovery recovery;
+  KnxTelegram tg;
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  int length;
+
+  // Full: the oldest frame makes room
+  for (int i = 0; i <= MAX_RECOVERY_FRAMES; i++) {
+    groupWrite(&tg, 3, i, KNX_PRIORITY_NORMAL);
+    recovery.remember(tg.getBuffer(), tg.getTotalLength());
+    hostClockAdvance(10000);
+  }
+  assertEquals(MAX_RECOVERY_FRAMES, recovery.getCount());
+  assertEquals(1ul, recovery.getStats().lost);
+
+  // Outside the window when the reset comes, the margins keep the
+  // millis() rounding out of it
+  hostClockAdvance(RECOVERY_WINDOW_MS * 1000UL - 25000);
+  recovery.begin();
+  assertTrue(recovery.next(frame, &length));
+  assertEquals(MAX_RECOVERY_FRAMES - 1, frame[8]);
+  assertTrue(recovery.next(frame, &length));
+  assertEquals(MAX_RECOVERY_FRAMES, frame[8]);
+  assertTrue(!recovery.next(frame, &length));
+  recovery.end();
+  assertEquals(1ul + MAX_RECOVERY_FRAMES - 2, recovery.getStats().lost);
+
+  // Over the time budget, the rest is given up
+  recovery.resetStats();
+  for (int i = 0; i < 3; i++) {
+    groupWrite(&tg, 3, i, KNX_PRIORITY_NORMAL);
+    recovery.remember(tg.getBuffer(), tg.getTotalLength());
+  }
+  recovery.begin();
+  assertTrue(recovery.next(frame, &length));
+  recovery.replayed(true);
+  hostClockAdvance((RECOVERY_BUDGET_MS + 1) * 1000UL);
+  assertTrue(!recovery.next(frame, &length));
+  recovery.end();
+  KnxRecoveryStats stats = recovery.getStats();
+  assertEquals(1ul, stats.replayed);
+  assertEquals(2ul, stats.lost);
+  assertEquals(0, recovery.getCount());
+  hostClockSetVirtual(false);
+}
+
+int main() {
+  return knxTestRun();
+}
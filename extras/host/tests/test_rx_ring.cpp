@@ -0,0 +1,192 @@
+// File: test_rx_ring.cpp
+// The receive ring between the UART interrupt and the parser: frames
+// delimited by the inter-byte gap, overflow counting and the indices
+// wrapping around the end of the ring.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include "KnxTestSupport.h"
+#include "KnxTpUart.h"
+
+// A character on the bus, 11 bits at 9600 baud plus the inter-byte time
+#define BYTE_US 1300UL
+
+// Pushes a group write to 1/2/sub as the interrupt would, one byte every
+// BYTE_US starting at *t. Returns the number of bytes.
+static int pushTelegram(KnxRxRing* ring, int sub, int value, unsigned long* t) {
+  KnxTelegram tg;
+  tg.setSourceAddress(1, 1, 20);
+  tg.setTargetGroupAddress(1, 2, sub);
+  tg.setCommand(KNX_COMMAND_WRITE);
+  tg.setFirstDataByte(value);
+  tg.createChecksum();
+
+  for (int i = 0; i < tg.getTotalLength(); i++) {
+    ring->push(tg.getBufferByte(i), *t);
+    *t += BYTE_US;
+  }
+  return tg.getTotalLength();
+}
+
+test(readStopsAtGap) {
+  KnxRxRing ring;
+  ring.push(0x01, 1000);
+  ring.push(0x02, 1000 + BYTE_US);
+  ring.push(0x03, 1000 + 2 * BYTE_US);
+  ring.push(0x04, 1000 + 2 * BYTE_US + TPUART_RX_FRAME_GAP_US + 1);
+
+  uint8_t buffer[8];
+  assertEquals(1, ring.read(buffer, 1));
+  assertEquals(2, ring.read(buffer, 8, TPUART_RX_FRAME_GAP_US));
+  assertEquals(0x03, buffer[1]);
+  assertEquals(1000 + 2 * BYTE_US, ring.getLastTimestamp());
+
+  // The late byte stays for whoever starts the next frame
+  assertEquals(0, ring.read(buffer, 8, TPUART_RX_FRAME_GAP_US));
+  assertEquals(1, ring.available());
+  assertEquals(0x04, ring.read());
+}
+
+test(gapEndsFrameEarly) {
+  NullStream out;
+  KnxRxRing ring;
+  KnxTpUart knx(&out, "1.1.1");
+  knx.setRxRing(&ring);
+  knx.addListenGroupAddress("1/2/3");
+
+  KnxTelegram tg;
+  tg.setSourceAddress(1, 1, 20);
+  tg.setTargetGroupAddress(1, 2, 3);
+  tg.setCommand(KNX_COMMAND_WRITE);
+  tg.setFirstDataByte(7);
+  tg.createChecksum();
+
+  // The sender stops after four bytes, the next frame follows the gap
+  unsigned long t = 5000;
+  for (int i = 0; i < 4; i++) {
+    ring.push(tg.getBufferByte(i), t);
+    t += BYTE_US;
+  }
+  t += TPUART_RX_FRAME_GAP_US;
+  unsigned long start = t;
+  int length = pushTelegram(&ring, 3, 9, &t);
+
+  assertEquals(IRRELEVANT_KNX_TELEGRAM, knx.serialEvent());
+  assertEquals(length, ring.available());
+
+  assertEquals(KNX_TELEGRAM, knx.serialEvent());
+  KnxTelegram* received = knx.getReceivedTelegram();
+  assertEquals(9, received->getFirstDataByte());
+  assertEquals(start, received->getStartTime());
+  assertEquals(0, ring.available());
+}
+
+test(overflowCountsDroppedBytes) {
+  KnxRxRing ring;
+  for (int i = 0; i < TPUART_RX_RING_SIZE + 5; i++) {
+    ring.push(i, i * BYTE_US);
+  }
+
+  // One slot stays free to tell a full ring from an empty one
+  assertEquals(TPUART_RX_RING_SIZE - 1, ring.available());
+  assertEquals(6UL, ring.getOverflowCount());
+
+  // The oldest bytes are kept, the newest dropped
+  assertEquals(0, ring.read());
+  ring.push(0xAA, 0);
+  assertEquals(6UL, ring.getOverflowCount());
+  ring.push(0xBB, 0);
+  assertEquals(7UL, ring.getOverflowCount());
+}
+
+test(readerFallingBehind) {
+  NullStream out;
+  KnxRxRing ring;
+  KnxTpUart knx(&out, "1.1.1");
+  knx.setRxRing(&ring);
+  knx.addListenGroupAddress("1/2/3");
+
+  // More frames than fit, the parser does not run in between
+  unsigned long t = 1000;
+  int pushed = 0;
+  int frames = 0;
+  while (pushed < TPUART_RX_RING_SIZE) {
+    pushed += pushTelegram(&ring, 3, frames++, &t);
+  }
+  unsigned long dropped = pushed - (TPUART_RX_RING_SIZE - 1);
+  assertEquals(dropped, ring.getOverflowCount());
+
+  // The frames that fit completely are received in order
+  int length = pushed / frames;
+  int complete = (TPUART_RX_RING_SIZE - 1) / length;
+  for (int i = 0; i < complete; i++) {
+    assertEquals(KNX_TELEGRAM, knx.serialEvent());
+    assertEquals(i, knx.getReceivedTelegram()->getFirstDataByte());
+  }
+
+  // The cut off frame is dropped once the next one is in after a gap
+  t += TPUART_RX_FRAME_GAP_US;
+  pushTelegram(&ring, 3, 42, &t);
+  assertEquals(IRRELEVANT_KNX_TELEGRAM, knx.serialEvent());
+  assertEquals(KNX_TELEGRAM, knx.serialEvent());
+  assertEquals(42, knx.getReceivedTelegram()->getFirstDataByte());
+  assertEquals(0, ring.available());
+  assertEquals(dropped, ring.getOverflowCount());
+}
+
+test(readWrapsAround) {
+  KnxRxRing ring;
+  uint8_t buffer[TPUART_RX_RING_SIZE];
+
+  // Moves both indices close to the end of the ring
+  for (int i = 0; i < TPUART_RX_RING_SIZE - 10; i++) {
+    ring.push(0, i * BYTE_US);
+  }
+  assertEquals(TPUART_RX_RING_SIZE - 10, ring.read(buffer, TPUART_RX_RING_SIZE));
+
+  // 20 bytes across the end, one read with the gap check
+  unsigned long t = ring.getLastTimestamp();
+  for (int i = 0; i < 20; i++) {
+    t += BYTE_US;
+    ring.push(i, t);
+  }
+  assertEquals(20, ring.available());
+  assertEquals(20, ring.read(buffer, TPUART_RX_RING_SIZE, TPUART_RX_FRAME_GAP_US));
+  for (int i = 0; i < 20; i++) {
+    assertEquals(i, buffer[i]);
+  }
+  assertEquals(t, ring.getLastTimestamp());
+  assertEquals(0, ring.available());
+  assertEquals(-1, ring.peek());
+  assertEquals(0UL, ring.getOverflowCount());
+}
+
+test(telegramsAcrossWraparound) {
+  NullStream out;
+  KnxRxRing ring;
+  KnxTpUart knx(&out, "1.1.1");
+  knx.setRxRing(&ring);
+  knx.addListenGroupAddress("1/2/3");
+
+  // Several times around the ring, frames land across the end
+  unsigned long t = 1000;
+  int bytes = 0;
+  for (int i = 0; bytes < 3 * TPUART_RX_RING_SIZE; i++) {
+    t += TPUART_RX_FRAME_GAP_US;
+    unsigned long start = t;
+    bytes += pushTelegram(&ring, 3, i & 0x3F, &t);
+
+    assertEquals(KNX_TELEGRAM, knx.serialEvent());
+    KnxTelegram* received = knx.getReceivedTelegram();
+    assertEquals(i & 0x3F, received->getFirstDataByte());
+    assertEquals(start, received->getStartTime());
+    assertEquals(0, ring.available());
+  }
+  assertEquals(0UL, ring.getOverflowCount());
+}
+
+int main() {
+  return knxTestRun();
+}
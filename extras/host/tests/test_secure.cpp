@@ -0,0 +1,307 @@
+// File: test_secure.cpp
+// AES, KNX Data Secure CCM, replay protection and the sequence state.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include <vector>
+
+#include "KnxConfig.h"
+#include "KnxTestSupport.h"
+
+static const uint8_t groupKey[16] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+
+static void groupWrite(KnxTelegram* tg, int member, int sub, int value) {
+  tg->clear();
+  tg->setSourceAddress(1, 1, member);
+  tg->setTargetGroupAddress(1, 2, sub);
+  tg->setCommand(KNX_COMMAND_WRITE);
+  tg->set1ByteIntValue(value);
+  tg->createChecksum();
+}
+
+static bool checksumValid(const uint8_t* frame, int length) {
+  uint8_t checksum = 0xFF;
+  for (int i = 0; i < length - 1; i++) {
+    checksum ^= frame[i];
+  }
+  return checksum == frame[length - 1];
+}
+
+static std::vector<uint64_t> storedSequences;
+
+static void storeSequence(uint64_t sequence, void*) {
+  storedSequences.push_back(sequence);
+}
+
+// Sender 1.1.20 and receiver sharing the key of 1/2/3 (confidential) and
+// 1/2/4 (authentication only)
+struct Pair {
+  KnxSecure sender;
+  KnxSecure receiver;
+
+  Pair() {
+    sender.addGroupAddress(0x0A03, sender.addKey(groupKey));
+    sender.addGroupAddress(0x0A04, 0, false);
+    receiver.addGroupAddress(0x0A03, receiver.addKey(groupKey));
+    receiver.addGroupAddress(0x0A04, 0, false);
+    receiver.addSource(0x1114);
+  }
+};
+
+test(aesVector) {
+  // FIPS-197, appendix C.1
+  uint8_t block[16];
+  for (int i = 0; i < 16; i++) {
+    block[i] = i * 0x11;
+  }
+  KnxAesKey key;
+  knxAesExpandKey(groupKey, &key);
+  knxAesEncrypt(&key, block);
+  const uint8_t expected[16] = {
+    0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30, 0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A
+  };
+  assertEquals(0, memcmp(expected, block, 16));
+}
+
+test(roundTrip) {
+  Pair p;
+  KnxTelegram tg;
+  groupWrite(&tg, 20, 3, 0xA5);
+  uint8_t secured[MAX_KNX_TELEGRAM_SIZE];
+  int length = p.sender.secure(tg.getBuffer(), secured);
+  assertEquals(MAX_KNX_TELEGRAM_SIZE, length);
+  assertTrue(checksumValid(secured, length));
+  assertEquals(0x03, secured[6] & 0x03);
+  assertEquals(0xF1, secured[7]);
+  assertEquals(KNX_SECURE_SCF_AUTH_CONF, secured[8]);
+  assertEquals(1, secured[14]);
+  // Encrypted: the value is not in the clear
+  assertTrue(secured[15] != 0x00 || secured[16] != 0x80 || secured[17] != 0xA5);
+
+  assertEquals(KNX_SECURE_OK, p.receiver.unsecure(secured));
+  assertEquals(0, memcmp(tg.getBuffer(), secured, tg.getTotalLength()));
+
+  // A plain frame to another group is left alone
+  groupWrite(&tg, 20, 9, 1);
+  assertEquals(0, p.sender.secure(tg.getBuffer(), secured));
+  memcpy(secured, tg.getBuffer(), tg.getTotalLength());
+  assertEquals(KNX_SECURE_PLAIN, p.receiver.unsecure(secured));
+  assertEquals(2ul, p.sender.getSequence());
+}
+
+test(knownAnswer) {
+  // Expected bytes computed apart from KnxSecure, with OpenSSL's
+  // AES-128-CBC and AES-128-CTR over the B0, Ctr0 and associated data
+  // layout of the KNX Data Secure specification (AN158)
+  Pair p;
+  p.sender.setSequence(0x1234);
+  KnxTelegram tg;
+  uint8_t secured[MAX_KNX_TELEGRAM_SIZE];
+  groupWrite(&tg, 20, 3, 0xA5);
+  assertEquals(MAX_KNX_TELEGRAM_SIZE, p.sender.secure(tg.getBuffer(), secured));
+  const uint8_t confidential[] = {
+    0xBC, 0x11, 0x14, 0x0A, 0x03, 0xEF, 0x03, 0xF1, 0x10, 0x00, 0x00, 0x00, 0x00, 0x12, 0x34,
+    0x00, 0x30, 0x02,        // 00 80 A5 encrypted
+    0xF8, 0x3B, 0xBC, 0x60   // MAC
+  };
+  assertEquals(0, memcmp(confidential, secured, sizeof(confidential)));
+
+  groupWrite(&tg, 20, 4, 0x3C);
+  assertEquals(MAX_KNX_TELEGRAM_SIZE, p.sender.secure(tg.getBuffer(), secured));
+  const uint8_t authenticated[] = {
+    0xBC, 0x11, 0x14, 0x0A, 0x04, 0xEF, 0x03, 0xF1, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x35,
+    0x00, 0x80, 0x3C,
+    0x21, 0xEC, 0x27, 0xB5
+  };
+  assertEquals(0, memcmp(authenticated, secured, sizeof(authenticated)));
+}
+
+test(authenticationOnly) {
+  Pair p;
+  KnxTelegram tg;
+  groupWrite(&tg, 20, 4, 0x3C);
+  uint8_t secured[MAX_KNX_TELEGRAM_SIZE];
+  assertEquals(MAX_KNX_TELEGRAM_SIZE, p.sender.secure(tg.getBuffer(), secured));
+  assertEquals(KNX_SECURE_SCF_AUTH, secured[8]);
+  assertEquals(0x80, secured[16]);
+  assertEquals(0x3C, secured[17]);
+  assertEquals(KNX_SECURE_OK, p.receiver.unsecure(secured));
+  assertEquals(0, memcmp(tg.getBuffer(), secured, tg.getTotalLength()));
+}
+
+test(rejections) {
+  Pair p;
+  KnxTelegram tg;
+  uint8_t secured[MAX_KNX_TELEGRAM_SIZE];
+  uint8_t copy[MAX_KNX_TELEGRAM_SIZE];
+  groupWrite(&tg, 20, 3, 1);
+  int length = p.sender.secure(tg.getBuffer(), secured);
+
+  // Any changed bit fails the MAC, and does not consume the sequence number
+  for (int i = 1; i < length - 1; i++) {
+    if (i == 1 || i == 2 || i == 5 || i == 6 || i == 7 || i == 8) {
+      continue;  // Other source, other length, not secured
+    }
+    memcpy(copy, secured, length);
+    copy[i] ^= 0x02;
+    KnxSecureResult result = p.receiver.unsecure(copy);
+    assertTrue(result == KNX_SECURE_BAD_MAC || result == KNX_SECURE_NO_KEY);
+  }
+  memcpy(copy, secured, length);
+  assertEquals(KNX_SECURE_OK, p.receiver.unsecure(copy));
+  memcpy(copy, secured, length);
+  assertEquals(KNX_SECURE_REPLAY, p.receiver.unsecure(copy));
+
+  // Unknown source
+  groupWrite(&tg, 21, 3, 1);
+  memcpy(copy, tg.getBuffer(), tg.getTotalLength());
+  p.sender.secure(copy, secured);
+  assertEquals(KNX_SECURE_UNKNOWN_SOURCE, p.receiver.unsecure(secured));
+
+  // Plain writes to a secured group, auth-only frames to a confidential one
+  groupWrite(&tg, 20, 3, 1);
+  memcpy(copy, tg.getBuffer(), tg.getTotalLength());
+  assertEquals(KNX_SECURE_NOT_SECURED, p.receiver.unsecure(copy));
+  KnxSecure weak;
+  weak.addGroupAddress(0x0A03, weak.addKey(groupKey), false);
+  weak.setSequence(100);
+  weak.secure(tg.getBuffer(), secured);
+  assertEquals(KNX_SECURE_NOT_SECURED, p.receiver.unsecure(secured));
+
+  // Too long for a standard frame
+  tg.set2ByteFloatValue(21.5);
+  tg.createChecksum();
+  assertEquals(-1, p.sender.secure(tg.getBuffer(), secured));
+
+  KnxSecureStats stats = p.receiver.getStats();
+  assertEquals(1ul, stats.received);
+  assertEquals(1ul, stats.replays);
+  assertTrue(stats.badMacs > 0);
+}
+
+test(sequenceState) {
+  storedSequences.clear();
+  Pair p;
+  p.sender.setSequence(1000);
+  p.sender.setSequenceWriter(storeSequence);
+  KnxTelegram tg;
+  uint8_t secured[MAX_KNX_TELEGRAM_SIZE];
+  for (int i = 0; i < KNX_SECURE_SEQUENCE_RESERVE + 1; i++) {
+    groupWrite(&tg, 20, 3, i);
+    p.sender.secure(tg.getBuffer(), secured);
+    assertEquals(KNX_SECURE_OK, p.receiver.unsecure(secured));
+  }
+  assertEquals(2u, storedSequences.size());
+  assertEquals(1000ul + KNX_SECURE_SEQUENCE_RESERVE, storedSequences[0]);
+  assertEquals(1000ul + 2 * KNX_SECURE_SEQUENCE_RESERVE, storedSequences[1]);
+
+  // The receiver's replay window survives a restart
+  uint8_t state[KNX_SECURE_STATE_SIZE(MAX_SECURE_SOURCES)];
+  int length = p.receiver.saveState(state, sizeof(state));
+  assertEquals(KNX_SECURE_STATE_SIZE(1), length);
+  KnxSecure restarted;
+  restarted.addGroupAddress(0x0A03, restarted.addKey(groupKey));
+  state[length - 1] ^= 1;
+  assertTrue(!restarted.loadState(state, length));
+  state[length - 1] ^= 1;
+  assertTrue(restarted.loadState(state, length));
+  groupWrite(&tg, 20, 3, 1);
+  p.sender.setSequence(1000 + KNX_SECURE_SEQUENCE_RESERVE);
+  p.sender.secure(tg.getBuffer(), secured);
+  assertEquals(KNX_SECURE_REPLAY, restarted.unsecure(secured));
+  p.sender.setSequence(storedSequences.back());
+  p.sender.secure(tg.getBuffer(), secured);
+  assertEquals(KNX_SECURE_OK, restarted.unsecure(secured));
+}
+
+test(unsortedStateIsRejected) {
+  Pair p;
+  p.receiver.addSource(0x1120);
+  uint8_t state[KNX_SECURE_STATE_SIZE(MAX_SECURE_SOURCES)];
+  int length = p.receiver.saveState(state, sizeof(state));
+  assertEquals(KNX_SECURE_STATE_SIZE(2), length);
+
+  // Swap both sources and fix up the CRC, only the order is wrong
+  uint8_t entry[2 + KNX_SECURE_SEQUENCE_SIZE];
+  memcpy(entry, state + 10, sizeof(entry));
+  memcpy(state + 10, state + 10 + sizeof(entry), sizeof(entry));
+  memcpy(state + 10 + sizeof(entry), entry, sizeof(entry));
+  uint16_t crc = 0xFFFF;
+  for (int i = 0; i < length - 2; i++) {
+    crc = knxConfigCrcUpdate(crc, state[i]);
+  }
+  state[length - 2] = crc & 0xFF;
+  state[length - 1] = crc >> 8;
+  assertTrue(!p.receiver.loadState(state, length));
+
+  // The running source table is kept
+  KnxTelegram tg;
+  uint8_t secured[MAX_KNX_TELEGRAM_SIZE];
+  groupWrite(&tg, 20, 3, 1);
+  p.sender.secure(tg.getBuffer(), secured);
+  assertEquals(KNX_SECURE_OK, p.receiver.unsecure(secured));
+}
+
+struct Fixture : KnxTestBus {
+  KnxSecure secure;
+  std::vector<int> values;
+
+  Fixture() {
+    knx.addListenGroupAddress("1/2/3");
+    knx.addListenGroupAddress("1/2/9");
+    secure.addGroupAddress(0x0A03, secure.addKey(groupKey));
+    secure.addSource(0x1114);
+    knx.setSecure(&secure);
+  }
+
+  void telegram() {
+    values.push_back(knx.getReceivedTelegram()->get1ByteIntValue());
+  }
+};
+
+test(tpUart) {
+  Fixture f;
+
+  // Sent secured, the receiving side decrypts it again
+  f.knx.groupWrite1ByteInt("1/2/3", 42);
+  std::vector<std::vector<uint8_t> > sent = f.sim.getSentFrames();
+  assertEquals(1u, sent.size());
+  assertEquals(MAX_KNX_TELEGRAM_SIZE, (int) sent[0].size());
+  assertEquals(0xF1, sent[0][7]);
+  KnxSecure peer;
+  peer.addGroupAddress(0x0A03, peer.addKey(groupKey));
+  peer.addSource(0x11C7);
+  assertEquals(KNX_SECURE_OK, peer.unsecure(&sent[0][0]));
+  assertEquals(42, sent[0][8]);
+
+  // Received: secured, tampered, plain to the secured group, plain
+  KnxSecure device;
+  device.addGroupAddress(0x0A03, device.addKey(groupKey));
+  KnxTelegram tg;
+  uint8_t secured[MAX_KNX_TELEGRAM_SIZE];
+  groupWrite(&tg, 20, 3, 7);
+  int length = device.secure(tg.getBuffer(), secured);
+  f.sim.inject(secured, length);
+  groupWrite(&tg, 20, 3, 8);
+  device.secure(tg.getBuffer(), secured);
+  secured[16] ^= 0x40;
+  secured[length - 1] ^= 0x40;
+  f.sim.inject(secured, length);
+  f.sim.inject(tg.getBuffer(), tg.getTotalLength());
+  groupWrite(&tg, 20, 9, 9);
+  f.sim.inject(tg.getBuffer(), tg.getTotalLength());
+  f.runUntil([&] { return f.values.size() >= 2; });
+
+  assertEquals(2u, f.values.size());
+  assertEquals(7, f.values[0]);
+  assertEquals(9, f.values[1]);
+  assertEquals(2ul, f.secure.getStats().rejected);
+}
+
+int main() {
+  return knxTestRun();
+}
@@ -0,0 +1,87 @@
+// File: test_state_sync.cpp
+// KnxStateSync against TpUartSimulator answering every group read.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include "KnxStateSync.h"
+#include "KnxTestSupport.h"
+
+#include <stdio.h>
+
+#define ADDRESS_COUNT 60
+
+static char addressText[ADDRESS_COUNT][12];
+static const char* addresses[ADDRESS_COUNT];
+static int answerValues[ADDRESS_COUNT];
+
+static void onAnswer(int index, KnxTelegram* answer) {
+  answerValues[index] = answer->get1ByteIntValue();
+}
+
+struct Fixture : KnxTestBus {
+  KnxTxQueue queue;
+  KnxStateSync sync;
+  uint8_t status[ADDRESS_COUNT];
+
+  Fixture() : sync(&knx) {
+    knx.setTxQueue(&queue);
+    knx.setTxInterval(0);
+
+    for (int i = 0; i < ADDRESS_COUNT; i++) {
+      snprintf(addressText[i], sizeof(addressText[i]), "4/1/%d", i);
+      addresses[i] = addressText[i];
+      answerValues[i] = -1;
+    }
+    sync.setAnswerCallback(onAnswer);
+  }
+
+  void poll() {
+    sync.poll();
+  }
+
+  void run() {
+    sync.begin(addresses, status, ADDRESS_COUNT);
+    runUntil([&] { return sync.isComplete(); }, 20000, 5);
+  }
+};
+
+test(syncCollectsAllAnswers) {
+  Fixture f;
+  f.sim.setAnswerReads(true);
+  f.run();
+
+  assertTrue(f.sync.isComplete());
+  assertEquals(ADDRESS_COUNT, f.sync.getAnsweredCount());
+  for (int i = 0; i < ADDRESS_COUNT; i++) {
+    assertEquals(KNX_SYNC_ANSWERED, f.sync.getStatus(i));
+    assertEquals(i, answerValues[i]);
+  }
+  printf("  %d addresses in %lu ms\n", ADDRESS_COUNT, f.sync.getDuration());
+}
+
+test(syncRetriesLostAnswers) {
+  Fixture f;
+  f.sim.setAnswerReads(true, 3);
+  f.run();
+
+  assertTrue(f.sync.isComplete());
+  assertEquals(ADDRESS_COUNT, f.sync.getAnsweredCount());
+  assertEquals(ADDRESS_COUNT + 3, (int) f.sim.getSentFrames().size());
+}
+
+test(syncReportsSilentAddresses) {
+  Fixture f;
+  f.sync.setTimeout(50);
+  f.run();
+
+  assertTrue(f.sync.isComplete());
+  assertEquals(0, f.sync.getAnsweredCount());
+  assertEquals(ADDRESS_COUNT, f.sync.getNoAnswerCount());
+  assertEquals(ADDRESS_COUNT * (1 + STATE_SYNC_RETRIES), (int) f.sim.getSentFrames().size());
+}
+
+int main() {
+  return knxTestRun();
+}
@@ -0,0 +1,75 @@
+// File: test_telegram_view.cpp
+// KnxTelegramView must decode exactly like KnxTelegram.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include "KnxTelegramView.h"
+
+// Group write 1.1.5 -> 2/6/0, value true
+static constexpr uint8_t groupWrite[] = { 0xBC, 0x11, 0x05, 0x16, 0x00, 0xE1, 0x00, 0x81, 0x21 };
+
+static_assert(KnxTelegramView(groupWrite).isTargetGroup(), "constexpr isTargetGroup");
+static_assert(KnxTelegramView(groupWrite).getTargetMainGroup() == 2, "constexpr main group");
+static_assert(KnxTelegramView(groupWrite).getCommand() == KNX_COMMAND_WRITE, "constexpr command");
+static_assert(KnxTelegramView(groupWrite).getTotalLength() == 9, "constexpr length");
+static_assert(KnxTelegramView(groupWrite).verifyChecksum(), "constexpr checksum");
+
+test(viewMatchesTelegram) {
+  KnxTelegram tg;
+  tg.setRepeated(true);
+  tg.setPriority(KNX_PRIORITY_ALARM);
+  tg.setSourceAddress(15, 12, 20);
+  tg.setTargetGroupAddress(31, 7, 255);
+  tg.setRoutingCounter(5);
+  tg.setCommand(KNX_COMMAND_ANSWER);
+  tg.set2ByteIntValue(0x1234);
+  tg.createChecksum();
+
+  KnxTelegramView view(tg.getBuffer());
+  assertEquals(tg.isRepeated(), view.isRepeated());
+  assertEquals(tg.getPriority(), view.getPriority());
+  assertEquals(tg.getSourceArea(), view.getSourceArea());
+  assertEquals(tg.getSourceLine(), view.getSourceLine());
+  assertEquals(tg.getSourceMember(), view.getSourceMember());
+  assertEquals(tg.isTargetGroup(), view.isTargetGroup());
+  assertEquals(tg.getTargetMainGroup(), view.getTargetMainGroup());
+  assertEquals(tg.getTargetMiddleGroup(), view.getTargetMiddleGroup());
+  assertEquals(tg.getTargetSubGroup(), view.getTargetSubGroup());
+  assertEquals(tg.getTargetGroupAddress(), view.getTargetAddress());
+  assertEquals(tg.getRoutingCounter(), view.getRoutingCounter());
+  assertEquals(tg.getPayloadLength(), view.getPayloadLength());
+  assertEquals(tg.getTotalLength(), view.getTotalLength());
+  assertEquals(tg.getCommand(), view.getCommand());
+  assertEquals(tg.getChecksum(), view.getChecksum());
+  assertTrue(view.verifyChecksum());
+  assertEquals(0xFC14, view.getSourceAddress());
+}
+
+test(viewIndividualTarget) {
+  KnxTelegram tg;
+  tg.setTargetIndividualAddress(1, 2, 3);
+  tg.setCommunicationType(KNX_COMM_NCD);
+  tg.setSequenceNumber(9);
+  tg.setControlData(KNX_CONTROLDATA_POS_CONFIRM);
+
+  KnxTelegramView view(tg.getBuffer());
+  assertTrue(!view.isTargetGroup());
+  assertEquals(0x1203, view.getTargetAddress());
+  assertEquals(KNX_COMM_NCD, view.getCommunicationType());
+  assertEquals(9, view.getSequenceNumber());
+  assertEquals(KNX_CONTROLDATA_POS_CONFIRM, view.getControlData());
+}
+
+test(viewChecksumMismatch) {
+  uint8_t frame[sizeof(groupWrite)];
+  memcpy(frame, groupWrite, sizeof(frame));
+  assertTrue(KnxTelegramView(frame).verifyChecksum());
+  frame[4] ^= 1;
+  assertTrue(!KnxTelegramView(frame).verifyChecksum());
+}
+
+int main() {
+  return knxTestRun();
+}
@@ -0,0 +1,133 @@
+// File: test_timestamps.cpp
+// Receive timestamps from the interrupt ring, transmit timing and the
+// latency histograms.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include "KnxTestSupport.h"
+#include "KnxTpUart.h"
+
+// Confirms every frame written to it positively
+class ConfirmingStream : public Stream {
+  public:
+    ConfirmingStream() : control(true), end(false), confirmations(0) {}
+
+    size_t write(uint8_t b) {
+      // Pairs of data request service and data byte
+      if (control) {
+        end = (b & 0b11000000) == TPUART_DATA_END;
+      }
+      else if (end) {
+        confirmations++;
+      }
+      control = !control;
+      return 1;
+    }
+    int available() {
+      return confirmations;
+    }
+    int read() {
+      if (confirmations == 0) {
+        return -1;
+      }
+      confirmations--;
+      return 0b10001011;
+    }
+    int peek() {
+      return confirmations > 0 ? 0b10001011 : -1;
+    }
+
+  private:
+    bool control;
+    bool end;
+    int confirmations;
+};
+
+test(ringTimestampsOnTelegram) {
+  NullStream out;
+  KnxRxRing ring;
+  KnxLatencyStats stats;
+  KnxTpUart knx(&out, "1.1.1");
+  knx.setRxRing(&ring);
+  knx.setLatencyStats(&stats);
+  knx.addListenGroupAddress("1/2/3");
+
+  KnxTelegram tg;
+  tg.setTargetGroupAddress(1, 2, 3);
+  tg.setCommand(KNX_COMMAND_WRITE);
+  tg.setFirstDataByte(1);
+  tg.createChecksum();
+
+  unsigned long t = 5000;
+  for (int i = 0; i < tg.getTotalLength(); i++) {
+    ring.push(tg.getBufferByte(i), t);
+    t += 1300;
+  }
+
+  assertEquals(KNX_TELEGRAM, knx.serialEvent());
+  KnxTelegram* received = knx.getReceivedTelegram();
+  assertEquals(5000UL, received->getStartTime());
+  assertEquals(5000UL + 8 * 1300, received->getEndTime());
+  assertEquals(1UL, stats.rxFrame.getCount());
+  assertEquals(8UL * 1300, stats.rxFrame.getMax());
+}
+
+test(txTimingOfQueuedFrame) {
+  hostClockSetVirtual(true);
+  ConfirmingStream out;
+  KnxTxQueue queue;
+  KnxLatencyStats stats;
+  KnxTpUart knx(&out, "1.1.1");
+  knx.setTxQueue(&queue);
+  knx.setTxInterval(0);
+  knx.setLatencyStats(&stats);
+
+  assertTrue(knx.groupWriteBool("1/2/3", true));
+  hostClockAdvance(3000);
+  assertTrue(knx.processTxQueue());
+
+  KnxTxTiming timing = knx.getLastTxTiming();
+  assertEquals(timing.queued + 3000, timing.start);
+  assertTrue(timing.confirmed != 0);
+  assertEquals(timing.start, timing.confirmed);
+  assertEquals(1UL, stats.txQueueWait.getCount());
+  assertEquals(3000UL, stats.txQueueWait.getMax());
+  assertEquals(1UL, stats.txConfirm.getCount());
+  assertEquals(0UL, stats.txConfirm.getMax());
+  hostClockSetVirtual(false);
+}
+
+test(histogramBuckets) {
+  KnxHistogram h;
+  h.record(0);
+  h.record(1);
+  h.record(2);
+  h.record(3);
+  h.record(1000);
+  h.record(1023);
+  h.record(1024);
+
+  assertEquals(7UL, h.getCount());
+  assertEquals(2UL, h.getBucketCount(0));
+  assertEquals(2UL, h.getBucketCount(1));
+  assertEquals(2UL, h.getBucketCount(9));
+  assertEquals(1UL, h.getBucketCount(10));
+  assertEquals(0UL, h.getMin());
+  assertEquals(1024UL, h.getMax());
+  assertEquals(512UL, h.getPercentile(80));
+  assertEquals(1024UL, h.getPercentile(100));
+}
+
+test(clearResetsTimestamps) {
+  KnxTelegram tg;
+  tg.setTimestamps(1, 2);
+  tg.clear();
+  assertEquals(0UL, tg.getStartTime());
+  assertEquals(0UL, tg.getEndTime());
+}
+
+int main() {
+  return knxTestRun();
+}
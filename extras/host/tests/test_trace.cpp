@@ -0,0 +1,73 @@
+// File: test_trace.cpp
+// Tracepoints: built with -DKNX_TRACE against the traced library.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include <string>
+#include <vector>
+
+#include "KnxTestSupport.h"
+
+static void groupWrite(KnxTelegram* tg, int sub, int value) {
+  tg->clear();
+  tg->setSourceAddress(1, 1, 20);
+  tg->setTargetGroupAddress(1, 2, sub);
+  tg->setCommand(KNX_COMMAND_WRITE);
+  tg->set1ByteIntValue(value);
+  tg->createChecksum();
+}
+
+struct Fixture : KnxTestBus {
+  Fixture() {
+    knx.addListenGroupAddress("1/2/3");
+    knxTraceReset();
+  }
+};
+
+test(stages) {
+  Fixture f;
+  KnxTelegram tg;
+  groupWrite(&tg, 9, 1);
+  f.sim.inject(tg.getBuffer(), tg.getTotalLength());
+  groupWrite(&tg, 3, 2);
+  f.sim.inject(tg.getBuffer(), tg.getTotalLength());
+  f.runUntil([&] { return f.telegrams >= 1; });
+  assertEquals(1, f.telegrams);
+
+  // Both frames are filtered and answered, only the listened one dispatched
+  assertEquals(2ul, knxTraceHistograms[KNX_TRACE_ADDRESS_FILTER].getCount());
+  assertEquals(2ul, knxTraceHistograms[KNX_TRACE_SEND_ACK].getCount());
+  assertEquals(2ul, knxTraceHistograms[KNX_TRACE_READ_TELEGRAM].getCount());
+  assertEquals(0ul, knxTraceHistograms[KNX_TRACE_SEND_FRAME].getCount());
+
+  f.knx.groupWrite1ByteInt("1/2/3", 42);
+  assertEquals(1ul, knxTraceHistograms[KNX_TRACE_SEND_FRAME].getCount());
+  assertTrue(knxTraceHistograms[KNX_TRACE_SEND_FRAME].getMax() > 0);
+
+  KnxSecure secure;
+  uint8_t key[16] = {0};
+  secure.addGroupAddress(0x0A03, secure.addKey(key));
+  f.knx.setSecure(&secure);
+  f.knx.groupWrite1ByteInt("1/2/3", 43);
+  assertEquals(1ul, knxTraceHistograms[KNX_TRACE_SECURE].getCount());
+}
+
+test(dump) {
+  knxTraceReset();
+  StringPrint out;
+  knxTraceDump(&out);
+  assertEquals(std::string("Tracepoints in " KNX_TRACE_UNIT "\r\n"), out.text);
+
+  knxTraceHistograms[KNX_TRACE_SEND_ACK].record(100);
+  knxTraceDump(&out);
+  assertTrue(out.text.find("sendAck") != std::string::npos);
+  assertTrue(out.text.find("readKNXTelegram") == std::string::npos);
+  knxTraceReset();
+  assertEquals(0ul, knxTraceHistograms[KNX_TRACE_SEND_ACK].getCount());
+}
+
+int main() {
+  return knxTestRun();
+}
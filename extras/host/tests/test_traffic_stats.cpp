@@ -0,0 +1,128 @@
+// File: test_traffic_stats.cpp
+// Per-sender and per-group-address traffic accounting.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include <string>
+
+#include "KnxTestSupport.h"
+
+static int buildWrite(uint8_t* frame, int member, int sub, bool repeated) {
+  KnxTelegram tg;
+  tg.setSourceAddress(1, 1, member);
+  tg.setTargetGroupAddress(1, 2, sub);
+  tg.setCommand(KNX_COMMAND_WRITE);
+  tg.set1ByteIntValue(sub);
+  tg.setRepeated(repeated);
+  tg.createChecksum();
+  for (int i = 0; i < tg.getTotalLength(); i++) {
+    frame[i] = tg.getBufferByte(i);
+  }
+  return tg.getTotalLength();
+}
+
+test(countsPerSourceAndGroup) {
+  KnxTrafficStats stats;
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  for (int i = 0; i < 5; i++) {
+    int length = buildWrite(frame, 20, 3, i == 4);
+    stats.record(frame, length);
+  }
+  int length = buildWrite(frame, 21, 4, false);
+  stats.record(frame, length);
+
+  assertEquals(6UL, stats.getFrameCount());
+  assertEquals(6UL * length, stats.getByteCount());
+  assertEquals(1UL, stats.getRepeatCount());
+
+  KnxTrafficEntry entries[4];
+  assertEquals(2, stats.getSources()->getTop(entries, 4));
+  assertEquals(0x1114, entries[0].address);
+  assertEquals(5UL, entries[0].frames);
+  assertEquals(5UL * length, entries[0].bytes);
+  assertEquals(1UL, entries[0].repeats);
+  assertEquals(0UL, entries[0].error);
+  assertEquals(0x1115, entries[1].address);
+
+  KnxTrafficEntry entry;
+  assertTrue(stats.getGroupAddresses()->find(0x0A04, &entry));
+  assertEquals(1UL, entry.frames);
+  assertTrue(!stats.getGroupAddresses()->find(0x0A05, &entry));
+
+  StringPrint out;
+  stats.print(&out, 1);
+  assertTrue(out.text == "frames 6 bytes 60 repeats 1\r\n"
+                         "1.1.20 frames 5 bytes 50 repeats 1\r\n"
+                         "1/2/3 frames 5 bytes 50 repeats 1\r\n");
+
+  stats.clear();
+  assertEquals(0UL, stats.getFrameCount());
+  assertEquals(0, stats.getSources()->getTop(entries, 4));
+}
+
+test(heavyHittersSurviveManyAddresses) {
+  // One sender floods while many others send a frame each
+  KnxTrafficStats stats;
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  int flood = 0;
+  for (int i = 0; i < 2000; i++) {
+    int length;
+    if (i % 4 == 0) {
+      length = buildWrite(frame, 99, 1, false);
+      flood++;
+    }
+    else {
+      length = buildWrite(frame, 100 + i % 150, 2, false);
+    }
+    stats.record(frame, length);
+  }
+
+  KnxTrafficEntry top;
+  assertEquals(1, stats.getSources()->getTop(&top, 1));
+  assertEquals(0x1163, top.address);
+  // Never less than the real count, and at most error more
+  assertTrue(top.frames >= (unsigned long) flood);
+  assertTrue(top.frames - top.error <= (unsigned long) flood);
+
+  KnxTrafficEntry entries[TPUART_TRAFFIC_SLOTS];
+  assertEquals(TPUART_TRAFFIC_SLOTS, stats.getSources()->getTop(entries, TPUART_TRAFFIC_SLOTS + 5));
+  unsigned long total = 0;
+  for (int i = 0; i < TPUART_TRAFFIC_SLOTS; i++) {
+    total += entries[i].frames;
+    if (i > 0) {
+      assertTrue(entries[i - 1].frames >= entries[i].frames);
+    }
+  }
+  assertEquals(stats.getFrameCount(), total);
+}
+
+test(tpUartCountsBusTraffic) {
+  KnxTestBus f;
+  KnxTrafficStats stats;
+  f.knx.setTrafficStats(&stats);
+  f.knx.addListenGroupAddress("1/2/3");
+
+  // Acknowledged, ignored and sent frames are all counted
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  int length = buildWrite(frame, 20, 3, false);
+  f.sim.inject(frame, length);
+  length = buildWrite(frame, 20, 4, true);
+  f.sim.inject(frame, length);
+  f.runUntil([&] { return stats.getFrameCount() >= 2; });
+  assertTrue(f.knx.groupWrite1ByteInt("1/2/5", 7));
+
+  assertEquals(3UL, stats.getFrameCount());
+  assertEquals(1UL, stats.getRepeatCount());
+  KnxTrafficEntry entry;
+  assertTrue(stats.getSources()->find(0x1114, &entry));
+  assertEquals(2UL, entry.frames);
+  assertTrue(stats.getSources()->find(0x11C7, &entry));
+  assertEquals(1UL, entry.frames);
+  assertTrue(stats.getGroupAddresses()->find(0x0A05, &entry));
+}
+
+int main() {
+  return knxTestRun();
+}
@@ -0,0 +1,151 @@
+// File: test_transport.cpp
+// Connection-oriented transport layer against an ETS-like peer.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include "KnxTestSupport.h"
+
+struct Fixture : KnxTestBus {
+  KnxTransport transport;
+
+  Fixture() : transport(&knx) {
+    knx.setTransport(&transport);
+  }
+
+  void poll() {
+    transport.poll();
+  }
+
+  // From the peer 1.1.250 (or another member)
+  void inject(KnxCommunicationType type, int control, int sequenceNo, int member = 250) {
+    KnxTelegram tg;
+    tg.setSourceAddress(1, 1, member);
+    tg.setTargetIndividualAddress(1, 1, 199);
+    if (type == KNX_COMM_NDP) {
+      tg.setCommand(KNX_COMMAND_MASK_VERSION_READ);
+    }
+    else {
+      tg.setPayloadLength(1);
+    }
+    tg.setCommunicationType(type);
+    tg.setSequenceNumber(sequenceNo);
+    if (type == KNX_COMM_UCD || type == KNX_COMM_NCD) {
+      tg.setControlData((KnxControlDataType) control);
+    }
+    tg.createChecksum();
+    KnxTestBus::inject(&tg);
+  }
+
+  // Runs the loop until the host sent count frames in total
+  bool waitForSent(int count) {
+    return runUntil([&] { return (int) sim.getSentFrames().size() >= count; }, 2000);
+  }
+
+  // TPCI byte of a sent frame
+  int tpci(int index) {
+    return sim.getSentFrames()[index][6];
+  }
+};
+
+#define T_CONNECT 0x80
+#define T_DISCONNECT 0x81
+#define T_ACK(seq) (0xC2 | ((seq) << 2))
+#define T_NAK(seq) (0xC3 | ((seq) << 2))
+
+test(connectDataAndAck) {
+  Fixture f;
+  f.inject(KNX_COMM_UCD, KNX_CONTROLDATA_CONNECT, 0);
+  f.inject(KNX_COMM_NDP, 0, 0);
+  assertTrue(f.waitForSent(1));
+  assertEquals(T_ACK(0), f.tpci(0));
+  assertEquals(1, f.telegrams);
+  assertTrue(f.transport.isConnectedTo(1, 1, 250));
+
+  // Answer with our own sequence, not the peer's
+  f.inject(KNX_COMM_NDP, 0, 1);
+  assertTrue(f.waitForSent(2));
+  assertEquals(T_ACK(1), f.tpci(1));
+  assertTrue(f.knx.individualAnswerMaskVersion(1, 1, 250));
+  assertEquals(3u, f.sim.getSentFrames().size());
+  assertEquals(0x40 | (0 << 2) | 0x03, f.tpci(2));
+  assertEquals(KNX_TRANSPORT_OPEN_WAIT, f.transport.getState());
+
+  // Nothing more until the T_ACK arrived
+  KnxTelegram tg;
+  tg.setCommand(KNX_COMMAND_MASK_VERSION_RESPONSE);
+  assertTrue(!f.transport.sendData(&tg));
+  f.inject(KNX_COMM_NCD, KNX_CONTROLDATA_POS_CONFIRM, 0);
+  f.settle(50);
+  assertEquals(KNX_TRANSPORT_OPEN_IDLE, f.transport.getState());
+  assertTrue(f.transport.sendData(&tg));
+  assertEquals(0x40 | (1 << 2) | 0x03, f.tpci(3));
+
+  f.inject(KNX_COMM_UCD, KNX_CONTROLDATA_DISCONNECT, 0);
+  f.settle(50);
+  assertEquals(KNX_TRANSPORT_CLOSED, f.transport.getState());
+  assertEquals(2, f.telegrams);
+}
+
+test(duplicatesAndWrongSequence) {
+  Fixture f;
+  f.inject(KNX_COMM_UCD, KNX_CONTROLDATA_CONNECT, 0);
+  f.inject(KNX_COMM_NDP, 0, 0);
+  f.inject(KNX_COMM_NDP, 0, 0);  // Repeated, our T_ACK was lost
+  f.inject(KNX_COMM_NDP, 0, 5);
+  assertTrue(f.waitForSent(3));
+  assertEquals(T_ACK(0), f.tpci(0));
+  assertEquals(T_ACK(0), f.tpci(1));
+  assertEquals(T_NAK(5), f.tpci(2));
+  assertEquals(1, f.telegrams);
+  assertTrue(f.transport.isConnected());
+}
+
+test(otherPeerIsRejected) {
+  Fixture f;
+  f.inject(KNX_COMM_UCD, KNX_CONTROLDATA_CONNECT, 0);
+  f.inject(KNX_COMM_UCD, KNX_CONTROLDATA_CONNECT, 0, 251);
+  assertTrue(f.waitForSent(1));
+  assertEquals(T_DISCONNECT, f.tpci(0));
+  assertEquals(251, f.sim.getSentFrames()[0][4]);
+  assertTrue(f.transport.isConnectedTo(1, 1, 250));
+
+  // Data without a connection
+  f.inject(KNX_COMM_NDP, 0, 0, 252);
+  assertTrue(f.waitForSent(2));
+  assertEquals(T_DISCONNECT, f.tpci(1));
+  assertEquals(0, f.telegrams);
+}
+
+test(ackTimeoutRepeatsThenDisconnects) {
+  Fixture f;
+  f.transport.setTimeouts(2000, 50);
+  f.inject(KNX_COMM_UCD, KNX_CONTROLDATA_CONNECT, 0);
+  f.settle(50);
+
+  KnxTelegram tg;
+  tg.setCommand(KNX_COMMAND_MASK_VERSION_RESPONSE);
+  assertTrue(f.transport.sendData(&tg));
+  assertTrue(f.waitForSent(1 + TRANSPORT_MAX_REPETITIONS + 1));
+  for (int i = 0; i <= TRANSPORT_MAX_REPETITIONS; i++) {
+    assertEquals(0x43, f.tpci(i));
+  }
+  assertEquals(T_DISCONNECT, f.tpci(TRANSPORT_MAX_REPETITIONS + 1));
+  assertEquals(KNX_TRANSPORT_CLOSED, f.transport.getState());
+  assertEquals((unsigned long) TRANSPORT_MAX_REPETITIONS, f.transport.getRepetitionCount());
+}
+
+test(connectionTimeout) {
+  Fixture f;
+  f.transport.setTimeouts(100, 50);
+  assertTrue(f.transport.connect(1, 1, 250));
+  assertEquals(T_CONNECT, f.tpci(0));
+  assertTrue(f.waitForSent(2));
+  assertEquals(T_DISCONNECT, f.tpci(1));
+  assertTrue(!f.transport.isConnected());
+}
+
+int main() {
+  return knxTestRun();
+}
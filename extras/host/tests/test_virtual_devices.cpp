@@ -0,0 +1,143 @@
+// File: test_virtual_devices.cpp
+// Several individual addresses and listen tables behind one TP-UART.
+
+// Last modified: 18.10.2026
+
+#include "KnxTest.h"
+
+#include <vector>
+
+#include "KnxTestSupport.h"
+
+struct Delivery {
+  int device;
+  uint16_t target;
+};
+
+static std::vector<Delivery> deliveries;
+
+static void recordDelivery(int device, KnxTelegram* tg, void*) {
+  Delivery d = { device, tg->isTargetGroup() ? tg->getTargetGroupAddress() : (uint16_t) 0 };
+  deliveries.push_back(d);
+}
+
+struct Fixture : KnxTestBus {
+  KnxVirtualDevices devices;
+
+  Fixture() : devices(&knx) {
+    deliveries.clear();
+    knx.addListenGroupAddress("1/2/3");
+    knx.setVirtualDevices(&devices);
+  }
+
+  void injectGroupWrite(int main, int middle, int sub) {
+    injectGroup(KNX_COMMAND_WRITE, main, middle, sub, 1);
+  }
+
+  // The frame to our own listen table marks the end of a sequence
+  bool waitForMarker() {
+    injectGroupWrite(1, 2, 3);
+    bool done = runUntil([&] { return telegrams >= 1; });
+    delay(20);
+    return done;
+  }
+};
+
+test(mergedFilter) {
+  KnxTpUart knx(&Serial, "1.1.199");
+  KnxVirtualDevices devices(&knx);
+  int a = devices.addDevice("1.1.201", NULL);
+  int b = devices.addDevice("1.1.200", NULL);
+  int c = devices.addDevice("1.1.202", NULL);
+  assertEquals(-1, devices.addDevice("1.1.200", NULL));
+  assertEquals(3, devices.getDeviceCount());
+
+  assertTrue(devices.addListenGroupAddress(a, "2/0/1"));
+  assertTrue(devices.addListenGroupAddress(c, "2/0/1"));
+  assertTrue(devices.addListenGroupAddress(b, "2/0/0"));
+  assertTrue(devices.addListenGroupAddress(b, "2/0/1"));
+  assertTrue(!devices.addListenGroupAddress(7, "2/0/1"));
+
+  assertEquals(0x07, devices.getGroupOwners(0x1001));
+  assertEquals(1 << b, devices.getGroupOwners(0x1000));
+  assertEquals(0, devices.getGroupOwners(0x1002));
+  assertEquals(a, devices.getDevice(0x11C9));
+  assertEquals(b, devices.getDevice(0x11C8));
+  assertEquals(c, devices.getDevice(0x11CA));
+  assertEquals(-1, devices.getDevice(0x11C7));
+}
+
+test(groupFramesGoToTheirOwners) {
+  Fixture f;
+  int a = f.devices.addDevice("1.1.200", recordDelivery);
+  int b = f.devices.addDevice("1.1.201", recordDelivery);
+  f.devices.addListenGroupAddress(a, "2/0/1");
+  f.devices.addListenGroupAddress(b, "2/0/1");
+  f.devices.addListenGroupAddress(b, "1/2/3");
+
+  f.injectGroupWrite(2, 0, 1);
+  f.injectGroupWrite(2, 0, 2);
+  assertTrue(f.waitForMarker());
+
+  // Only the marker is reported, it also went to device b
+  assertEquals(1, f.telegrams);
+  assertEquals(3u, deliveries.size());
+  assertEquals(a, deliveries[0].device);
+  assertEquals(b, deliveries[1].device);
+  assertEquals(b, deliveries[2].device);
+  assertEquals(0x0A03, deliveries[2].target);
+
+  std::vector<uint8_t> acks = f.sim.getAckBytes();
+  assertEquals(3u, acks.size());
+  assertEquals(0b00010001, acks[0]);
+  assertEquals(0b00010000, acks[1]);
+  assertEquals(0b00010001, acks[2]);
+}
+
+test(individualServicesPerDevice) {
+  Fixture f;
+  f.devices.addDevice("1.1.200", recordDelivery);
+  int b = f.devices.addDevice("1.1.201", recordDelivery);
+  uint8_t image[16] = { 0 };
+  image[4] = 0x5A;
+  KnxDeviceMemory memory(image, sizeof(image));
+  f.devices.setDeviceMemory(b, &memory);
+
+  KnxTelegram tg;
+  tg.setSourceAddress(1, 1, 20);
+  tg.setTargetIndividualAddress(1, 1, 201);
+  tg.setCommand(KNX_COMMAND_MEMORY_READ);
+  tg.setFirstDataByte(1);
+  tg.setBufferByte(8, 0);
+  tg.setBufferByte(9, 4);
+  tg.setPayloadLength(4);
+  tg.createChecksum();
+  f.sim.inject(tg.getBuffer(), tg.getTotalLength());
+  unsigned long start = millis();
+  while (f.sim.getSentFrames().size() < 1 && millis() - start < 1000) {
+    f.loop.runOnce(10);
+  }
+  assertTrue(f.waitForMarker());
+
+  // Answered from the device image with the device's address
+  std::vector<std::vector<uint8_t> > sent = f.sim.getSentFrames();
+  assertEquals(1u, sent.size());
+  assertEquals(0x11, sent[0][1]);
+  assertEquals(201, sent[0][2]);
+  assertEquals(0x5A, sent[0][10]);
+  assertEquals(0u, deliveries.size());
+
+  // Sending as a device
+  tg.clear();
+  tg.setTargetGroupAddress(2, 0, 1);
+  tg.setCommand(KNX_COMMAND_WRITE);
+  tg.set1ByteIntValue(7);
+  assertTrue(f.devices.send(b, &tg));
+  sent = f.sim.getSentFrames();
+  assertEquals(2u, sent.size());
+  assertEquals(201, sent[1][2]);
+}
+
+int main() {
+  return knxTestRun();
+}
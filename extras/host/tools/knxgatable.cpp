@@ -0,0 +1,415 @@
+// File: knxgatable.cpp
+// Generates a KnxGroupAddressTable header from an ETS group address
+// export, CSV (any separator, with or without header) or XML.
+//
+//   knxgatable export.csv [table name] [define prefix] > GroupAddresses.h
+//
+// The table is read-only and placed in PROGMEM. Each address also gets a
+// define, so that sketches need no lookup at all for fixed addresses.
+// Files are read as UTF-8; UTF-16 exports are converted.
+
+// Last modified: 18.10.2026
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct GroupAddress {
+  std::string name;
+  uint16_t address;
+  uint8_t dptMain;
+  uint16_t dptSub;
+};
+
+static void appendUtf8(std::string* out, unsigned long c) {
+  if (c < 0x80) {
+    *out += (char) c;
+  }
+  else if (c < 0x800) {
+    *out += (char) (0xC0 | (c >> 6));
+    *out += (char) (0x80 | (c & 0x3F));
+  }
+  else if (c < 0x10000) {
+    *out += (char) (0xE0 | (c >> 12));
+    *out += (char) (0x80 | ((c >> 6) & 0x3F));
+    *out += (char) (0x80 | (c & 0x3F));
+  }
+  else {
+    *out += (char) (0xF0 | (c >> 18));
+    *out += (char) (0x80 | ((c >> 12) & 0x3F));
+    *out += (char) (0x80 | ((c >> 6) & 0x3F));
+    *out += (char) (0x80 | (c & 0x3F));
+  }
+}
+
+// Strips a byte order mark, converts UTF-16 to UTF-8
+static std::string decode(const std::string& raw) {
+  if (raw.size() >= 3 && raw.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+    return raw.substr(3);
+  }
+  bool little = raw.size() >= 2 && (uint8_t) raw[0] == 0xFF && (uint8_t) raw[1] == 0xFE;
+  bool big = raw.size() >= 2 && (uint8_t) raw[0] == 0xFE && (uint8_t) raw[1] == 0xFF;
+  if (!little && !big) {
+    return raw;
+  }
+  std::string out;
+  for (size_t i = 2; i + 1 < raw.size(); i += 2) {
+    unsigned long c = little ? ((uint8_t) raw[i] | ((uint8_t) raw[i + 1] << 8))
+                             : (((uint8_t) raw[i] << 8) | (uint8_t) raw[i + 1]);
+    if (c >= 0xD800 && c < 0xDC00 && i + 3 < raw.size()) {
+      unsigned long low = little ? ((uint8_t) raw[i + 2] | ((uint8_t) raw[i + 3] << 8))
+                                 : (((uint8_t) raw[i + 2] << 8) | (uint8_t) raw[i + 3]);
+      c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+      i += 2;
+    }
+    appendUtf8(&out, c);
+  }
+  return out;
+}
+
+// "1/2/3", "1/515" or "2563"; false for ranges like "1/-/-"
+static bool parseAddress(const std::string& text, uint16_t* address) {
+  std::vector<long> parts;
+  std::stringstream stream(text);
+  std::string part;
+  while (std::getline(stream, part, '/')) {
+    if (part.empty() || part.find_first_not_of("0123456789 ") != std::string::npos) {
+      return false;
+    }
+    parts.push_back(atol(part.c_str()));
+  }
+  if (parts.size() == 3 && parts[0] < 32 && parts[1] < 8 && parts[2] < 256) {
+    *address = (parts[0] << 11) | (parts[1] << 8) | parts[2];
+  }
+  else if (parts.size() == 2 && parts[0] < 32 && parts[1] < 2048) {
+    *address = (parts[0] << 11) | parts[1];
+  }
+  else if (parts.size() == 1 && parts[0] < 65536) {
+    *address = parts[0];
+  }
+  else {
+    return false;
+  }
+  return true;
+}
+
+// First of "DPST-9-1", "DPT-9" or "9.001"
+static void parseDpt(const std::string& text, GroupAddress* ga) {
+  ga->dptMain = 0;
+  ga->dptSub = 0;
+  const char* p = text.c_str();
+  while (*p != '\0' && !isdigit((unsigned char) *p)) {
+    p++;
+  }
+  if (*p == '\0') {
+    return;
+  }
+  char* end;
+  ga->dptMain = strtol(p, &end, 10);
+  if (*end == '-' || *end == '.') {
+    ga->dptSub = strtol(end + 1, NULL, 10);
+  }
+}
+
+static std::vector<std::string> splitCsvLine(const std::string& line, char separator) {
+  std::vector<std::string> fields(1);
+  bool quoted = false;
+  for (size_t i = 0; i < line.size(); i++) {
+    char c = line[i];
+    if (quoted) {
+      if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+        fields.back() += '"';
+        i++;
+      }
+      else if (c == '"') {
+        quoted = false;
+      }
+      else {
+        fields.back() += c;
+      }
+    }
+    else if (c == '"') {
+      quoted = true;
+    }
+    else if (c == separator) {
+      fields.push_back(std::string());
+    }
+    else if (c != '\r') {
+      fields.back() += c;
+    }
+  }
+  return fields;
+}
+
+static char detectSeparator(const std::string& line) {
+  const char candidates[] = { ';', ',', '\t' };
+  char best = ';';
+  size_t bestCount = 0;
+  for (char c : candidates) {
+    size_t count = splitCsvLine(line, c).size();
+    if (count > bestCount) {
+      best = c;
+      bestCount = count;
+    }
+  }
+  return best;
+}
+
+static int findColumn(const std::vector<std::string>& header, const char* a, const char* b) {
+  for (size_t i = 0; i < header.size(); i++) {
+    if (strcasecmp(header[i].c_str(), a) == 0 || strcasecmp(header[i].c_str(), b) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static void parseCsv(const std::string& text, std::vector<GroupAddress>* out) {
+  std::stringstream stream(text);
+  std::string line;
+  char separator = 0;
+  // ETS column order when exported without header
+  int nameColumn = 0;
+  int addressColumn = 1;
+  int dptColumn = 5;
+  while (std::getline(stream, line)) {
+    if (separator == 0) {
+      separator = detectSeparator(line);
+      std::vector<std::string> header = splitCsvLine(line, separator);
+      if (findColumn(header, "Address", "Adresse") >= 0) {
+        nameColumn = findColumn(header, "Group name", "Name");
+        addressColumn = findColumn(header, "Address", "Adresse");
+        dptColumn = findColumn(header, "DatapointType", "DPTs");
+        continue;
+      }
+    }
+    std::vector<std::string> fields = splitCsvLine(line, separator);
+    GroupAddress ga;
+    if (nameColumn < 0 || (int) fields.size() <= std::max(nameColumn, addressColumn)
+        || !parseAddress(fields[addressColumn], &ga.address)) {
+      continue;
+    }
+    ga.name = fields[nameColumn];
+    parseDpt(dptColumn >= 0 && dptColumn < (int) fields.size() ? fields[dptColumn] : "", &ga);
+    out->push_back(ga);
+  }
+}
+
+static std::string unescapeXml(const std::string& text) {
+  std::string out;
+  for (size_t i = 0; i < text.size(); i++) {
+    size_t end = text[i] == '&' ? text.find(';', i) : std::string::npos;
+    if (end == std::string::npos) {
+      out += text[i];
+      continue;
+    }
+    std::string entity = text.substr(i + 1, end - i - 1);
+    if (entity == "amp") {
+      out += '&';
+    }
+    else if (entity == "lt") {
+      out += '<';
+    }
+    else if (entity == "gt") {
+      out += '>';
+    }
+    else if (entity == "quot") {
+      out += '"';
+    }
+    else if (entity == "apos") {
+      out += '\'';
+    }
+    else if (entity.size() > 1 && entity[0] == '#') {
+      appendUtf8(&out, entity[1] == 'x' ? strtoul(entity.c_str() + 2, NULL, 16) : strtoul(entity.c_str() + 1, NULL, 10));
+    }
+    else {
+      out += text.substr(i, end - i + 1);
+    }
+    i = end;
+  }
+  return out;
+}
+
+static std::string attribute(const std::string& tag, const char* name) {
+  std::string key = std::string(" ") + name + "=";
+  size_t at = tag.find(key);
+  if (at == std::string::npos) {
+    return std::string();
+  }
+  at += key.size();
+  char quote = tag[at];
+  size_t end = tag.find(quote, at + 1);
+  return end == std::string::npos ? std::string() : unescapeXml(tag.substr(at + 1, end - at - 1));
+}
+
+// <GroupAddress Name=".." Address="1/2/3" DPTs="DPST-9-1"/> of the ETS
+// export, or the raw address and DatapointType of a project file
+static void parseXml(const std::string& text, std::vector<GroupAddress>* out) {
+  size_t at = 0;
+  while ((at = text.find("<GroupAddress", at)) != std::string::npos) {
+    size_t end = text.find('>', at);
+    if (end == std::string::npos) {
+      break;
+    }
+    std::string tag = text.substr(at, end - at);
+    at = end;
+    if (!isspace((unsigned char) tag[13])) {
+      continue;
+    }
+    for (char& c : tag) {
+      if (isspace((unsigned char) c)) {
+        c = ' ';
+      }
+    }
+    GroupAddress ga;
+    if (!parseAddress(attribute(tag, "Address"), &ga.address)) {
+      continue;
+    }
+    ga.name = attribute(tag, "Name");
+    std::string dpt = attribute(tag, "DPTs");
+    parseDpt(dpt.empty() ? attribute(tag, "DatapointType") : dpt, &ga);
+    out->push_back(ga);
+  }
+}
+
+static std::string identifier(const std::string& prefix, const std::string& name) {
+  std::string id = prefix;
+  for (char c : name) {
+    if (isalnum((unsigned char) c)) {
+      id += toupper((unsigned char) c);
+    }
+    else if (id.back() != '_') {
+      id += '_';
+    }
+  }
+  while (id.size() > prefix.size() && id.back() == '_') {
+    id.pop_back();
+  }
+  return id;
+}
+
+// One literal per name; octal escapes cannot swallow the next character
+static std::string literal(const std::string& name) {
+  std::string out = "\"";
+  for (char c : name) {
+    unsigned char u = c;
+    if (u < 0x20 || u >= 0x7F || c == '"' || c == '\\' || c == '?') {
+      char escape[5];
+      snprintf(escape, sizeof(escape), "\\%03o", u);
+      out += escape;
+    }
+    else {
+      out += c;
+    }
+  }
+  return out + "\\0\"";
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s export.csv|export.xml [table name] [define prefix]\n", argv[0]);
+    return 2;
+  }
+  std::string table = argc > 2 ? argv[2] : "knxGroupAddresses";
+  std::string prefix = argc > 3 ? argv[3] : "GA_";
+
+  std::ifstream file(argv[1], std::ios::binary);
+  if (!file) {
+    fprintf(stderr, "%s: cannot open\n", argv[1]);
+    return 1;
+  }
+  std::stringstream raw;
+  raw << file.rdbuf();
+  std::string text = decode(raw.str());
+
+  std::vector<GroupAddress> gas;
+  size_t start = text.find_first_not_of(" \t\r\n");
+  if (start != std::string::npos && text[start] == '<') {
+    parseXml(text, &gas);
+  }
+  else {
+    parseCsv(text, &gas);
+  }
+  if (gas.empty()) {
+    fprintf(stderr, "%s: no group addresses found\n", argv[1]);
+    return 1;
+  }
+
+  std::stable_sort(gas.begin(), gas.end(),
+                   [](const GroupAddress& a, const GroupAddress& b) { return a.address < b.address; });
+  std::vector<GroupAddress> unique;
+  for (const GroupAddress& ga : gas) {
+    if (!unique.empty() && unique.back().address == ga.address) {
+      fprintf(stderr, "warning: %s listed twice, keeping \"%s\"\n", ga.name.c_str(), unique.back().name.c_str());
+      continue;
+    }
+    unique.push_back(ga);
+  }
+
+  std::vector<uint16_t> byName(unique.size());
+  for (size_t i = 0; i < unique.size(); i++) {
+    byName[i] = i;
+  }
+  // strcmp order, equal names by address, as findName() expects
+  std::stable_sort(byName.begin(), byName.end(), [&](uint16_t a, uint16_t b) {
+    return strcmp(unique[a].name.c_str(), unique[b].name.c_str()) < 0;
+  });
+
+  size_t blob = 0;
+  std::vector<uint16_t> offsets;
+  for (const GroupAddress& ga : unique) {
+    offsets.push_back(blob);
+    blob += ga.name.size() + 1;
+  }
+  if (blob > 65535 || unique.size() > 65535) {
+    fprintf(stderr, "%s: too many names for 16 bit offsets\n", argv[1]);
+    return 1;
+  }
+
+  const char* base = strrchr(argv[1], '/');
+  printf("// Generated by knxgatable from %s, do not edit.\n", base != NULL ? base + 1 : argv[1]);
+  printf("// %zu group addresses, %zu bytes of names.\n\n", unique.size(), blob);
+  printf("#ifndef %s_h\n#define %s_h\n\n#include \"KnxGroupAddressTable.h\"\n\n", table.c_str(), table.c_str());
+
+  std::set<std::string> defined;
+  for (const GroupAddress& ga : unique) {
+    std::string id = identifier(prefix, ga.name);
+    if (id.size() == prefix.size() || !defined.insert(id).second) {
+      printf("// %s: no unique define for \"%s\"\n", id.c_str(), ga.name.c_str());
+      continue;
+    }
+    printf("#define %s 0x%04X // %d/%d/%d", id.c_str(), ga.address, ga.address >> 11, (ga.address >> 8) & 0x07,
+           ga.address & 0xFF);
+    if (ga.dptMain != 0) {
+      printf(" DPT %d.%03d", ga.dptMain, ga.dptSub);
+    }
+    printf("\n");
+  }
+
+  printf("\nstatic const char %sNames[] PROGMEM =\n", table.c_str());
+  for (size_t i = 0; i < unique.size(); i++) {
+    printf("  %s%s\n", literal(unique[i].name).c_str(), i + 1 == unique.size() ? ";" : "");
+  }
+
+  printf("\nstatic const KnxGroupAddressEntry %sEntries[] PROGMEM = {\n", table.c_str());
+  for (size_t i = 0; i < unique.size(); i++) {
+    printf("  { 0x%04X, %u, %u, %u },\n", unique[i].address, offsets[i], unique[i].dptSub, unique[i].dptMain);
+  }
+  printf("};\n\nstatic const uint16_t %sByName[] PROGMEM = {", table.c_str());
+  for (size_t i = 0; i < byName.size(); i++) {
+    printf("%s%u,", i % 16 == 0 ? "\n  " : " ", byName[i]);
+  }
+  printf("\n};\n\n");
+  printf("static KnxGroupAddressTable %s(%sEntries, %sByName, %sNames, %zu);\n\n", table.c_str(), table.c_str(),
+         table.c_str(), table.c_str(), unique.size());
+  printf("#endif\n");
+  return 0;
+}
@@ -0,0 +1,54 @@
+// File: knxipd.cpp
+// KNXnet/IP gateway: routing on the standard multicast group and up to
+// KNX_IP_MAX_TUNNELS tunnelling connections on port 3671.
+//
+//   knxipd /dev/ttyAMA0 [individual address]
+
+// Last modified: 18.10.2026
+
+#include "KnxEventLoop.h"
+#include "KnxIpBridge.h"
+#include "KnxTpUart.h"
+#include "PosixSerial.h"
+
+#include <signal.h>
+#include <stdio.h>
+
+static KnxEventLoop loop;
+
+static void stop(int) {
+  loop.stop();
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s device [individual address]\n", argv[0]);
+    return 2;
+  }
+  PosixSerial serial;
+  if (!serial.begin(argv[1])) {
+    fprintf(stderr, "%s: cannot open\n", argv[1]);
+    return 1;
+  }
+  KnxTpUart knx(&serial, argc > 2 ? argv[2] : "15.15.250");
+  KnxTxQueue queue;
+  knx.setTxQueue(&queue);
+  knx.uartReset();
+
+  KnxIpBridge bridge(&knx, &queue);
+  if (!bridge.beginRouting() || !bridge.beginTunnelling()) {
+    fprintf(stderr, "cannot open the KNXnet/IP sockets\n");
+    return 1;
+  }
+  loop.add(&serial, &knx, NULL);
+  bridge.attach(&loop);
+
+  signal(SIGINT, stop);
+  signal(SIGTERM, stop);
+  loop.run();
+
+  KnxIpStats stats = bridge.getStats();
+  printf("bus to ip %lu, ip to bus %lu, not confirmed %lu, lost %lu\n",
+         stats.busToIp, stats.ipToBus, stats.notConfirmed, stats.routingLost);
+  return 0;
+}
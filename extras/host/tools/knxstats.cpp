@@ -0,0 +1,58 @@
+// File: knxstats.cpp
+// Prints the busiest group addresses and devices of a capture file.
+//
+//   knxstats capture.knxc [count] [threads]
+
+// Last modified: 18.10.2026
+
+#include "KnxCaptureAnalyzer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+static void printStats(const KnxAddressStats& s) {
+  printf("%10u %8u %6.2f%% %8u %8u %8u", s.frames, s.repeats, s.frames ? 100.0 * s.repeats / s.frames : 0.0,
+         s.reads, s.writes, s.answers);
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s capture [count] [threads]\n", argv[0]);
+    return 2;
+  }
+  int count = argc > 2 ? atoi(argv[2]) : 20;
+  int threads = argc > 3 ? atoi(argv[3]) : 0;
+
+  KnxCaptureAnalyzer analyzer;
+  if (!analyzer.open(argv[1])) {
+    fprintf(stderr, "%s: not a capture file\n", argv[1]);
+    return 1;
+  }
+  analyzer.run(threads);
+  printf("%lu frames (%lu sent), %lu ack characters, %lu bad frames\n\n",
+         analyzer.getFrameCount(), analyzer.getTransmitCount(), analyzer.getAckCount(), analyzer.getBadFrameCount());
+
+  std::vector<uint16_t> top(count);
+  int n = analyzer.getTopGroups(top.data(), count);
+  printf("group          frames  repeats            reads   writes  answers  last value\n");
+  for (int i = 0; i < n; i++) {
+    const KnxAddressStats& s = analyzer.getGroupStats(top[i]);
+    printf("%2d/%d/%-3d    ", top[i] >> 11, (top[i] >> 8) & 0x07, top[i] & 0xFF);
+    printStats(s);
+    if (s.lastValueLength > 0) {
+      printf("  0x%0*X", s.lastValueLength * 2, s.lastValue);
+    }
+    printf("\n");
+  }
+
+  n = analyzer.getTopSources(top.data(), count);
+  printf("\nsource         frames  repeats\n");
+  for (int i = 0; i < n; i++) {
+    const KnxAddressStats& s = analyzer.getSourceStats(top[i]);
+    printf("%2d.%d.%-3d    %10u %8u %6.2f%%\n", top[i] >> 12, (top[i] >> 8) & 0x0F, top[i] & 0xFF,
+           s.frames, s.repeats, s.frames ? 100.0 * s.repeats / s.frames : 0.0);
+  }
+  return 0;
+}
@@ -0,0 +1,28 @@
+// File: KnxAes.h
+// AES-128 block encryption for KNX Data Secure. CCM only ever runs the
+// cipher forwards, so there is no decryption. The round keys are expanded
+// once per key and kept (KnxAesKey), encrypting a block then needs no key
+// work at all.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxAes_h
+#define KnxAes_h
+
+#include "Arduino.h"
+
+#define KNX_AES_BLOCK_SIZE 16
+#define KNX_AES_KEY_SIZE 16
+#define KNX_AES_ROUNDS 10
+
+// Expanded key schedule, 176 bytes
+struct KnxAesKey {
+  uint8_t roundKeys[(KNX_AES_ROUNDS + 1) * KNX_AES_BLOCK_SIZE];
+};
+
+void knxAesExpandKey(const uint8_t* key, KnxAesKey* expanded);
+
+// Encrypts block in place
+void knxAesEncrypt(const KnxAesKey* key, uint8_t* block);
+
+#endif
@@ -0,0 +1,94 @@
+// File: KnxCapture.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxCapture.h"
+
+KnxCaptureWriter::KnxCaptureWriter() {
+  _out = NULL;
+  _records = 0;
+}
+
+void KnxCaptureWriter::begin(Print* out) {
+  _out = out;
+  _records = 0;
+
+  uint8_t header[KNX_CAPTURE_HEADER_SIZE] = { 'K', 'N', 'X', 'C', KNX_CAPTURE_VERSION, 0, 0, 0 };
+  _out->write(header, sizeof(header));
+}
+
+void KnxCaptureWriter::write(uint8_t flags, const uint8_t* data, int length, unsigned long timestamp) {
+  if (_out == NULL) {
+    return;
+  }
+  if (length > MAX_KNX_TELEGRAM_SIZE) {
+    length = MAX_KNX_TELEGRAM_SIZE;
+  }
+
+  // One write per record keeps buffered outputs fast
+  uint8_t buffer[KNX_CAPTURE_RECORD_HEADER_SIZE + MAX_KNX_TELEGRAM_SIZE];
+  buffer[0] = timestamp;
+  buffer[1] = timestamp >> 8;
+  buffer[2] = timestamp >> 16;
+  buffer[3] = timestamp >> 24;
+  buffer[4] = flags;
+  buffer[5] = length;
+  for (int i = 0; i < length; i++) {
+    buffer[KNX_CAPTURE_RECORD_HEADER_SIZE + i] = data[i];
+  }
+  _out->write(buffer, KNX_CAPTURE_RECORD_HEADER_SIZE + length);
+  _records++;
+}
+
+void KnxCaptureWriter::write(const KnxMonitorRecord* record) {
+  uint8_t flags = record->type == KNX_MONITOR_ACK ? KNX_CAPTURE_ACK_CHAR : 0;
+  write(flags, record->data, record->length, record->timestamp);
+}
+
+unsigned long KnxCaptureWriter::getRecordCount() {
+  return _records;
+}
+
+KnxCaptureReader::KnxCaptureReader() {
+  _data = NULL;
+  _length = 0;
+  _position = 0;
+}
+
+bool KnxCaptureReader::begin(const uint8_t* data, size_t length) {
+  _data = data;
+  _length = length;
+  _position = KNX_CAPTURE_HEADER_SIZE;
+
+  if (length < KNX_CAPTURE_HEADER_SIZE
+      || data[0] != 'K' || data[1] != 'N' || data[2] != 'X' || data[3] != 'C'
+      || data[4] != KNX_CAPTURE_VERSION) {
+    _length = 0;
+    return false;
+  }
+  return true;
+}
+
+bool KnxCaptureReader::next(KnxCaptureRecord* record) {
+  if (_position + KNX_CAPTURE_RECORD_HEADER_SIZE > _length) {
+    return false;
+  }
+
+  const uint8_t* p = _data + _position;
+  uint8_t length = p[5];
+  if (_position + KNX_CAPTURE_RECORD_HEADER_SIZE + length > _length) {
+    return false;
+  }
+
+  record->timestamp = (unsigned long) p[0] | ((unsigned long) p[1] << 8)
+                      | ((unsigned long) p[2] << 16) | ((unsigned long) p[3] << 24);
+  record->flags = p[4];
+  record->length = length;
+  record->data = p + KNX_CAPTURE_RECORD_HEADER_SIZE;
+  _position += KNX_CAPTURE_RECORD_HEADER_SIZE + length;
+  return true;
+}
+
+void KnxCaptureReader::rewind() {
+  _position = KNX_CAPTURE_HEADER_SIZE;
+}
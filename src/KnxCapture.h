@@ -0,0 +1,73 @@
+// File: KnxCapture.h
+// Binary capture of bus traffic, to reproduce field problems and to feed
+// real traffic into tests and benchmarks.
+//
+// Format, all numbers little endian:
+//   header  "KNXC", version (1), 3 reserved bytes
+//   record  uint32 timestamp (micros()), uint8 flags, uint8 length,
+//           length raw bytes as seen on the bus (frame or ack character)
+// Timestamps wrap after about 71 minutes; only the difference between two
+// consecutive records is meaningful.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxCapture_h
+#define KnxCapture_h
+
+#include "Arduino.h"
+#include "KnxTelegram.h"
+#include "KnxMonitorRing.h"
+
+#define KNX_CAPTURE_VERSION 1
+#define KNX_CAPTURE_HEADER_SIZE 8
+#define KNX_CAPTURE_RECORD_HEADER_SIZE 6
+
+// Record flags
+#define KNX_CAPTURE_TX 0x01             // Sent by us, otherwise received
+#define KNX_CAPTURE_ACK_CHAR 0x02       // Ack character instead of a frame
+#define KNX_CAPTURE_NOT_CONFIRMED 0x04  // Transmit failed
+#define KNX_CAPTURE_ACKNOWLEDGED 0x08   // We acknowledged the received frame
+
+struct KnxCaptureRecord {
+  unsigned long timestamp;
+  uint8_t flags;
+  uint8_t length;
+  const uint8_t* data;  // Points into the capture
+};
+
+// Streams records to any Print (SD file, network, host file)
+class KnxCaptureWriter {
+  public:
+    KnxCaptureWriter();
+
+    // Writes the header
+    void begin(Print* out);
+    void write(uint8_t flags, const uint8_t* data, int length, unsigned long timestamp);
+    // Received records drained from a KnxMonitorRing
+    void write(const KnxMonitorRecord* record);
+
+    unsigned long getRecordCount();
+
+  private:
+    Print* _out;
+    unsigned long _records;
+};
+
+// Walks a capture held in memory without copying
+class KnxCaptureReader {
+  public:
+    KnxCaptureReader();
+
+    // False if the header is missing or of another version
+    bool begin(const uint8_t* data, size_t length);
+    // False at the end of the capture or at a truncated record
+    bool next(KnxCaptureRecord* record);
+    void rewind();
+
+  private:
+    const uint8_t* _data;
+    size_t _length;
+    size_t _position;
+};
+
+#endif
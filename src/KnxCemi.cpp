@@ -0,0 +1,72 @@
+// File: KnxCemi.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxCemi.h"
+
+int knxFrameToCemi(const uint8_t* frame, uint8_t messageCode, uint8_t* out, int size) {
+  int dataLength = frame[5] & 0b00001111;
+  int length = KNX_CEMI_HEADER_SIZE + dataLength;
+  if (size < length) {
+    return 0;
+  }
+
+  out[0] = messageCode;
+  out[1] = 0;
+
+  // Control 1: frame type, repeat flag and priority line up with the TP1
+  // control field; bit 4 (broadcast, not system broadcast) is set on TP1
+  out[2] = frame[0] & 0b10111100;
+
+  // Control 2: address type and hop count, standard frame format
+  out[3] = frame[5] & 0b11110000;
+
+  for (int i = 1; i < 5; i++) {
+    out[3 + i] = frame[i];
+  }
+  out[8] = dataLength;
+  for (int i = 0; i <= dataLength; i++) {
+    out[9 + i] = frame[6 + i];
+  }
+  return length;
+}
+
+int knxCemiToFrame(const uint8_t* cemi, int length, uint8_t* frame) {
+  if (length < KNX_CEMI_HEADER_SIZE - 1 || length < 2) {
+    return 0;
+  }
+  uint8_t code = cemi[0];
+  if (code != KNX_CEMI_LDATA_REQ && code != KNX_CEMI_LDATA_IND && code != KNX_CEMI_LDATA_CON) {
+    return 0;
+  }
+
+  // Skip additional info
+  const uint8_t* p = cemi + 2 + cemi[1];
+  int remaining = length - 2 - cemi[1];
+  if (remaining < 8) {
+    return 0;
+  }
+  int dataLength = p[6];
+  if (dataLength > 15 || remaining < 7 + 1 + dataLength
+      || KNX_TELEGRAM_HEADER_SIZE + 1 + dataLength + 1 > MAX_KNX_TELEGRAM_SIZE) {
+    return 0;
+  }
+
+  // Standard frame, priority and repeat flag from control 1
+  frame[0] = 0b10010000 | (p[0] & 0b00101100);
+  for (int i = 1; i < 5; i++) {
+    frame[i] = p[i + 1];
+  }
+  frame[5] = (p[1] & 0b11110000) | dataLength;
+  for (int i = 0; i <= dataLength; i++) {
+    frame[6 + i] = p[7 + i];
+  }
+
+  int frameLength = KNX_TELEGRAM_HEADER_SIZE + 1 + dataLength + 1;
+  uint8_t checksum = 0xFF;
+  for (int i = 0; i < frameLength - 1; i++) {
+    checksum ^= frame[i];
+  }
+  frame[frameLength - 1] = checksum;
+  return frameLength;
+}
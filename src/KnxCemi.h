@@ -0,0 +1,40 @@
+// File: KnxCemi.h
+// Conversion between TP1 standard frames and cEMI L_Data messages (as
+// carried by KNXnet/IP and USB interfaces), straight from one buffer into
+// the other. cEMI layout without additional info:
+//
+//   message code, 0 (additional info length), control 1, control 2,
+//   source (2), destination (2), length, TPCI, APCI + data (length bytes)
+
+// Last modified: 18.10.2026
+
+#ifndef KnxCemi_h
+#define KnxCemi_h
+
+#include "Arduino.h"
+
+#include "KnxTelegram.h"
+
+// cEMI message codes
+#define KNX_CEMI_LDATA_REQ 0x11
+#define KNX_CEMI_LDATA_CON 0x2E
+#define KNX_CEMI_LDATA_IND 0x29
+
+#define KNX_CEMI_HEADER_SIZE 10
+
+// Largest cEMI L_Data message for a TP1 standard frame
+#define KNX_CEMI_MAX_SIZE (KNX_CEMI_HEADER_SIZE + MAX_KNX_TELEGRAM_SIZE - KNX_TELEGRAM_HEADER_SIZE - 2)
+
+// Confirm flag in control 1 of L_Data.con: set if the frame was not sent
+#define KNX_CEMI_CONFIRM_ERROR 0x01
+
+// Writes the frame as cEMI message with the given code into out. Returns
+// the cEMI length, or 0 if size is too small.
+int knxFrameToCemi(const uint8_t* frame, uint8_t messageCode, uint8_t* out, int size);
+
+// Writes the L_Data message in cemi as TP1 frame with checksum into frame
+// (MAX_KNX_TELEGRAM_SIZE bytes). Returns the frame length, or 0 if it is
+// no L_Data message or does not fit into a standard frame.
+int knxCemiToFrame(const uint8_t* cemi, int length, uint8_t* frame);
+
+#endif
@@ -0,0 +1,14 @@
+// File: KnxConfig.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxConfig.h"
+
+uint16_t knxConfigCrcUpdate(uint16_t crc, uint8_t data) {
+  // Bitwise, no table: the blob is small and flash is scarce on AVR
+  crc ^= (uint16_t) data << 8;
+  for (int i = 0; i < 8; i++) {
+    crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
@@ -0,0 +1,35 @@
+// File: KnxConfig.h
+// Binary configuration blob of KnxTpUart (saveConfig() / loadConfig()),
+// to be kept in EEPROM, flash or a file instead of parsing address strings
+// at every start. All numbers little endian:
+//
+//   'K' 'C'         magic
+//   version         KNX_CONFIG_VERSION
+//   length          uint16, whole blob including the CRC
+//   address         uint16, individual address
+//   flags           KNX_CONFIG_BROADCASTS
+//   tx interval     uint16, ms
+//   count           uint8, listen table entries
+//   table           count x uint16 group addresses, ascending
+//   crc             uint16, CRC-16/CCITT-FALSE over everything before
+
+// Last modified: 18.10.2026
+
+#ifndef KnxConfig_h
+#define KnxConfig_h
+
+#include "Arduino.h"
+
+#define KNX_CONFIG_VERSION 1
+#define KNX_CONFIG_HEADER_SIZE 11
+#define KNX_CONFIG_SIZE(count) (KNX_CONFIG_HEADER_SIZE + 2 * (count) + 2)
+
+// Flags
+#define KNX_CONFIG_BROADCASTS 0x01
+
+// Reads one byte of the blob, e.g. from EEPROM
+typedef uint8_t (*KnxConfigReadByte)(int address);
+
+uint16_t knxConfigCrcUpdate(uint16_t crc, uint8_t data);
+
+#endif
@@ -0,0 +1,284 @@
+// File: KnxCoupler.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxCoupler.h"
+#include "KnxCriticalSection.h"
+#include "KnxTpUart.h"
+
+#if KNX_FEATURE_COUPLER
+
+#define ROUTE_NONE -1
+#define ROUTE_ALL -2
+
+// History entry of a frame received on the line, not sent by us
+#define HISTORY_RECEIVED 8
+
+KnxCoupler::KnxCoupler() {
+  _port_count = 0;
+  _main_port = -1;
+  _filter_count = 0;
+  _pass_all_groups = false;
+}
+
+int KnxCoupler::addPort(KnxTpUart* knx, KnxTxQueue* queue, String line) {
+  if (_port_count >= MAX_COUPLER_PORTS) {
+    return -1;
+  }
+
+  int area = line.substring(0, line.indexOf('.')).toInt();
+  int lineNumber = line.substring(line.indexOf('.') + 1, line.length()).toInt();
+
+  int port = _port_count++;
+  KnxCouplerPort* p = &_ports[port];
+  p->knx = knx;
+  p->queue = queue;
+  p->line = ((area & 0x0F) << 4) | (lineNumber & 0x0F);
+  for (int i = 0; i < COUPLER_HISTORY_SIZE; i++) {
+    p->history[i].time = 0;
+    p->history[i].signature = 0;
+    p->history[i].counter = 0;
+  }
+  p->next_history = 0;
+  memset(&p->stats, 0, sizeof(p->stats));
+
+  // Paced by the confirmations of the TP-UART only, at full bus rate
+  knx->setTxQueue(queue);
+  knx->setTxInterval(0);
+  knx->setCoupler(this, port);
+  return port;
+}
+
+void KnxCoupler::setMainPort(int port) {
+  _main_port = port;
+}
+
+void KnxCoupler::addFilterGroupAddress(String address) {
+  addFilterGroupAddress(KnxTpUart::groupAddressFromString(address));
+}
+
+void KnxCoupler::addFilterGroupAddress(uint16_t address) {
+  if (_filter_count >= MAX_COUPLER_FILTER_ADDRESSES) {
+#if defined(TPUART_DEBUG)
+    TPUART_DEBUG_PORT.println("Already MAX_COUPLER_FILTER_ADDRESSES in the filter table, cannot add another");
+#endif
+    return;
+  }
+
+  // Keep the table sorted for isInFilter()
+  int i = _filter_count;
+  while (i > 0 && _filter[i - 1] > address) {
+    i--;
+  }
+  if (i > 0 && _filter[i - 1] == address) {
+    return;
+  }
+  for (int j = _filter_count; j > i; j--) {
+    _filter[j] = _filter[j - 1];
+  }
+  _filter[i] = address;
+  _filter_count++;
+}
+
+bool KnxCoupler::isInFilter(uint16_t address) {
+  int low = 0;
+  int high = _filter_count - 1;
+  while (low <= high) {
+    int mid = (low + high) / 2;
+    if (_filter[mid] == address) {
+      return true;
+    }
+    else if (_filter[mid] < address) {
+      low = mid + 1;
+    }
+    else {
+      high = mid - 1;
+    }
+  }
+
+  return false;
+}
+
+void KnxCoupler::setPassAllGroups(bool pass) {
+  _pass_all_groups = pass;
+}
+
+void KnxCoupler::poll() {
+  for (int i = 0; i < _port_count; i++) {
+    _ports[i].knx->processTxQueue();
+  }
+}
+
+KnxCouplerStats KnxCoupler::getStats(int port) {
+  KnxCriticalSection lock;
+  return _ports[port].stats;
+}
+
+void KnxCoupler::resetStats() {
+  KnxCriticalSection lock;
+  for (int i = 0; i < _port_count; i++) {
+    memset(&_ports[i].stats, 0, sizeof(_ports[i].stats));
+  }
+}
+
+KnxCouplerAcceptance KnxCoupler::accepts(int port, const uint8_t* header) {
+  // Acknowledged on the line if it leaves the line
+  int to = KnxTelegramView(header).getRoutingCounter() != 0 ? route(port, header) : ROUTE_NONE;
+  if (to == ROUTE_NONE) {
+    return KNX_COUPLER_IGNORE;
+  }
+
+  // Never acknowledge a frame that cannot be queued, the sender would not
+  // repeat it
+  if (!hasRoom(port, to)) {
+    _ports[port].stats.busy++;
+    return KNX_COUPLER_BUSY;
+  }
+  return KNX_COUPLER_ACCEPT;
+}
+
+bool KnxCoupler::hasRoom(int from, int to) {
+  for (int i = 0; i < _port_count; i++) {
+    if ((to == ROUTE_ALL ? i != from : i == to) && _ports[i].queue->size() >= TPUART_TX_QUEUE_SIZE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void KnxCoupler::received(int port, const uint8_t* frame) {
+  KnxCouplerPort* in = &_ports[port];
+  KnxTelegramView view(frame);
+  if (!view.verifyChecksum()) {
+    return;
+  }
+  in->stats.received++;
+
+  int to = route(port, frame);
+  if (to == ROUTE_NONE) {
+    in->stats.filtered++;
+    return;
+  }
+  int counter = view.getRoutingCounter();
+  if (counter == 0) {
+    in->stats.expired++;
+    return;
+  }
+
+  uint32_t sig = signature(frame, view.getTotalLength());
+  {
+    KnxCriticalSection lock;
+    if (inHistory(in, sig, view.isRepeated() ? HISTORY_RECEIVED : counter)) {
+      in->stats.echoes++;
+      return;
+    }
+    if (!hasRoom(port, to)) {
+      // Answered busy by accepts(). Not remembered, so the repetition of
+      // the sender is forwarded once there is room.
+      in->stats.dropped++;
+      return;
+    }
+    remember(in, sig, HISTORY_RECEIVED);
+  }
+
+  KnxTelegram tg;
+  for (int i = 0; i < view.getTotalLength(); i++) {
+    tg.setBufferByte(i, frame[i]);
+  }
+  tg.setRepeated(false);
+  if (counter != 7) {
+    // 7 means unlimited
+    tg.setRoutingCounter(counter - 1);
+  }
+  tg.createChecksum();
+
+  if (to != ROUTE_ALL) {
+    forward(port, to, &tg);
+    return;
+  }
+  for (int i = 0; i < _port_count; i++) {
+    if (i != port) {
+      forward(port, i, &tg);
+    }
+  }
+}
+
+int KnxCoupler::route(int port, const uint8_t* header) {
+  KnxTelegramView view(header);
+  uint16_t target = view.getTargetAddress();
+  if (view.isTargetGroup()) {
+    // Broadcasts always pass
+    if (target == 0 || _pass_all_groups || isInFilter(target)) {
+      return ROUTE_ALL;
+    }
+    return ROUTE_NONE;
+  }
+
+  uint8_t line = target >> 8;
+  if (line == _ports[port].line) {
+    return ROUTE_NONE;
+  }
+  for (int i = 0; i < _port_count; i++) {
+    if (_ports[i].line == line) {
+      return i;
+    }
+  }
+  if (_main_port >= 0 && _main_port != port) {
+    return _main_port;
+  }
+  return ROUTE_NONE;
+}
+
+void KnxCoupler::forward(int from, int to, KnxTelegram* tg) {
+  KnxCouplerPort* out = &_ports[to];
+  if (!out->queue->push(tg)) {
+    _ports[from].stats.dropped++;
+    return;
+  }
+  _ports[from].stats.forwarded++;
+
+  KnxCriticalSection lock;
+  remember(out, signature(tg->getBuffer(), tg->getTotalLength()), tg->getRoutingCounter());
+}
+
+uint32_t KnxCoupler::signature(const uint8_t* frame, int length) {
+  // FNV-1a over the frame without repeat flag, routing counter and checksum
+  uint32_t hash = 2166136261u;
+  for (int i = 0; i < length - 1; i++) {
+    uint8_t b = frame[i];
+    if (i == 0) {
+      b &= 0b11011111;
+    }
+    else if (i == 5) {
+      b &= 0b10001111;
+    }
+    hash = (hash ^ b) * 16777619u;
+  }
+  return hash;
+}
+
+bool KnxCoupler::inHistory(KnxCouplerPort* port, uint32_t sig, int counter) {
+  // A repetition matches a received frame, an echo a frame we sent to
+  // the line that came back through another coupler with no higher counter
+  unsigned long now = millis();
+  for (int i = 0; i < COUPLER_HISTORY_SIZE; i++) {
+    KnxCouplerHistory* h = &port->history[i];
+    if (h->signature != sig || now - h->time >= COUPLER_HISTORY_MS) {
+      continue;
+    }
+    if (counter == HISTORY_RECEIVED ? h->counter == HISTORY_RECEIVED : (h->counter != HISTORY_RECEIVED && counter <= h->counter)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void KnxCoupler::remember(KnxCouplerPort* port, uint32_t sig, int counter) {
+  KnxCouplerHistory* h = &port->history[port->next_history];
+  h->signature = sig;
+  h->time = millis();
+  h->counter = counter;
+  port->next_history = (port->next_history + 1) % COUPLER_HISTORY_SIZE;
+}
+
+#endif
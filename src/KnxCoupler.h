@@ -0,0 +1,119 @@
+// File: KnxCoupler.h
+// Line coupler / router between two or more KnxTpUart instances, each on
+// its own line. Group telegrams pass if their address is in the filter
+// table, individual telegrams are routed by the area/line of their target,
+// and the routing counter is decremented on the way (7 passes unchanged,
+// 0 is not forwarded). Frames are acknowledged on the receiving line and
+// pushed into the transmit queue of each outgoing line, so every line
+// sends at its own pace. When an outgoing queue is full the frame is
+// answered busy instead, and the sender repeats it. A short history per
+// line drops echoes of frames we forwarded there and repetitions of frames
+// already forwarded.
+//
+// Each line may be served by its own task (serialEvent() and
+// processTxQueue()), or all from one loop with poll().
+
+// Last modified: 18.10.2026
+
+#ifndef KnxCoupler_h
+#define KnxCoupler_h
+
+#include "Arduino.h"
+
+#include "KnxTelegram.h"
+#include "KnxTxQueue.h"
+
+class KnxTpUart;
+
+// Number of lines
+#ifndef MAX_COUPLER_PORTS
+#define MAX_COUPLER_PORTS 2
+#endif
+
+// Group addresses in the filter table
+#ifndef MAX_COUPLER_FILTER_ADDRESSES
+#define MAX_COUPLER_FILTER_ADDRESSES 128
+#endif
+
+// Frames remembered per line to recognise echoes and repetitions
+#define COUPLER_HISTORY_SIZE 8
+
+// An identical frame within this time may be an echo or a repetition
+#define COUPLER_HISTORY_MS 1000
+
+// Counters of the frames received on one line, i.e. of one direction
+struct KnxCouplerStats {
+  unsigned long received;    // Complete frames with a valid checksum
+  unsigned long forwarded;   // Queued for another line (once per line)
+  unsigned long filtered;    // Not in the filter table or no route
+  unsigned long expired;     // Routing counter 0
+  unsigned long echoes;      // Echoes and repetitions
+  unsigned long busy;        // Answered busy, transmit queue of the other line full
+  unsigned long dropped;     // Transmit queue of the other line full
+};
+
+// How a frame arriving on a line is acknowledged for the coupler
+enum KnxCouplerAcceptance {
+  KNX_COUPLER_IGNORE,   // Stays on the line
+  KNX_COUPLER_ACCEPT,   // Acknowledged, it is forwarded
+  KNX_COUPLER_BUSY      // Would leave the line, but a transmit queue is full
+};
+
+struct KnxCouplerHistory {
+  uint32_t signature;
+  unsigned long time;
+  uint8_t counter;   // Routing counter as sent, 8 for a received frame
+};
+
+struct KnxCouplerPort {
+  KnxTpUart* knx;
+  KnxTxQueue* queue;
+  uint8_t line;       // Area and line, high byte of the individual addresses
+  KnxCouplerHistory history[COUPLER_HISTORY_SIZE];
+  uint8_t next_history;
+  KnxCouplerStats stats;
+};
+
+class KnxCoupler {
+  public:
+    KnxCoupler();
+
+    // The line as "area.line". The KnxTpUart gets the queue and sends
+    // without pause between frames. Returns the port number or -1.
+    int addPort(KnxTpUart*, KnxTxQueue*, String line);
+    // Individual telegrams to lines without a port go to this line
+    void setMainPort(int port);
+
+    void addFilterGroupAddress(String);
+    void addFilterGroupAddress(uint16_t);
+    bool isInFilter(uint16_t);
+    // Forward all group telegrams, ignoring the filter table
+    void setPassAllGroups(bool);
+
+    // Sends the queued frames of all lines, for single task operation
+    void poll();
+
+    KnxCouplerStats getStats(int port);
+    void resetStats();
+
+    // From the KnxTpUart receive path
+    KnxCouplerAcceptance accepts(int port, const uint8_t* header);
+    void received(int port, const uint8_t* frame);
+
+  private:
+    KnxCouplerPort _ports[MAX_COUPLER_PORTS];
+    int _port_count;
+    int _main_port;
+    uint16_t _filter[MAX_COUPLER_FILTER_ADDRESSES];  // sorted
+    int _filter_count;
+    bool _pass_all_groups;
+
+    int route(int port, const uint8_t* header);
+    bool hasRoom(int from, int to);
+    void forward(int from, int to, KnxTelegram*);
+    static uint32_t signature(const uint8_t* frame, int length);
+    bool inHistory(KnxCouplerPort*, uint32_t, int counter);
+    void remember(KnxCouplerPort*, uint32_t, int counter);
+};
+
+#endif
@@ -0,0 +1,77 @@
+// File: KnxCriticalSection.h
+// Short critical sections shared by producers, interrupt handlers and the
+// drainer. Keep the guarded code to a few instructions.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxCriticalSection_h
+#define KnxCriticalSection_h
+
+#include "Arduino.h"
+
+// Orders the data written to a lock-free buffer before the index that
+// publishes it. On AVR a compiler barrier is enough (single core, no caches).
+#if defined(__AVR__)
+#define KNX_MEMORY_BARRIER() __asm__ __volatile__("" ::: "memory")
+#else
+#define KNX_MEMORY_BARRIER() __sync_synchronize()
+#endif
+
+#if defined(ARDUINO_ARCH_ESP32)
+// Spinlock, works across both cores and from interrupt handlers
+extern portMUX_TYPE knxCriticalMux;
+#endif
+
+class KnxCriticalSection {
+  public:
+#if defined(ARDUINO_ARCH_ESP32)
+    KnxCriticalSection() {
+      portENTER_CRITICAL_SAFE(&knxCriticalMux);
+    }
+    ~KnxCriticalSection() {
+      portEXIT_CRITICAL_SAFE(&knxCriticalMux);
+    }
+#elif defined(__AVR__)
+    // Restore the previous interrupt state so we can nest and be used from ISRs
+    KnxCriticalSection() {
+      _sreg = SREG;
+      cli();
+    }
+    ~KnxCriticalSection() {
+      SREG = _sreg;
+    }
+  private:
+    uint8_t _sreg;
+#elif defined(__arm__) && defined(__ARM_ARCH_PROFILE) && __ARM_ARCH_PROFILE == 'M'
+    // Cortex-M (SAMD, STM32, RP2040, nRF52): the same with PRIMASK
+    KnxCriticalSection() {
+      __asm__ __volatile__("mrs %0, primask" : "=r" (_primask) :: "memory");
+      __asm__ __volatile__("cpsid i" ::: "memory");
+    }
+    ~KnxCriticalSection() {
+      __asm__ __volatile__("msr primask, %0" :: "r" (_primask) : "memory");
+    }
+  private:
+    uint32_t _primask;
+#elif defined(ARDUINO_ARCH_ESP8266)
+    // The same with the interrupt level in PS
+    KnxCriticalSection() {
+      _ps = xt_rsil(15);
+    }
+    ~KnxCriticalSection() {
+      xt_wsr_ps(_ps);
+    }
+  private:
+    uint32_t _ps;
+#else
+    // Does not nest, interrupts are enabled again on leaving
+    KnxCriticalSection() {
+      noInterrupts();
+    }
+    ~KnxCriticalSection() {
+      interrupts();
+    }
+#endif
+};
+
+#endif
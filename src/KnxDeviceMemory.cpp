@@ -0,0 +1,252 @@
+// File: KnxDeviceMemory.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxDeviceMemory.h"
+
+KnxDeviceMemory::KnxDeviceMemory(uint8_t* image, uint16_t size, uint16_t base) {
+  _image = image;
+  // Only as much as the dirty bitmap covers
+  if (size > (uint16_t) DEVICE_MEMORY_BLOCK_SIZE * DEVICE_MEMORY_MAX_BLOCKS) {
+    size = (uint16_t) DEVICE_MEMORY_BLOCK_SIZE * DEVICE_MEMORY_MAX_BLOCKS;
+  }
+  _size = size;
+  _base = base;
+  _properties = NULL;
+  _property_count = 0;
+  _flush = NULL;
+  _flush_delay = DEVICE_MEMORY_FLUSH_DELAY_MS;
+  _last_write = 0;
+  _flush_count = 0;
+  for (unsigned int i = 0; i < sizeof(_dirty); i++) {
+    _dirty[i] = 0;
+  }
+}
+
+void KnxDeviceMemory::setProperties(const KnxProperty* properties, int count) {
+  _properties = properties;
+  _property_count = count;
+}
+
+void KnxDeviceMemory::setFlushCallback(KnxMemoryFlushCallback callback) {
+  _flush = callback;
+}
+
+void KnxDeviceMemory::setFlushDelay(unsigned long delay) {
+  _flush_delay = delay;
+}
+
+KnxServiceResult KnxDeviceMemory::handle(KnxTelegram* request, KnxTelegram* response) {
+  if (request->isTargetGroup()) {
+    return KNX_SERVICE_IGNORED;
+  }
+
+  switch (request->getCommand()) {
+    case KNX_COMMAND_MEMORY_READ:
+      return memoryRead(request, response);
+    case KNX_COMMAND_MEMORY_WRITE:
+      return memoryWrite(request);
+    case KNX_COMMAND_ESCAPE:
+      if (request->getFirstDataByte() == KNX_EXT_COMMAND_PROPERTY_VALUE_READ) {
+        return propertyValue(request, response, false);
+      }
+      if (request->getFirstDataByte() == KNX_EXT_COMMAND_PROPERTY_VALUE_WRITE) {
+        return propertyValue(request, response, true);
+      }
+      return KNX_SERVICE_IGNORED;
+    default:
+      return KNX_SERVICE_IGNORED;
+  }
+}
+
+KnxServiceResult KnxDeviceMemory::memoryRead(KnxTelegram* request, KnxTelegram* response) {
+  int count = request->getFirstDataByte();
+  unsigned int address = ((unsigned int) request->getBufferByte(8) << 8) | request->getBufferByte(9);
+
+  // A response without data tells the client the range is not readable
+  if (count > KNX_MEMORY_MAX_DATA || address < _base || address + count > (unsigned long) _base + _size) {
+    count = 0;
+  }
+
+  startResponse(request, response);
+  response->setCommand(KNX_COMMAND_MEMORY_RESPONSE);
+  response->setFirstDataByte(count);
+  response->setPayloadLength(4 + count);
+  response->setBufferByte(8, address >> 8);
+  response->setBufferByte(9, address & 0xFF);
+  const uint8_t* data = _image + (address - _base);
+  for (int i = 0; i < count; i++) {
+    response->setBufferByte(10 + i, data[i]);
+  }
+  response->createChecksum();
+  return KNX_SERVICE_RESPOND;
+}
+
+KnxServiceResult KnxDeviceMemory::memoryWrite(KnxTelegram* request) {
+  int count = request->getFirstDataByte();
+  unsigned int address = ((unsigned int) request->getBufferByte(8) << 8) | request->getBufferByte(9);
+
+  if (count > request->getPayloadLength() - 4 || address < _base || address + count > (unsigned long) _base + _size) {
+    return KNX_SERVICE_DONE;
+  }
+
+  uint16_t offset = address - _base;
+  for (int i = 0; i < count; i++) {
+    _image[offset + i] = request->getBufferByte(10 + i);
+  }
+  markDirty(offset, count);
+  return KNX_SERVICE_DONE;
+}
+
+KnxServiceResult KnxDeviceMemory::propertyValue(KnxTelegram* request, KnxTelegram* response, bool write) {
+  int objectIndex = request->getBufferByte(8);
+  int id = request->getBufferByte(9);
+  int count = request->getBufferByte(10) >> 4;
+  unsigned int start = ((unsigned int) (request->getBufferByte(10) & 0x0F) << 8) | request->getBufferByte(11);
+
+  const KnxProperty* property = findProperty(objectIndex, id);
+  int length = 0;
+  const uint8_t* data = NULL;
+  uint8_t elements[2];
+
+  if (property == NULL || count == 0) {
+    count = 0;
+  }
+  else if (start == 0) {
+    // Element 0 is the number of elements
+    if (write || count != 1) {
+      count = 0;
+    }
+    else {
+      elements[0] = property->elements >> 8;
+      elements[1] = property->elements & 0xFF;
+      data = elements;
+      length = 2;
+    }
+  }
+  else if (start + count - 1 > property->elements || count * property->elementSize > KNX_PROPERTY_MAX_DATA) {
+    count = 0;
+  }
+  else {
+    uint16_t offset = property->offset + (start - 1) * property->elementSize;
+    length = count * property->elementSize;
+    if (write) {
+      if (!(property->flags & KNX_PROPERTY_WRITABLE) || request->getPayloadLength() - 6 < length) {
+        count = 0;
+        length = 0;
+      }
+      else {
+        for (int i = 0; i < length; i++) {
+          _image[offset + i] = request->getBufferByte(12 + i);
+        }
+        markDirty(offset, length);
+      }
+    }
+    data = _image + offset;
+  }
+  if (count == 0) {
+    length = 0;
+  }
+
+  // Also the answer to a write, with the value now stored
+  startResponse(request, response);
+  response->setCommand(KNX_COMMAND_ESCAPE);
+  response->setFirstDataByte(KNX_EXT_COMMAND_PROPERTY_VALUE_RESPONSE);
+  response->setPayloadLength(6 + length);
+  response->setBufferByte(8, objectIndex);
+  response->setBufferByte(9, id);
+  response->setBufferByte(10, (count << 4) | (start >> 8));
+  response->setBufferByte(11, start & 0xFF);
+  for (int i = 0; i < length; i++) {
+    response->setBufferByte(12 + i, data[i]);
+  }
+  response->createChecksum();
+  return KNX_SERVICE_RESPOND;
+}
+
+const KnxProperty* KnxDeviceMemory::findProperty(int objectIndex, int id) {
+  for (int i = 0; i < _property_count; i++) {
+    if (_properties[i].objectIndex == objectIndex && _properties[i].id == id) {
+      return &_properties[i];
+    }
+  }
+  return NULL;
+}
+
+void KnxDeviceMemory::startResponse(KnxTelegram* request, KnxTelegram* response) {
+  response->clear();
+  response->setPriority(request->getPriority());
+  response->setSourceAddress(request->getTargetArea(), request->getTargetLine(), request->getTargetMember());
+  response->setTargetIndividualAddress(request->getSourceArea(), request->getSourceLine(), request->getSourceMember());
+  if (request->getCommunicationType() == KNX_COMM_NDP) {
+    // The transport fills in its sequence number
+    response->setCommunicationType(KNX_COMM_NDP);
+  }
+}
+
+void KnxDeviceMemory::markDirty(uint16_t offset, uint16_t length) {
+  if (length == 0) {
+    return;
+  }
+  for (unsigned int block = offset / DEVICE_MEMORY_BLOCK_SIZE; block <= (unsigned int) (offset + length - 1) / DEVICE_MEMORY_BLOCK_SIZE; block++) {
+    _dirty[block >> 3] |= 1 << (block & 7);
+  }
+  _last_write = millis();
+}
+
+void KnxDeviceMemory::poll() {
+  if (isDirty() && (millis() - _last_write) >= _flush_delay) {
+    flush();
+  }
+}
+
+bool KnxDeviceMemory::flush() {
+  unsigned int blocks = (_size + DEVICE_MEMORY_BLOCK_SIZE - 1) / DEVICE_MEMORY_BLOCK_SIZE;
+  unsigned int block = 0;
+  while (block < blocks) {
+    if (!(_dirty[block >> 3] & (1 << (block & 7)))) {
+      block++;
+      continue;
+    }
+
+    // Coalesce the run of dirty blocks into one write
+    unsigned int end = block + 1;
+    while (end < blocks && (_dirty[end >> 3] & (1 << (end & 7)))) {
+      end++;
+    }
+    uint16_t offset = block * DEVICE_MEMORY_BLOCK_SIZE;
+    uint16_t length = end * DEVICE_MEMORY_BLOCK_SIZE > _size ? _size - offset : (end - block) * DEVICE_MEMORY_BLOCK_SIZE;
+    if (_flush != NULL) {
+      if (!_flush(offset, _image + offset, length)) {
+        return false;
+      }
+      _flush_count++;
+    }
+    for (unsigned int i = block; i < end; i++) {
+      _dirty[i >> 3] &= ~(1 << (i & 7));
+    }
+    block = end;
+  }
+  return true;
+}
+
+bool KnxDeviceMemory::isDirty() {
+  for (unsigned int i = 0; i < sizeof(_dirty); i++) {
+    if (_dirty[i] != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+unsigned long KnxDeviceMemory::getFlushCount() {
+  return _flush_count;
+}
+
+uint8_t* KnxDeviceMemory::getImage() {
+  return _image;
+}
+
+uint16_t KnxDeviceMemory::getSize() {
+  return _size;
+}
@@ -0,0 +1,97 @@
+// File: KnxDeviceMemory.h
+// Memory and property services (MemoryRead/Write, PropertyValueRead/Write)
+// on a contiguous device image in RAM, so a device can be configured by
+// download. Responses are filled straight from the image into the frame.
+// Writes only mark blocks dirty; the blocks are written to flash/EEPROM
+// by the flush callback once the download went quiet, adjacent dirty
+// blocks in one call.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxDeviceMemory_h
+#define KnxDeviceMemory_h
+
+#include "Arduino.h"
+
+#include "KnxTelegram.h"
+
+// Granularity of the dirty tracking, ideally the EEPROM/flash page size
+#ifndef DEVICE_MEMORY_BLOCK_SIZE
+#define DEVICE_MEMORY_BLOCK_SIZE 32
+#endif
+
+// Largest image is DEVICE_MEMORY_BLOCK_SIZE * DEVICE_MEMORY_MAX_BLOCKS
+#ifndef DEVICE_MEMORY_MAX_BLOCKS
+#define DEVICE_MEMORY_MAX_BLOCKS 64
+#endif
+
+// Flush this long after the last write
+#define DEVICE_MEMORY_FLUSH_DELAY_MS 2000
+
+// Most bytes one MemoryResponse / PropertyValueResponse can carry
+#define KNX_MEMORY_MAX_DATA 12
+#define KNX_PROPERTY_MAX_DATA 10
+
+#define KNX_PROPERTY_WRITABLE 0x01
+
+// A property value array stored in the image
+struct KnxProperty {
+  uint8_t objectIndex;
+  uint8_t id;
+  uint8_t flags;
+  uint8_t elementSize;
+  uint16_t elements;
+  uint16_t offset;  // Into the image
+};
+
+enum KnxServiceResult {
+  KNX_SERVICE_IGNORED,  // Not a memory or property service
+  KNX_SERVICE_DONE,     // Handled, nothing to send
+  KNX_SERVICE_RESPOND   // Handled, send the response
+};
+
+// Writes length bytes of the image at offset, returns false to retry later
+typedef bool (*KnxMemoryFlushCallback)(uint16_t offset, const uint8_t* data, uint16_t length);
+
+class KnxDeviceMemory {
+  public:
+    // The image is mapped to the memory addresses base ... base + size - 1
+    KnxDeviceMemory(uint8_t* image, uint16_t size, uint16_t base = 0);
+
+    void setProperties(const KnxProperty* properties, int count);
+    void setFlushCallback(KnxMemoryFlushCallback);
+    void setFlushDelay(unsigned long);
+
+    // Builds the response (addressed back to the requester) if one is due
+    KnxServiceResult handle(KnxTelegram* request, KnxTelegram* response);
+
+    // Call from loop(), flushes once the writes stopped
+    void poll();
+    bool flush();
+    bool isDirty();
+    unsigned long getFlushCount();  // Flush callback calls
+
+    uint8_t* getImage();
+    uint16_t getSize();
+
+  private:
+    uint8_t* _image;
+    uint16_t _size;
+    uint16_t _base;
+    const KnxProperty* _properties;
+    int _property_count;
+    KnxMemoryFlushCallback _flush;
+    unsigned long _flush_delay;
+    unsigned long _last_write;
+    unsigned long _flush_count;
+    uint8_t _dirty[(DEVICE_MEMORY_MAX_BLOCKS + 7) / 8];
+
+    KnxServiceResult memoryRead(KnxTelegram* request, KnxTelegram* response);
+    KnxServiceResult memoryWrite(KnxTelegram* request);
+    KnxServiceResult propertyValue(KnxTelegram* request, KnxTelegram* response, bool write);
+    const KnxProperty* findProperty(int objectIndex, int id);
+    void markDirty(uint16_t offset, uint16_t length);
+    void startResponse(KnxTelegram* request, KnxTelegram* response);
+};
+
+#endif
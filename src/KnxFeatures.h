@@ -0,0 +1,80 @@
+// File: KnxFeatures.h
+// Compile time selection of the KnxTpUart features. Everything is enabled
+// by default; a sketch that does not need a feature sets it to 0 in the
+// build flags (platformio.ini build_flags, arduino-cli --build-property)
+// or here, and neither its code nor its members are compiled. Calling a
+// disabled function is a compile error, not a silent no-op.
+//
+// extras/host/sizes/size_matrix.sh prints flash and RAM for several
+// combinations.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxFeatures_h
+#define KnxFeatures_h
+
+// groupWrite*() / groupAnswer*() and KnxTelegram codecs for the DPTs
+// wider than 2 bytes except 4 byte float: time, date, color, counters,
+// RGBW, xyY, date time and 14 byte text
+#ifndef KNX_FEATURE_DPT_EXTENDED
+#define KNX_FEATURE_DPT_EXTENDED 1
+#endif
+
+// groupReadAsync() and its MAX_PENDING_GROUP_READS answer slots, needed
+// by KnxStateSync
+#ifndef KNX_FEATURE_ASYNC_READ
+#define KNX_FEATURE_ASYNC_READ 1
+#endif
+
+// Receive strategy: with 1 setRxRing() can switch from polling the Stream
+// to a KnxRxRing filled by the UART interrupt, with 0 only the Stream is
+// polled
+#ifndef KNX_FEATURE_RX_RING
+#define KNX_FEATURE_RX_RING 1
+#endif
+
+// setTxQueue() and processTxQueue()
+#ifndef KNX_FEATURE_TX_QUEUE
+#define KNX_FEATURE_TX_QUEUE 1
+#endif
+
+// setSecure(), KNX Data Secure
+#ifndef KNX_FEATURE_SECURE
+#define KNX_FEATURE_SECURE 1
+#endif
+
+// setTransport() and setDeviceMemory(), point-to-point connections and
+// memory and property services for ETS
+#ifndef KNX_FEATURE_DEVICE_SERVICES
+#define KNX_FEATURE_DEVICE_SERVICES 1
+#endif
+
+// setVirtualDevices()
+#ifndef KNX_FEATURE_VIRTUAL_DEVICES
+#define KNX_FEATURE_VIRTUAL_DEVICES 1
+#endif
+
+// KnxCoupler, needs the transmit queue
+#ifndef KNX_FEATURE_COUPLER
+#define KNX_FEATURE_COUPLER 1
+#endif
+
+#if KNX_FEATURE_COUPLER && !KNX_FEATURE_TX_QUEUE
+#error "KNX_FEATURE_COUPLER needs KNX_FEATURE_TX_QUEUE"
+#endif
+
+// setResetRecovery(), replay of unconfirmed frames after a reset
+// indication. The chip is configured again after a reset in any case.
+#ifndef KNX_FEATURE_RESET_RECOVERY
+#define KNX_FEATURE_RESET_RECOVERY 1
+#endif
+
+// 0: none
+// 1: setMonitorRing(), setCaptureWriter() and setTrafficStats()
+// 2: as 1, plus setLatencyStats() and getLastTxTiming()
+// TPUART_DEBUG (KnxTpUart.h) and KNX_TRACE (KnxTrace.h) come on top.
+#ifndef KNX_DIAGNOSTICS
+#define KNX_DIAGNOSTICS 2
+#endif
+
+#endif
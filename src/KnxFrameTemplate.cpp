@@ -0,0 +1,112 @@
+// File: KnxFrameTemplate.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxFrameTemplate.h"
+
+#define TEMPLATE_DATA_POS 8
+
+KnxFrameTemplate::KnxFrameTemplate() {
+  _length = 0;
+  _data_length = 0;
+  _base_checksum = 0;
+}
+
+void KnxFrameTemplate::begin(uint16_t source, String groupAddress, KnxCommandType command, int dataLength, KnxPriorityType priority) {
+  int mainGroup = groupAddress.substring(0, groupAddress.indexOf('/')).toInt();
+  int middleGroup = groupAddress.substring(groupAddress.indexOf('/') + 1, groupAddress.length()).substring(0, groupAddress.substring(groupAddress.indexOf('/') + 1, groupAddress.length()).indexOf('/')).toInt();
+  int subGroup = groupAddress.substring(groupAddress.lastIndexOf('/') + 1, groupAddress.length()).toInt();
+
+  if (dataLength > MAX_KNX_TELEGRAM_SIZE - KNX_TELEGRAM_HEADER_SIZE - 3) {
+    dataLength = MAX_KNX_TELEGRAM_SIZE - KNX_TELEGRAM_HEADER_SIZE - 3;
+  }
+
+  // Built with KnxTelegram once, so the layout is exactly the same
+  KnxTelegram tg;
+  tg.setPriority(priority);
+  tg.setSourceAddress(source >> 12, (source >> 8) & 0x0F, source & 0xFF);
+  tg.setTargetGroupAddress(mainGroup, middleGroup, subGroup);
+  tg.setCommand(command);
+  tg.setPayloadLength(dataLength + 2);
+
+  _data_length = dataLength;
+  _length = tg.getTotalLength();
+  for (int i = 0; i < _length; i++) {
+    _frame[i] = tg.getBufferByte(i);
+  }
+
+  _base_checksum = 0xFF;
+  for (int i = 0; i < _length - 1; i++) {
+    _base_checksum ^= _frame[i];
+  }
+  _frame[_length - 1] = _base_checksum;
+}
+
+void KnxFrameTemplate::updateChecksum() {
+  // Only the value bits differ from the template
+  uint8_t checksum = _base_checksum ^ (_frame[7] & 0b00111111);
+  for (int i = 0; i < _data_length; i++) {
+    checksum ^= _frame[TEMPLATE_DATA_POS + i];
+  }
+  _frame[_length - 1] = checksum;
+}
+
+void KnxFrameTemplate::setSmallValue(int value) {
+  if (_length == 0 || _data_length != 0) {
+    return;
+  }
+  _frame[7] = (_frame[7] & 0b11000000) | (value & 0b00111111);
+  updateChecksum();
+}
+
+void KnxFrameTemplate::setBool(bool value) {
+  setSmallValue(value ? 1 : 0);
+}
+
+void KnxFrameTemplate::setData(const uint8_t* data) {
+  for (int i = 0; i < _data_length; i++) {
+    _frame[TEMPLATE_DATA_POS + i] = data[i];
+  }
+  updateChecksum();
+}
+
+void KnxFrameTemplate::set1ByteIntValue(int value) {
+  if (_data_length != 1) {
+    return;
+  }
+  _frame[TEMPLATE_DATA_POS] = value;
+  updateChecksum();
+}
+
+void KnxFrameTemplate::set2ByteIntValue(int value) {
+  if (_data_length != 2) {
+    return;
+  }
+  _frame[TEMPLATE_DATA_POS] = byte(value >> 8);
+  _frame[TEMPLATE_DATA_POS + 1] = byte(value & 0x00FF);
+  updateChecksum();
+}
+
+void KnxFrameTemplate::set2ByteFloatValue(float value) {
+  if (_data_length != 2) {
+    return;
+  }
+  KnxTelegram::encode2ByteFloat(value, &_frame[TEMPLATE_DATA_POS]);
+  updateChecksum();
+}
+
+void KnxFrameTemplate::set4ByteFloatValue(float value) {
+  if (_data_length != 4) {
+    return;
+  }
+  KnxTelegram::encode4ByteFloat(value, &_frame[TEMPLATE_DATA_POS]);
+  updateChecksum();
+}
+
+const uint8_t* KnxFrameTemplate::getFrame() {
+  return _frame;
+}
+
+int KnxFrameTemplate::getLength() {
+  return _length;
+}
@@ -0,0 +1,49 @@
+// File: KnxFrameTemplate.h
+// Preformatted frame for a group object whose destination, priority,
+// command and value size never change. begin() builds the header and the
+// checksum of the constant bytes once; the value setters only patch the
+// value bytes and fold them into that checksum. A setter for another value
+// size than the template's is ignored. Send with KnxTpUart::sendTemplate().
+
+// Last modified: 18.10.2026
+
+#ifndef KnxFrameTemplate_h
+#define KnxFrameTemplate_h
+
+#include "Arduino.h"
+
+#include "KnxTelegram.h"
+
+class KnxFrameTemplate {
+  public:
+    KnxFrameTemplate();
+
+    // source is the individual address as returned by
+    // KnxTpUart::getIndividualAddress(). dataLength is the number of value
+    // bytes after the command, 0 for values that fit into the 6 bits of the
+    // first data byte (bool, 4 bit).
+    void begin(uint16_t source, String groupAddress, KnxCommandType command, int dataLength, KnxPriorityType priority = KNX_PRIORITY_NORMAL);
+
+    // Value in the first data byte, for dataLength 0
+    void setSmallValue(int value);
+    void setBool(bool value);
+    // Raw value bytes, dataLength of them
+    void setData(const uint8_t* data);
+    void set1ByteIntValue(int value);
+    void set2ByteIntValue(int value);
+    void set2ByteFloatValue(float value);
+    void set4ByteFloatValue(float value);
+
+    const uint8_t* getFrame();
+    int getLength();
+
+  private:
+    uint8_t _frame[MAX_KNX_TELEGRAM_SIZE];
+    uint8_t _length;
+    uint8_t _data_length;
+    uint8_t _base_checksum;  // With all value bits zero
+
+    void updateChecksum();
+};
+
+#endif
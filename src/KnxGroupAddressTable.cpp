@@ -0,0 +1,111 @@
+// File: KnxGroupAddressTable.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxGroupAddressTable.h"
+
+KnxGroupAddressTable::KnxGroupAddressTable(const KnxGroupAddressEntry* entries, const uint16_t* byName,
+                                           const char* names, int count) {
+  _entries = entries;
+  _by_name = byName;
+  _names = names;
+  _count = count;
+}
+
+int KnxGroupAddressTable::getCount() {
+  return _count;
+}
+
+int KnxGroupAddressTable::findAddress(uint16_t address) {
+  int low = 0;
+  int high = _count - 1;
+  while (low <= high) {
+    int middle = (low + high) / 2;
+    uint16_t current = pgm_read_word(&_entries[middle].address);
+    if (current == address) {
+      return middle;
+    }
+    if (current < address) {
+      low = middle + 1;
+    }
+    else {
+      high = middle - 1;
+    }
+  }
+  return KNX_GROUP_ADDRESS_NOT_FOUND;
+}
+
+int KnxGroupAddressTable::findName(const char* name) {
+  // Lower bound, so that the first of equal names wins
+  int low = 0;
+  int high = _count;
+  while (low < high) {
+    int middle = (low + high) / 2;
+    if (strcmp_P(name, getName(pgm_read_word(&_by_name[middle]))) > 0) {
+      low = middle + 1;
+    }
+    else {
+      high = middle;
+    }
+  }
+  if (low < _count) {
+    int index = pgm_read_word(&_by_name[low]);
+    if (strcmp_P(name, getName(index)) == 0) {
+      return index;
+    }
+  }
+  return KNX_GROUP_ADDRESS_NOT_FOUND;
+}
+
+uint16_t KnxGroupAddressTable::getAddress(int index) {
+  return pgm_read_word(&_entries[index].address);
+}
+
+uint8_t KnxGroupAddressTable::getDptMain(int index) {
+  return pgm_read_byte(&_entries[index].dptMain);
+}
+
+uint16_t KnxGroupAddressTable::getDptSub(int index) {
+  return pgm_read_word(&_entries[index].dptSub);
+}
+
+PGM_P KnxGroupAddressTable::getName(int index) {
+  return _names + pgm_read_word(&_entries[index].name);
+}
+
+int KnxGroupAddressTable::copyName(int index, char* buffer, int size) {
+  PGM_P name = getName(index);
+  int length = 0;
+  while (length < size - 1) {
+    char c = pgm_read_byte(name + length);
+    if (c == '\0') {
+      break;
+    }
+    buffer[length++] = c;
+  }
+  if (size > 0) {
+    buffer[length] = '\0';
+  }
+  return length;
+}
+
+uint16_t KnxGroupAddressTable::addressOf(const char* name) {
+  int index = findName(name);
+  return index == KNX_GROUP_ADDRESS_NOT_FOUND ? 0 : getAddress(index);
+}
+
+void KnxGroupAddressTable::printName(Print* out, uint16_t address) {
+  int index = findAddress(address);
+  if (index == KNX_GROUP_ADDRESS_NOT_FOUND) {
+    out->print((int) (address >> 11));
+    out->print('/');
+    out->print((int) ((address >> 8) & 0x07));
+    out->print('/');
+    out->print((int) (address & 0xFF));
+    return;
+  }
+  PGM_P name = getName(index);
+  for (char c = pgm_read_byte(name); c != '\0'; c = pgm_read_byte(++name)) {
+    out->print(c);
+  }
+}
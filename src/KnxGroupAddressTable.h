@@ -0,0 +1,57 @@
+// File: KnxGroupAddressTable.h
+// Read-only table of group address names and datapoint types, generated
+// from an ETS export by extras/host/tools/knxgatable. Everything lives in
+// flash (PROGMEM); lookups are binary searches by address or by name and
+// need no RAM.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxGroupAddressTable_h
+#define KnxGroupAddressTable_h
+
+#include "Arduino.h"
+
+#define KNX_GROUP_ADDRESS_NOT_FOUND -1
+
+// Sorted by address; the name is an offset into the name blob
+struct KnxGroupAddressEntry {
+  uint16_t address;
+  uint16_t name;
+  uint16_t dptSub;
+  uint8_t dptMain;
+};
+
+class KnxGroupAddressTable {
+  public:
+    // entries sorted by address, byName the entry indexes sorted by name
+    // (strcmp order), names the '\0' separated names; all in PROGMEM
+    KnxGroupAddressTable(const KnxGroupAddressEntry* entries, const uint16_t* byName, const char* names, int count);
+
+    int getCount();
+
+    // Entry index or KNX_GROUP_ADDRESS_NOT_FOUND. Equal names resolve to
+    // the lowest address.
+    int findAddress(uint16_t address);
+    int findName(const char* name);
+
+    uint16_t getAddress(int index);
+    uint8_t getDptMain(int index);
+    uint16_t getDptSub(int index);
+    // PROGMEM pointer
+    PGM_P getName(int index);
+    // Copies the name into buffer, truncated; returns the copied length
+    int copyName(int index, char* buffer, int size);
+
+    // 0 if the name is unknown
+    uint16_t addressOf(const char* name);
+    // Name of address, or "main/middle/sub" if it is not in the table
+    void printName(Print* out, uint16_t address);
+
+  private:
+    const KnxGroupAddressEntry* _entries;
+    const uint16_t* _by_name;
+    const char* _names;
+    int _count;
+};
+
+#endif
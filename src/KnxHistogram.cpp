@@ -0,0 +1,93 @@
+// File: KnxHistogram.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxHistogram.h"
+
+KnxHistogram::KnxHistogram() {
+  clear();
+}
+
+void KnxHistogram::clear() {
+  for (int i = 0; i < KNX_HISTOGRAM_BUCKETS; i++) {
+    _buckets[i] = 0;
+  }
+  _count = 0;
+  _min = 0;
+  _max = 0;
+}
+
+void KnxHistogram::record(unsigned long value) {
+  int bucket = 0;
+  unsigned long v = value >> 1;
+  while (v != 0 && bucket < KNX_HISTOGRAM_BUCKETS - 1) {
+    v >>= 1;
+    bucket++;
+  }
+
+  _buckets[bucket]++;
+  if (_count == 0 || value < _min) {
+    _min = value;
+  }
+  if (value > _max) {
+    _max = value;
+  }
+  _count++;
+}
+
+unsigned long KnxHistogram::getCount() {
+  return _count;
+}
+
+unsigned long KnxHistogram::getBucketCount(int bucket) {
+  if (bucket < 0 || bucket >= KNX_HISTOGRAM_BUCKETS) {
+    return 0;
+  }
+  return _buckets[bucket];
+}
+
+unsigned long KnxHistogram::getMin() {
+  return _min;
+}
+
+unsigned long KnxHistogram::getMax() {
+  return _max;
+}
+
+unsigned long KnxHistogram::getPercentile(int percentile) {
+  if (_count == 0) {
+    return 0;
+  }
+
+  unsigned long wanted = (_count * (unsigned long) percentile + 99) / 100;
+  unsigned long seen = 0;
+  for (int i = 0; i < KNX_HISTOGRAM_BUCKETS; i++) {
+    seen += _buckets[i];
+    if (seen >= wanted && _buckets[i] > 0) {
+      return i == 0 ? 0 : (1UL << i);
+    }
+  }
+  return _max;
+}
+
+void KnxHistogram::print(Print* out, const char* name) {
+  out->print(name);
+  out->print(": count ");
+  out->print(_count);
+  out->print(" min ");
+  out->print(_min);
+  out->print(" max ");
+  out->println(_max);
+
+  for (int i = 0; i < KNX_HISTOGRAM_BUCKETS; i++) {
+    if (_buckets[i] == 0) {
+      continue;
+    }
+    out->print("  [");
+    out->print(i == 0 ? 0UL : (1UL << i));
+    out->print(", ");
+    out->print(i == KNX_HISTOGRAM_BUCKETS - 1 ? _max : (2UL << i));
+    out->print(") ");
+    out->println(_buckets[i]);
+  }
+}
@@ -0,0 +1,53 @@
+// File: KnxHistogram.h
+// Fixed size histogram with log2 buckets: bucket i counts the values in
+// [2^i, 2^(i+1)), bucket 0 also counts 0. Recording is a few instructions
+// and never allocates, so it can run in the receive path.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxHistogram_h
+#define KnxHistogram_h
+
+#include "Arduino.h"
+
+#define KNX_HISTOGRAM_BUCKETS 32
+
+class KnxHistogram {
+  public:
+    KnxHistogram();
+
+    void record(unsigned long value);
+    void clear();
+
+    unsigned long getCount();
+    unsigned long getBucketCount(int bucket);
+    unsigned long getMin();
+    unsigned long getMax();
+    // Lower bound of the bucket containing the given percentile (0-100)
+    unsigned long getPercentile(int percentile);
+
+    // One line per non-empty bucket: "[from, to) count"
+    void print(Print* out, const char* name);
+
+  private:
+    unsigned long _buckets[KNX_HISTOGRAM_BUCKETS];
+    unsigned long _count;
+    unsigned long _min;
+    unsigned long _max;
+};
+
+// Timing of the last transmitted frame, micros()
+struct KnxTxTiming {
+  unsigned long queued;     // Handed to the library
+  unsigned long start;      // First byte written to the TP-UART
+  unsigned long confirmed;  // Confirmation received
+};
+
+// Latencies in microseconds, filled by KnxTpUart::setLatencyStats()
+struct KnxLatencyStats {
+  KnxHistogram rxFrame;      // Control byte until frame complete
+  KnxHistogram txQueueWait;  // Queued until transmission starts
+  KnxHistogram txConfirm;    // Transmission start until confirmation
+};
+
+#endif
@@ -0,0 +1,89 @@
+// File: KnxMonitorRing.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxMonitorRing.h"
+#include "KnxCriticalSection.h"
+
+#define MONITOR_RING_MASK (TPUART_MONITOR_RING_SIZE - 1)
+
+KnxMonitorRing::KnxMonitorRing() {
+  _head = 0;
+  _tail = 0;
+  _dropped = 0;
+}
+
+bool KnxMonitorRing::push(KnxMonitorRecordType type, const uint8_t* data, int length, unsigned long timestamp) {
+  uint8_t head = _head;
+  uint8_t next = (head + 1) & MONITOR_RING_MASK;
+  if (next == _tail) {
+    _dropped++;
+    return false;
+  }
+
+  if (length > MAX_KNX_TELEGRAM_SIZE) {
+    length = MAX_KNX_TELEGRAM_SIZE;
+  }
+
+  KnxMonitorRecord* record = &_records[head];
+  record->timestamp = timestamp;
+  record->type = type;
+  record->length = length;
+  for (int i = 0; i < length; i++) {
+    record->data[i] = data[i];
+  }
+
+  KNX_MEMORY_BARRIER();
+  _head = next;
+  return true;
+}
+
+int KnxMonitorRing::available() {
+  return (uint8_t) (_head - _tail) & MONITOR_RING_MASK;
+}
+
+bool KnxMonitorRing::read(KnxMonitorRecord* record) {
+  uint8_t tail = _tail;
+  if (tail == _head) {
+    return false;
+  }
+  KNX_MEMORY_BARRIER();
+
+  *record = _records[tail];
+
+  KNX_MEMORY_BARRIER();
+  _tail = (tail + 1) & MONITOR_RING_MASK;
+  return true;
+}
+
+void KnxMonitorRing::clear() {
+  _tail = _head;
+}
+
+int KnxMonitorRing::exportTo(Print* out, int maxRecords) {
+  KnxMonitorRecord record;
+  int n = 0;
+  while (n < maxRecords && read(&record)) {
+    printRecord(out, &record);
+    n++;
+  }
+  return n;
+}
+
+void KnxMonitorRing::printRecord(Print* out, const KnxMonitorRecord* record) {
+  // <micros> F|A <hex bytes>
+  out->print(record->timestamp);
+  out->print(record->type == KNX_MONITOR_FRAME ? " F" : " A");
+  for (int i = 0; i < record->length; i++) {
+    out->print(' ');
+    if (record->data[i] < 0x10) {
+      out->print('0');
+    }
+    out->print((int) record->data[i], HEX);
+  }
+  out->println();
+}
+
+unsigned long KnxMonitorRing::getDroppedCount() {
+  return _dropped;
+}
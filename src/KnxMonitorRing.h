@@ -0,0 +1,73 @@
+// File: KnxMonitorRing.h
+// Capture ring for the bus monitor. KnxTpUart pushes every frame and, in
+// busmonitor mode, every acknowledge character together with its receive
+// time. The ring has one writer (the task calling serialEvent()) and one
+// reader, so the export may run in another task without locking.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxMonitorRing_h
+#define KnxMonitorRing_h
+
+#include "Arduino.h"
+#include "KnxTelegram.h"
+
+// Number of records the ring can hold, must be a power of two. The bus
+// carries at most about 50 frames per second.
+#ifndef TPUART_MONITOR_RING_SIZE
+#define TPUART_MONITOR_RING_SIZE 32
+#endif
+
+#if (TPUART_MONITOR_RING_SIZE & (TPUART_MONITOR_RING_SIZE - 1)) != 0
+#error "TPUART_MONITOR_RING_SIZE must be a power of two"
+#endif
+
+#if TPUART_MONITOR_RING_SIZE > 256
+#error "TPUART_MONITOR_RING_SIZE must not exceed 256"
+#endif
+
+// Acknowledge characters sent by the receivers after a frame
+#define KNX_BUS_ACK 0xCC
+#define KNX_BUS_NAK 0x0C
+#define KNX_BUS_BUSY 0xC0
+
+enum KnxMonitorRecordType {
+  KNX_MONITOR_FRAME,
+  KNX_MONITOR_ACK       // Single acknowledge character
+};
+
+struct KnxMonitorRecord {
+  unsigned long timestamp;  // micros() of the first byte
+  uint8_t type;
+  uint8_t length;
+  uint8_t data[MAX_KNX_TELEGRAM_SIZE];
+};
+
+class KnxMonitorRing {
+  public:
+    KnxMonitorRing();
+
+    // Writer side
+    bool push(KnxMonitorRecordType type, const uint8_t* data, int length, unsigned long timestamp);
+
+    // Reader side
+    int available();
+    bool read(KnxMonitorRecord* record);
+    void clear();
+
+    // Prints up to maxRecords records, one line each, and returns how many.
+    // Called repeatedly it streams the capture without blocking for long.
+    int exportTo(Print* out, int maxRecords);
+    static void printRecord(Print* out, const KnxMonitorRecord* record);
+
+    // Records dropped because the ring was full
+    unsigned long getDroppedCount();
+
+  private:
+    KnxMonitorRecord _records[TPUART_MONITOR_RING_SIZE];
+    volatile uint8_t _head;  // written by the writer only
+    volatile uint8_t _tail;  // written by the reader only
+    volatile unsigned long _dropped;
+};
+
+#endif
@@ -0,0 +1,169 @@
+// File: KnxResetRecovery.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxResetRecovery.h"
+#include "KnxStateSync.h"
+
+KnxResetRecovery::KnxResetRecovery() {
+#if KNX_FEATURE_ASYNC_READ
+  _state_sync = NULL;
+#endif
+  _start_us = 0;
+  _start_ms = 0;
+  clear();
+  resetStats();
+}
+
+#if KNX_FEATURE_ASYNC_READ
+void KnxResetRecovery::setStateSync(KnxStateSync* stateSync) {
+  _state_sync = stateSync;
+}
+#endif
+
+KnxRecoveryStats KnxResetRecovery::getStats() {
+  return _stats;
+}
+
+void KnxResetRecovery::resetStats() {
+  _stats.resets = 0;
+  _stats.replayed = 0;
+  _stats.lost = 0;
+  _stats.lastRecoveryUs = 0;
+  _stats.maxRecoveryUs = 0;
+}
+
+int KnxResetRecovery::getCount() {
+  int count = 0;
+  for (int i = 0; i < MAX_RECOVERY_FRAMES; i++) {
+    if (_slots[i].length > 0) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void KnxResetRecovery::clear() {
+  for (int i = 0; i < MAX_RECOVERY_FRAMES; i++) {
+    _slots[i].length = 0;
+  }
+}
+
+uint8_t KnxResetRecovery::urgency(const uint8_t* frame) {
+  // 0 system, 1 alarm, 2 high, 3 normal, see KnxPriorityType
+  static const uint8_t rank[4] = {0, 2, 1, 3};
+  return rank[(frame[0] & 0b00001100) >> 2];
+}
+
+void KnxResetRecovery::remember(const uint8_t* frame, int length) {
+  if (length <= 0 || length > MAX_KNX_TELEGRAM_SIZE) {
+    return;
+  }
+
+  // A free slot, otherwise the oldest frame makes room
+  Slot* slot = &_slots[0];
+  for (int i = 0; i < MAX_RECOVERY_FRAMES; i++) {
+    if (_slots[i].length == 0) {
+      slot = &_slots[i];
+      break;
+    }
+    if ((long) (_slots[i].failed - slot->failed) < 0) {
+      slot = &_slots[i];
+    }
+  }
+  if (slot->length > 0) {
+    _stats.lost++;
+  }
+
+  for (int i = 0; i < length; i++) {
+    slot->frame[i] = frame[i];
+  }
+  slot->length = length;
+  slot->failed = millis();
+}
+
+void KnxResetRecovery::forget(const uint8_t* frame, int length) {
+  for (int i = 0; i < MAX_RECOVERY_FRAMES; i++) {
+    Slot* slot = &_slots[i];
+    if (slot->length != length) {
+      continue;
+    }
+    int j = 0;
+    while (j < length && slot->frame[j] == frame[j]) {
+      j++;
+    }
+    if (j == length) {
+      slot->length = 0;
+    }
+  }
+}
+
+void KnxResetRecovery::begin() {
+  _stats.resets++;
+  _start_us = micros();
+  _start_ms = millis();
+
+  for (int i = 0; i < MAX_RECOVERY_FRAMES; i++) {
+    if (_slots[i].length > 0 && (_start_ms - _slots[i].failed) > RECOVERY_WINDOW_MS) {
+      _slots[i].length = 0;
+      _stats.lost++;
+    }
+  }
+}
+
+bool KnxResetRecovery::next(uint8_t* frame, int* length) {
+  Slot* best = NULL;
+  for (int i = 0; i < MAX_RECOVERY_FRAMES; i++) {
+    Slot* slot = &_slots[i];
+    if (slot->length == 0) {
+      continue;
+    }
+    if (best == NULL || urgency(slot->frame) < urgency(best->frame)
+        || (urgency(slot->frame) == urgency(best->frame) && (long) (slot->failed - best->failed) < 0)) {
+      best = slot;
+    }
+  }
+  if (best == NULL) {
+    return false;
+  }
+
+  if ((millis() - _start_ms) > RECOVERY_BUDGET_MS) {
+    // Out of time, the rest is given up
+    for (int i = 0; i < MAX_RECOVERY_FRAMES; i++) {
+      if (_slots[i].length > 0) {
+        _slots[i].length = 0;
+        _stats.lost++;
+      }
+    }
+    return false;
+  }
+
+  for (int i = 0; i < best->length; i++) {
+    frame[i] = best->frame[i];
+  }
+  *length = best->length;
+  best->length = 0;
+  return true;
+}
+
+void KnxResetRecovery::replayed(bool confirmed) {
+  if (confirmed) {
+    _stats.replayed++;
+  }
+  else {
+    _stats.lost++;
+  }
+}
+
+void KnxResetRecovery::end() {
+  _stats.lastRecoveryUs = micros() - _start_us;
+  if (_stats.lastRecoveryUs > _stats.maxRecoveryUs) {
+    _stats.maxRecoveryUs = _stats.lastRecoveryUs;
+  }
+
+#if KNX_FEATURE_ASYNC_READ
+  if (_state_sync != NULL) {
+    _state_sync->restart();
+  }
+#endif
+}
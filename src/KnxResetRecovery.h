@@ -0,0 +1,98 @@
+// File: KnxResetRecovery.h
+// Recovery after a TP-UART reset indication (bus voltage dip, watchdog of
+// the chip). KnxTpUart always configures the chip again (address and ack
+// mode, busmonitor); with a KnxResetRecovery attached it also keeps the
+// frames that were not confirmed because the chip went away and sends
+// them again once it is back, most important priority first, then the
+// oldest. Optionally a KnxStateSync is restarted to learn what changed on
+// the bus meanwhile.
+//
+// The first attempt is reported as failed to the caller and to the confirm
+// handler, the replay is not reported again. A frame sent again before the
+// reset indication replaces the held copy, so a caller that retries on
+// failure does not get it on the bus twice.
+//
+// Everything runs from serialEvent() when it sees the reset indication.
+// The replays are bounded by MAX_RECOVERY_FRAMES and RECOVERY_BUDGET_MS;
+// what does not fit is counted as lost.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxResetRecovery_h
+#define KnxResetRecovery_h
+
+#include "Arduino.h"
+
+#include "KnxFeatures.h"
+#include "KnxTelegram.h"
+
+class KnxStateSync;
+
+// Unconfirmed frames kept for a replay
+#ifndef MAX_RECOVERY_FRAMES
+#define MAX_RECOVERY_FRAMES 4
+#endif
+
+// Unconfirmed frames older than this when the reset indication arrives
+// are not replayed, their value is probably outdated
+#ifndef RECOVERY_WINDOW_MS
+#define RECOVERY_WINDOW_MS 2000
+#endif
+
+// Maximum time the replays may take, serialEvent() blocks meanwhile
+#ifndef RECOVERY_BUDGET_MS
+#define RECOVERY_BUDGET_MS 200
+#endif
+
+struct KnxRecoveryStats {
+  unsigned long resets;         // Reset indications seen
+  unsigned long replayed;       // Frames replayed and confirmed
+  unsigned long lost;           // Unconfirmed frames given up
+  unsigned long lastRecoveryUs; // Reset indication until the last replay
+  unsigned long maxRecoveryUs;
+};
+
+class KnxResetRecovery {
+  public:
+    KnxResetRecovery();
+
+#if KNX_FEATURE_ASYNC_READ
+    // Restarted with its address list after every recovery
+    void setStateSync(KnxStateSync*);
+#endif
+
+    KnxRecoveryStats getStats();
+    void resetStats();
+    // Unconfirmed frames waiting for a reset indication
+    int getCount();
+    void clear();
+
+    // From KnxTpUart
+    void remember(const uint8_t* frame, int length);
+    // The same frame was sent again, it is not replayed
+    void forget(const uint8_t* frame, int length);
+    void begin();
+    // Copies the next frame to replay into frame, false when done
+    bool next(uint8_t* frame, int* length);
+    void replayed(bool confirmed);
+    void end();
+
+  private:
+    struct Slot {
+      uint8_t length;  // 0 if free
+      unsigned long failed;  // millis()
+      uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+    };
+
+    Slot _slots[MAX_RECOVERY_FRAMES];
+#if KNX_FEATURE_ASYNC_READ
+    KnxStateSync* _state_sync;
+#endif
+    KnxRecoveryStats _stats;
+    unsigned long _start_us;
+    unsigned long _start_ms;
+
+    static uint8_t urgency(const uint8_t* frame);
+};
+
+#endif
@@ -0,0 +1,112 @@
+// File: KnxRxRing.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxRxRing.h"
+#include "KnxCriticalSection.h"
+
+#define RX_RING_MASK (TPUART_RX_RING_SIZE - 1)
+
+KnxRxRing::KnxRxRing() {
+  _head = 0;
+  _tail = 0;
+  _overflows = 0;
+  _last_timestamp = 0;
+}
+
+void KnxRxRing::push(uint8_t data) {
+  push(data, micros());
+}
+
+void KnxRxRing::push(uint8_t data, unsigned long timestamp) {
+  knx_rx_index_t head = _head;
+  knx_rx_index_t next = (head + 1) & RX_RING_MASK;
+  if (next == _tail) {
+    _overflows++;
+    return;
+  }
+
+  _data[head] = data;
+  _timestamps[head] = timestamp;
+  KNX_MEMORY_BARRIER();
+  _head = next;
+}
+
+int KnxRxRing::available() {
+  return (_head - _tail) & RX_RING_MASK;
+}
+
+int KnxRxRing::peek() {
+  if (_head == _tail) {
+    return -1;
+  }
+  KNX_MEMORY_BARRIER();
+  return _data[_tail];
+}
+
+unsigned long KnxRxRing::peekTimestamp() {
+  if (_head == _tail) {
+    return 0;
+  }
+  KNX_MEMORY_BARRIER();
+  return _timestamps[_tail];
+}
+
+int KnxRxRing::read() {
+  uint8_t data;
+  if (read(&data, 1) == 0) {
+    return -1;
+  }
+  return data;
+}
+
+int KnxRxRing::read(uint8_t* buffer, int count) {
+  knx_rx_index_t tail = _tail;
+  knx_rx_index_t head = _head;
+  KNX_MEMORY_BARRIER();
+
+  int n = 0;
+  while (n < count && tail != head) {
+    buffer[n++] = _data[tail];
+    _last_timestamp = _timestamps[tail];
+    tail = (tail + 1) & RX_RING_MASK;
+  }
+
+  KNX_MEMORY_BARRIER();
+  _tail = tail;
+  return n;
+}
+
+int KnxRxRing::read(uint8_t* buffer, int count, unsigned long maxGapUs) {
+  knx_rx_index_t tail = _tail;
+  knx_rx_index_t head = _head;
+  KNX_MEMORY_BARRIER();
+
+  // Stops in front of the first byte that arrived too late to belong to
+  // the bytes read before it
+  int n = 0;
+  while (n < count && tail != head) {
+    if ((_timestamps[tail] - _last_timestamp) > maxGapUs) {
+      break;
+    }
+    buffer[n++] = _data[tail];
+    _last_timestamp = _timestamps[tail];
+    tail = (tail + 1) & RX_RING_MASK;
+  }
+
+  KNX_MEMORY_BARRIER();
+  _tail = tail;
+  return n;
+}
+
+unsigned long KnxRxRing::getLastTimestamp() {
+  return _last_timestamp;
+}
+
+void KnxRxRing::clear() {
+  _tail = _head;
+}
+
+unsigned long KnxRxRing::getOverflowCount() {
+  return _overflows;
+}
@@ -0,0 +1,70 @@
+// File: KnxRxRing.h
+// Lock-free byte ring between the UART receive interrupt and the protocol
+// parser. The interrupt handler is the only writer (push()), KnxTpUart is the
+// only reader. Every byte is stamped with micros() when it is pushed, which
+// lets the parser delimit frames by the real inter-byte gap.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxRxRing_h
+#define KnxRxRing_h
+
+#include "Arduino.h"
+
+// Number of bytes the receive ring can hold, must be a power of two.
+// One telegram is at most MAX_KNX_TELEGRAM_SIZE (23) bytes.
+#ifndef TPUART_RX_RING_SIZE
+#define TPUART_RX_RING_SIZE 128
+#endif
+
+// Maximum gap between two bytes of the same telegram. A character on the bus
+// takes about 1.35 ms, anything clearly longer ends the frame.
+#ifndef TPUART_RX_FRAME_GAP_US
+#define TPUART_RX_FRAME_GAP_US 2000
+#endif
+
+#if (TPUART_RX_RING_SIZE & (TPUART_RX_RING_SIZE - 1)) != 0
+#error "TPUART_RX_RING_SIZE must be a power of two"
+#endif
+
+// Index updates must be atomic for the reader, so AVR is limited to 8 bit
+#if defined(__AVR__)
+#if TPUART_RX_RING_SIZE > 256
+#error "TPUART_RX_RING_SIZE must not exceed 256 on AVR"
+#endif
+typedef uint8_t knx_rx_index_t;
+#else
+typedef uint16_t knx_rx_index_t;
+#endif
+
+class KnxRxRing {
+  public:
+    KnxRxRing();
+
+    // Interrupt side
+    void push(uint8_t data);
+    void push(uint8_t data, unsigned long timestamp);
+
+    // Parser side
+    int available();
+    int peek();
+    unsigned long peekTimestamp();
+    int read();
+    int read(uint8_t* buffer, int count);
+    int read(uint8_t* buffer, int count, unsigned long maxGapUs);
+    unsigned long getLastTimestamp();
+    void clear();
+
+    // Bytes dropped because the ring was full
+    unsigned long getOverflowCount();
+
+  private:
+    uint8_t _data[TPUART_RX_RING_SIZE];
+    unsigned long _timestamps[TPUART_RX_RING_SIZE];
+    volatile knx_rx_index_t _head;  // written by the interrupt only
+    volatile knx_rx_index_t _tail;  // written by the parser only
+    volatile unsigned long _overflows;
+    unsigned long _last_timestamp;  // of the last byte read
+};
+
+#endif
@@ -0,0 +1,459 @@
+// File: KnxSecure.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxSecure.h"
+#include "KnxConfig.h"
+#include "KnxTrace.h"
+
+#define SECURE_SCF_OFFSET 8
+#define SECURE_SEQUENCE_OFFSET 9
+#define SECURE_APDU_OFFSET 15
+#define MAX_SEQUENCE 0xFFFFFFFFFFFFULL
+
+static void createChecksum(uint8_t* frame, int length) {
+  uint8_t checksum = 0xFF;
+  for (int i = 0; i < length - 1; i++) {
+    checksum ^= frame[i];
+  }
+  frame[length - 1] = checksum;
+}
+
+static uint64_t readSequence(const uint8_t* p, bool bigEndian) {
+  uint64_t sequence = 0;
+  for (int i = 0; i < KNX_SECURE_SEQUENCE_SIZE; i++) {
+    sequence = (sequence << 8) | p[bigEndian ? i : KNX_SECURE_SEQUENCE_SIZE - 1 - i];
+  }
+  return sequence;
+}
+
+static void writeSequence(uint8_t* p, uint64_t sequence, bool bigEndian) {
+  for (int i = KNX_SECURE_SEQUENCE_SIZE - 1; i >= 0; i--) {
+    p[bigEndian ? i : KNX_SECURE_SEQUENCE_SIZE - 1 - i] = sequence & 0xFF;
+    sequence >>= 8;
+  }
+}
+
+// CBC-MAC fed one byte at a time, so that it runs in the same pass as the
+// counter mode encryption
+struct KnxCbcMac {
+  const KnxAesKey* key;
+  uint8_t state[KNX_AES_BLOCK_SIZE];
+  int fill;
+
+  void add(uint8_t b) {
+    state[fill++] ^= b;
+    if (fill == KNX_AES_BLOCK_SIZE) {
+      knxAesEncrypt(key, state);
+      fill = 0;
+    }
+  }
+
+  void finish() {
+    // Zero padding does not change the state
+    if (fill > 0) {
+      knxAesEncrypt(key, state);
+      fill = 0;
+    }
+  }
+};
+
+KnxSecure::KnxSecure() {
+  _key_count = 0;
+  _group_count = 0;
+  _source_count = 0;
+  _sequence = 1;
+  _reserved = 1;
+  _sequence_writer = NULL;
+  _sequence_context = NULL;
+  _last_result = KNX_SECURE_PLAIN;
+  resetStats();
+}
+
+int KnxSecure::addKey(const uint8_t* key) {
+  if (_key_count >= MAX_SECURE_KEYS) {
+    return -1;
+  }
+  knxAesExpandKey(key, &_keys[_key_count]);
+  return _key_count++;
+}
+
+bool KnxSecure::addGroupAddress(uint16_t address, int key, bool confidential) {
+  if (key < 0 || key >= _key_count || findGroup(address) != NULL || _group_count >= MAX_SECURE_GROUP_ADDRESSES) {
+    return false;
+  }
+
+  // Sorted for the binary search in the receive path
+  int i = _group_count;
+  while (i > 0 && _groups[i - 1].address > address) {
+    _groups[i] = _groups[i - 1];
+    i--;
+  }
+  _groups[i].address = address;
+  _groups[i].key = key;
+  _groups[i].scf = confidential ? KNX_SECURE_SCF_AUTH_CONF : KNX_SECURE_SCF_AUTH;
+  _group_count++;
+  return true;
+}
+
+bool KnxSecure::isSecureGroupAddress(uint16_t address) {
+  return findGroup(address) != NULL;
+}
+
+bool KnxSecure::addSource(uint16_t address, uint64_t lastSequence) {
+  KnxSecureSource* source = findSource(address);
+  if (source != NULL) {
+    source->lastSequence = lastSequence;
+    return true;
+  }
+  if (_source_count >= MAX_SECURE_SOURCES) {
+    return false;
+  }
+
+  int i = _source_count;
+  while (i > 0 && _sources[i - 1].address > address) {
+    _sources[i] = _sources[i - 1];
+    i--;
+  }
+  _sources[i].address = address;
+  _sources[i].lastSequence = lastSequence;
+  _source_count++;
+  return true;
+}
+
+void KnxSecure::setSequence(uint64_t sequence) {
+  _sequence = sequence;
+  // Nothing above it is known to be stored yet
+  _reserved = sequence;
+}
+
+uint64_t KnxSecure::getSequence() {
+  return _sequence;
+}
+
+void KnxSecure::setSequenceWriter(KnxSequenceWriter writer, void* context) {
+  _sequence_writer = writer;
+  _sequence_context = context;
+}
+
+KnxSecureGroup* KnxSecure::findGroup(uint16_t address) {
+  int low = 0;
+  int high = _group_count - 1;
+  while (low <= high) {
+    int mid = (low + high) / 2;
+    if (_groups[mid].address == address) {
+      return &_groups[mid];
+    }
+    else if (_groups[mid].address < address) {
+      low = mid + 1;
+    }
+    else {
+      high = mid - 1;
+    }
+  }
+  return NULL;
+}
+
+KnxSecureSource* KnxSecure::findSource(uint16_t address) {
+  int low = 0;
+  int high = _source_count - 1;
+  while (low <= high) {
+    int mid = (low + high) / 2;
+    if (_sources[mid].address == address) {
+      return &_sources[mid];
+    }
+    else if (_sources[mid].address < address) {
+      low = mid + 1;
+    }
+    else {
+      high = mid - 1;
+    }
+  }
+  return NULL;
+}
+
+// AES-128-CCM over a frame in the secured layout, with
+//
+//   B0    SeqNr | source | target | 0x00 | address type | 0x03F1 | 0x00 | length
+//   Ctr0  SeqNr | source | target | 0x00 0x00 0x00 0x00 | 0x01 | 0x00
+//
+// length is that of the encrypted APDU, 0 for authentication only. Ctr i
+// ends in i. The CBC-MAC runs over B0, the 2 byte length of the associated
+// data, the associated data (the SCF; SCF and APDU for authentication only)
+// and the plain APDU, zero padded at the end. The MAC is its first 4
+// bytes, encrypted with Ctr0. One pass over the APDU, which is encrypted
+// or decrypted in place; mac receives the MAC of the plain APDU.
+void KnxSecure::ccm(const KnxAesKey* key, uint8_t* frame, int apduLength, bool encrypt, uint8_t* mac) {
+  uint8_t scf = frame[SECURE_SCF_OFFSET];
+  bool confidential = scf == KNX_SECURE_SCF_AUTH_CONF;
+  uint8_t* apdu = frame + SECURE_APDU_OFFSET;
+
+  KnxCbcMac cbc;
+  cbc.key = key;
+  cbc.fill = 0;
+  for (int i = 0; i < KNX_SECURE_SEQUENCE_SIZE; i++) {
+    cbc.state[i] = frame[SECURE_SEQUENCE_OFFSET + i];
+  }
+  for (int i = 0; i < 4; i++) {
+    cbc.state[KNX_SECURE_SEQUENCE_SIZE + i] = frame[1 + i];
+  }
+  cbc.state[10] = 0;
+  cbc.state[11] = frame[5] & 0b10000000;
+  cbc.state[12] = KNX_SECURE_APCI >> 8;
+  cbc.state[13] = KNX_SECURE_APCI & 0xFF;
+  cbc.state[14] = 0;
+  cbc.state[15] = confidential ? apduLength : 0;
+  knxAesEncrypt(key, cbc.state);
+
+  int associated = confidential ? 1 : 1 + apduLength;
+  cbc.add(associated >> 8);
+  cbc.add(associated & 0xFF);
+  cbc.add(scf);
+
+  uint8_t counter[KNX_AES_BLOCK_SIZE];
+  uint8_t stream[KNX_AES_BLOCK_SIZE];
+  for (int i = 0; i < KNX_SECURE_SEQUENCE_SIZE; i++) {
+    counter[i] = frame[SECURE_SEQUENCE_OFFSET + i];
+  }
+  for (int i = 0; i < 4; i++) {
+    counter[KNX_SECURE_SEQUENCE_SIZE + i] = frame[1 + i];
+  }
+  counter[10] = 0;
+  counter[11] = 0;
+  counter[12] = 0;
+  counter[13] = 0;
+  counter[14] = 0x01;
+
+  for (int i = 0; i < apduLength; i++) {
+    if (!confidential) {
+      cbc.add(apdu[i]);
+      continue;
+    }
+    if (i % KNX_AES_BLOCK_SIZE == 0) {
+      for (int j = 0; j < KNX_AES_BLOCK_SIZE; j++) {
+        stream[j] = counter[j];
+      }
+      stream[15] = i / KNX_AES_BLOCK_SIZE + 1;
+      knxAesEncrypt(key, stream);
+    }
+    if (encrypt) {
+      cbc.add(apdu[i]);
+      apdu[i] ^= stream[i % KNX_AES_BLOCK_SIZE];
+    }
+    else {
+      apdu[i] ^= stream[i % KNX_AES_BLOCK_SIZE];
+      cbc.add(apdu[i]);
+    }
+  }
+  cbc.finish();
+
+  counter[15] = 0;
+  knxAesEncrypt(key, counter);
+  for (int i = 0; i < KNX_SECURE_MAC_SIZE; i++) {
+    mac[i] = cbc.state[i] ^ counter[i];
+  }
+}
+
+int KnxSecure::secure(const uint8_t* frame, uint8_t* out) {
+  KNX_TRACE_SCOPE(KNX_TRACE_SECURE);
+  if (!(frame[5] & 0b10000000)) {
+    return 0;
+  }
+  KnxSecureGroup* group = findGroup((frame[3] << 8) | frame[4]);
+  if (group == NULL) {
+    return 0;
+  }
+
+  // The plain APDU starts with the APCI bits of the TPCI byte
+  int apduLength = (frame[5] & 0b00001111) + 1;
+  if (apduLength > KNX_SECURE_MAX_APDU || _sequence > MAX_SEQUENCE) {
+    return -1;
+  }
+
+  if (_sequence >= _reserved) {
+    // Stored before the number is used, a restart continues above it
+    _reserved = _sequence + KNX_SECURE_SEQUENCE_RESERVE;
+    if (_sequence_writer != NULL) {
+      _sequence_writer(_reserved, _sequence_context);
+    }
+  }
+
+  for (int i = 0; i < KNX_TELEGRAM_HEADER_SIZE; i++) {
+    out[i] = frame[i];
+  }
+  out[5] = (frame[5] & 0b11110000) | (KNX_SECURE_OVERHEAD + apduLength);
+  out[6] = (frame[6] & 0b11111100) | (KNX_SECURE_APCI >> 8);
+  out[7] = KNX_SECURE_APCI & 0xFF;
+  out[SECURE_SCF_OFFSET] = group->scf;
+  writeSequence(out + SECURE_SEQUENCE_OFFSET, _sequence, true);
+  out[SECURE_APDU_OFFSET] = frame[6] & 0b00000011;
+  for (int i = 1; i < apduLength; i++) {
+    out[SECURE_APDU_OFFSET + i] = frame[6 + i];
+  }
+  ccm(&_keys[group->key], out, apduLength, true, out + SECURE_APDU_OFFSET + apduLength);
+
+  int length = SECURE_APDU_OFFSET + apduLength + KNX_SECURE_MAC_SIZE + 1;
+  createChecksum(out, length);
+  _sequence++;
+  _stats.sent++;
+  return length;
+}
+
+KnxSecureResult KnxSecure::reject(KnxSecureResult result) {
+  _stats.rejected++;
+  _last_result = result;
+  return result;
+}
+
+KnxSecureResult KnxSecure::unsecure(uint8_t* frame) {
+  KNX_TRACE_SCOPE(KNX_TRACE_SECURE);
+  int payloadLength = (frame[5] & 0b00001111) + 1;
+  bool group = frame[5] & 0b10000000;
+  uint16_t target = (frame[3] << 8) | frame[4];
+
+  if (payloadLength < 2 || (frame[6] & 0b00000011) != (KNX_SECURE_APCI >> 8) || frame[7] != (KNX_SECURE_APCI & 0xFF)) {
+    // Plain group values (read, answer, write) must not reach secured groups
+    if (group && payloadLength >= 2 && (frame[6] & 0b00000011) == 0 && (frame[7] & 0b11000000) != 0b11000000
+        && findGroup(target) != NULL) {
+      return reject(KNX_SECURE_NOT_SECURED);
+    }
+    _last_result = KNX_SECURE_PLAIN;
+    return KNX_SECURE_PLAIN;
+  }
+
+  int apduLength = payloadLength - 1 - KNX_SECURE_OVERHEAD;
+  uint8_t scf = frame[SECURE_SCF_OFFSET];
+  if (apduLength < 1 || (scf != KNX_SECURE_SCF_AUTH_CONF && scf != KNX_SECURE_SCF_AUTH)) {
+    // Sync services and tool access are not supported
+    return reject(KNX_SECURE_MALFORMED);
+  }
+
+  KnxSecureGroup* secureGroup = group ? findGroup(target) : NULL;
+  if (secureGroup == NULL) {
+    return reject(KNX_SECURE_NO_KEY);
+  }
+  if (secureGroup->scf == KNX_SECURE_SCF_AUTH_CONF && scf != KNX_SECURE_SCF_AUTH_CONF) {
+    return reject(KNX_SECURE_NOT_SECURED);
+  }
+
+  KnxSecureSource* source = findSource((frame[1] << 8) | frame[2]);
+  if (source == NULL) {
+    return reject(KNX_SECURE_UNKNOWN_SOURCE);
+  }
+  uint64_t sequence = readSequence(frame + SECURE_SEQUENCE_OFFSET, true);
+  if (sequence <= source->lastSequence) {
+    _stats.replays++;
+    return reject(KNX_SECURE_REPLAY);
+  }
+
+  uint8_t mac[KNX_SECURE_MAC_SIZE];
+  ccm(&_keys[secureGroup->key], frame, apduLength, false, mac);
+  uint8_t difference = 0;
+  for (int i = 0; i < KNX_SECURE_MAC_SIZE; i++) {
+    difference |= mac[i] ^ frame[SECURE_APDU_OFFSET + apduLength + i];
+  }
+  if (difference != 0) {
+    _stats.badMacs++;
+    return reject(KNX_SECURE_BAD_MAC);
+  }
+  source->lastSequence = sequence;
+
+  // Back to the plain layout
+  const uint8_t* apdu = frame + SECURE_APDU_OFFSET;
+  frame[5] = (frame[5] & 0b11110000) | (apduLength - 1);
+  frame[6] = (frame[6] & 0b11111100) | (apdu[0] & 0b00000011);
+  for (int i = 1; i < apduLength; i++) {
+    frame[6 + i] = apdu[i];
+  }
+  createChecksum(frame, KNX_TELEGRAM_HEADER_SIZE + apduLength + 1);
+
+  _stats.received++;
+  _last_result = KNX_SECURE_OK;
+  return KNX_SECURE_OK;
+}
+
+KnxSecureResult KnxSecure::getLastResult() {
+  return _last_result;
+}
+
+int KnxSecure::saveState(uint8_t* buffer, int size) {
+  int length = KNX_SECURE_STATE_SIZE(_source_count);
+  if (size < length) {
+    return 0;
+  }
+
+  buffer[0] = 'K';
+  buffer[1] = 'S';
+  buffer[2] = KNX_SECURE_STATE_VERSION;
+  // Numbers at or above it may already be in use
+  writeSequence(buffer + 3, _reserved > _sequence ? _reserved : _sequence, false);
+  buffer[9] = _source_count;
+  uint8_t* p = buffer + 10;
+  for (int i = 0; i < _source_count; i++) {
+    p[0] = _sources[i].address & 0xFF;
+    p[1] = _sources[i].address >> 8;
+    writeSequence(p + 2, _sources[i].lastSequence, false);
+    p += 2 + KNX_SECURE_SEQUENCE_SIZE;
+  }
+
+  uint16_t crc = 0xFFFF;
+  for (int i = 0; i < length - 2; i++) {
+    crc = knxConfigCrcUpdate(crc, buffer[i]);
+  }
+  buffer[length - 2] = crc & 0xFF;
+  buffer[length - 1] = crc >> 8;
+  return length;
+}
+
+bool KnxSecure::loadState(const uint8_t* blob, int length) {
+  if (length < KNX_SECURE_STATE_SIZE(0) || blob[0] != 'K' || blob[1] != 'S' || blob[2] != KNX_SECURE_STATE_VERSION) {
+    return false;
+  }
+  int count = blob[9];
+  if (count > MAX_SECURE_SOURCES || length < KNX_SECURE_STATE_SIZE(count)) {
+    return false;
+  }
+  length = KNX_SECURE_STATE_SIZE(count);
+
+  uint16_t crc = 0xFFFF;
+  for (int i = 0; i < length - 2; i++) {
+    crc = knxConfigCrcUpdate(crc, blob[i]);
+  }
+  if ((blob[length - 2] | (blob[length - 1] << 8)) != crc) {
+    return false;
+  }
+
+  // Check the order before replacing anything, a rejected blob leaves the
+  // running table untouched
+  const uint8_t* p = blob + 10;
+  for (int i = 1; i < count; i++) {
+    const uint8_t* q = p + 2 + KNX_SECURE_SEQUENCE_SIZE;
+    if ((q[0] | (q[1] << 8)) <= (p[0] | (p[1] << 8))) {
+      // Not sorted, the binary search would miss entries
+      return false;
+    }
+    p = q;
+  }
+
+  p = blob + 10;
+  for (int i = 0; i < count; i++) {
+    _sources[i].address = p[0] | (p[1] << 8);
+    _sources[i].lastSequence = readSequence(p + 2, false);
+    p += 2 + KNX_SECURE_SEQUENCE_SIZE;
+  }
+  _source_count = count;
+  setSequence(readSequence(blob + 3, false));
+  return true;
+}
+
+KnxSecureStats KnxSecure::getStats() {
+  return _stats;
+}
+
+void KnxSecure::resetStats() {
+  _stats.sent = 0;
+  _stats.received = 0;
+  _stats.rejected = 0;
+  _stats.replays = 0;
+  _stats.badMacs = 0;
+}
@@ -0,0 +1,148 @@
+// File: KnxSecure.h
+// KNX Data Secure (S-A_Data) for group communication: AES-128-CCM
+// authentication and encryption with per group address keys, a 48 bit
+// sequence number for our frames and replay protection per source.
+//
+// Secured APDU, after the TPCI:
+//
+//   0x03F1          A_SecureService
+//   SCF             0x10 authenticated and encrypted, 0x00 authenticated
+//   SeqNr           6 bytes, big endian
+//   APDU            the plain APCI and data, encrypted with SCF 0x10
+//   MAC             4 bytes
+//
+// The library only handles standard frames, which leaves room for a
+// plain APDU of up to KNX_SECURE_MAX_APDU bytes: values up to one byte
+// (DPT 1, 2, 3, 5, 6, 17, 18, ...).
+
+// Last modified: 18.10.2026
+
+#ifndef KnxSecure_h
+#define KnxSecure_h
+
+#include "Arduino.h"
+#include "KnxAes.h"
+#include "KnxTelegram.h"
+
+// Key schedules kept expanded, 176 bytes each
+#ifndef MAX_SECURE_KEYS
+#define MAX_SECURE_KEYS 4
+#endif
+
+#ifndef MAX_SECURE_GROUP_ADDRESSES
+#define MAX_SECURE_GROUP_ADDRESSES 32
+#endif
+
+// Devices we accept secured frames from
+#ifndef MAX_SECURE_SOURCES
+#define MAX_SECURE_SOURCES 16
+#endif
+
+// Sequence numbers covered by one write of the sequence writer
+#ifndef KNX_SECURE_SEQUENCE_RESERVE
+#define KNX_SECURE_SEQUENCE_RESERVE 256
+#endif
+
+#define KNX_SECURE_APCI 0x03F1
+#define KNX_SECURE_SCF_AUTH 0x00
+#define KNX_SECURE_SCF_AUTH_CONF 0x10
+#define KNX_SECURE_MAC_SIZE 4
+#define KNX_SECURE_SEQUENCE_SIZE 6
+// APCI, SCF, SeqNr and MAC around the plain APDU
+#define KNX_SECURE_OVERHEAD (1 + 1 + KNX_SECURE_SEQUENCE_SIZE + KNX_SECURE_MAC_SIZE)
+#define KNX_SECURE_MAX_APDU (MAX_KNX_TELEGRAM_SIZE - KNX_TELEGRAM_HEADER_SIZE - 2 - KNX_SECURE_OVERHEAD)
+
+// saveState() / loadState() blob, little endian:
+//   'K' 'S', version, reserved sequence (6), count, count x (address,
+//   last sequence (6)), CRC-16/CCITT-FALSE
+#define KNX_SECURE_STATE_VERSION 1
+#define KNX_SECURE_STATE_SIZE(count) (3 + KNX_SECURE_SEQUENCE_SIZE + 1 + (count) * (2 + KNX_SECURE_SEQUENCE_SIZE) + 2)
+
+enum KnxSecureResult {
+  KNX_SECURE_PLAIN,          // Not secured and not required to be
+  KNX_SECURE_OK,             // Verified and decrypted
+  KNX_SECURE_NO_KEY,
+  KNX_SECURE_BAD_MAC,
+  KNX_SECURE_REPLAY,         // Sequence number not above the last one
+  KNX_SECURE_UNKNOWN_SOURCE,
+  KNX_SECURE_NOT_SECURED,    // Plain frame to a secured group address
+  KNX_SECURE_MALFORMED
+};
+
+struct KnxSecureStats {
+  unsigned long sent;
+  unsigned long received;
+  unsigned long rejected;
+  unsigned long replays;
+  unsigned long badMacs;
+};
+
+// Stores the first sequence number to use after a restart. Called before
+// a frame uses a number at or above the previously stored one.
+typedef void (*KnxSequenceWriter)(uint64_t sequence, void* context);
+
+struct KnxSecureGroup {
+  uint16_t address;
+  uint8_t key;
+  uint8_t scf;
+};
+
+struct KnxSecureSource {
+  uint16_t address;
+  uint64_t lastSequence;
+};
+
+class KnxSecure {
+  public:
+    KnxSecure();
+
+    // Expands the key schedule once; returns its index, or -1 if full
+    int addKey(const uint8_t* key);
+    // Frames to address are secured with key; auth-only frames are refused
+    // for confidential addresses
+    bool addGroupAddress(uint16_t address, int key, bool confidential = true);
+    bool isSecureGroupAddress(uint16_t address);
+    // Secured frames are only accepted from known sources
+    bool addSource(uint16_t address, uint64_t lastSequence = 0);
+
+    // Next sequence number to send, e.g. the value last stored by the
+    // sequence writer
+    void setSequence(uint64_t sequence);
+    uint64_t getSequence();
+    void setSequenceWriter(KnxSequenceWriter writer, void* context = NULL);
+
+    // Secures a group frame into out. Returns the secured length, 0 if the
+    // frame stays plain, -1 if it cannot be secured (APDU too long).
+    int secure(const uint8_t* frame, uint8_t* out);
+    // Verifies and decrypts a frame in place
+    KnxSecureResult unsecure(uint8_t* frame);
+    KnxSecureResult getLastResult();
+
+    // Reserved sequence number and the source table, see above
+    int saveState(uint8_t* buffer, int size);
+    bool loadState(const uint8_t* blob, int length);
+
+    KnxSecureStats getStats();
+    void resetStats();
+
+  private:
+    KnxAesKey _keys[MAX_SECURE_KEYS];
+    int _key_count;
+    KnxSecureGroup _groups[MAX_SECURE_GROUP_ADDRESSES];  // sorted
+    int _group_count;
+    KnxSecureSource _sources[MAX_SECURE_SOURCES];        // sorted
+    int _source_count;
+    uint64_t _sequence;
+    uint64_t _reserved;
+    KnxSequenceWriter _sequence_writer;
+    void* _sequence_context;
+    KnxSecureResult _last_result;
+    KnxSecureStats _stats;
+
+    KnxSecureGroup* findGroup(uint16_t);
+    KnxSecureSource* findSource(uint16_t);
+    KnxSecureResult reject(KnxSecureResult);
+    static void ccm(const KnxAesKey*, uint8_t*, int, bool, uint8_t*);
+};
+
+#endif
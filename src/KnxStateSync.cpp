@@ -0,0 +1,171 @@
+// File: KnxStateSync.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxStateSync.h"
+
+#if KNX_FEATURE_ASYNC_READ
+
+#define SYNC_STATUS_MASK 0x0F
+#define SYNC_RETRY_SHIFT 4
+
+KnxStateSync::KnxStateSync(KnxTpUart* knx) {
+  _knx = knx;
+  _addresses = NULL;
+  _status = NULL;
+  _count = 0;
+  _next = 0;
+  _done = 0;
+  _start = 0;
+  _end = 0;
+  _callback = NULL;
+  _timeout = STATE_SYNC_TIMEOUT_MS;
+  for (int i = 0; i < STATE_SYNC_WINDOW; i++) {
+    _in_flight[i].index = -1;
+  }
+}
+
+void KnxStateSync::begin(const char* const* addresses, uint8_t* status, int count) {
+  // Forget reads of a previous run
+  for (int i = 0; i < STATE_SYNC_WINDOW; i++) {
+    if (_in_flight[i].index >= 0) {
+      _knx->releaseRead(_in_flight[i].handle);
+    }
+    _in_flight[i].index = -1;
+  }
+
+  _addresses = addresses;
+  _status = status;
+  _count = count;
+  _next = 0;
+  _done = 0;
+  _start = millis();
+  _end = _start;
+  for (int i = 0; i < count; i++) {
+    _status[i] = KNX_SYNC_WAITING;
+  }
+}
+
+void KnxStateSync::restart() {
+  begin(_addresses, _status, _count);
+}
+
+void KnxStateSync::setAnswerCallback(KnxSyncAnswerCallback callback) {
+  _callback = callback;
+}
+
+void KnxStateSync::setTimeout(unsigned long timeout) {
+  _timeout = timeout;
+}
+
+void KnxStateSync::poll() {
+  if (isComplete()) {
+    return;
+  }
+
+  for (int i = 0; i < STATE_SYNC_WINDOW; i++) {
+    InFlight* slot = &_in_flight[i];
+    if (slot->index < 0) {
+      continue;
+    }
+
+    KnxReadState state = _knx->getReadState(slot->handle);
+    if (state == KNX_READ_PENDING) {
+      continue;
+    }
+
+    int index = slot->index;
+    if (state == KNX_READ_DONE) {
+      if (_callback != NULL) {
+        KnxTelegram answer;
+        _knx->getReadAnswer(slot->handle, &answer);
+        _callback(index, &answer);
+      }
+      finish(index, KNX_SYNC_ANSWERED);
+    }
+    else {
+      int retries = _status[index] >> SYNC_RETRY_SHIFT;
+      if (retries < STATE_SYNC_RETRIES) {
+        _status[index] = ((retries + 1) << SYNC_RETRY_SHIFT) | KNX_SYNC_WAITING;
+        if (index < _next) {
+          _next = index;
+        }
+      }
+      else {
+        finish(index, KNX_SYNC_NO_ANSWER);
+      }
+    }
+
+    _knx->releaseRead(slot->handle);
+    slot->index = -1;
+  }
+
+  // Refill the window
+  for (int i = 0; i < STATE_SYNC_WINDOW; i++) {
+    if (_in_flight[i].index < 0 && !request(&_in_flight[i])) {
+      break;
+    }
+  }
+}
+
+bool KnxStateSync::request(InFlight* slot) {
+  while (_next < _count && (_status[_next] & SYNC_STATUS_MASK) != KNX_SYNC_WAITING) {
+    _next++;
+  }
+  if (_next >= _count) {
+    return false;
+  }
+
+  KnxReadHandle handle = _knx->groupReadAsync(_addresses[_next], _timeout);
+  if (handle < 0) {
+    // Read table or transmit queue full, try again on the next poll
+    return false;
+  }
+
+  slot->index = _next;
+  slot->handle = handle;
+  _status[_next] = (_status[_next] & ~SYNC_STATUS_MASK) | KNX_SYNC_PENDING;
+  _next++;
+  return true;
+}
+
+void KnxStateSync::finish(int index, KnxSyncStatus status) {
+  _status[index] = (_status[index] & ~SYNC_STATUS_MASK) | status;
+  _done++;
+  if (_done == _count) {
+    _end = millis();
+  }
+}
+
+bool KnxStateSync::isComplete() {
+  return _done >= _count;
+}
+
+KnxSyncStatus KnxStateSync::getStatus(int index) {
+  return (KnxSyncStatus) (_status[index] & SYNC_STATUS_MASK);
+}
+
+int KnxStateSync::getAnsweredCount() {
+  int answered = 0;
+  for (int i = 0; i < _count; i++) {
+    answered += (getStatus(i) == KNX_SYNC_ANSWERED) ? 1 : 0;
+  }
+  return answered;
+}
+
+int KnxStateSync::getNoAnswerCount() {
+  int missing = 0;
+  for (int i = 0; i < _count; i++) {
+    missing += (getStatus(i) == KNX_SYNC_NO_ANSWER) ? 1 : 0;
+  }
+  return missing;
+}
+
+unsigned long KnxStateSync::getDuration() {
+  if (isComplete()) {
+    return _end - _start;
+  }
+  return millis() - _start;
+}
+
+#endif
@@ -0,0 +1,83 @@
+// File: KnxStateSync.h
+// Learns the state of many group addresses after a restart. Read requests
+// are pipelined through groupReadAsync() with a bounded number in flight;
+// missing answers are retried. Use together with a transmit queue, whose
+// interval (setTxInterval()) paces the requests on the bus.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxStateSync_h
+#define KnxStateSync_h
+
+#include "Arduino.h"
+
+#include "KnxTpUart.h"
+
+// Built on groupReadAsync(), not declared without it
+#if KNX_FEATURE_ASYNC_READ
+
+// Read requests in flight, limited by the pending read table
+#define STATE_SYNC_WINDOW MAX_PENDING_GROUP_READS
+
+// Additional read requests for an address that did not answer
+#define STATE_SYNC_RETRIES 2
+
+// Default time to wait for one answer
+#define STATE_SYNC_TIMEOUT_MS 1000
+
+enum KnxSyncStatus {
+  KNX_SYNC_WAITING,   // Not requested yet or waiting for a retry
+  KNX_SYNC_PENDING,
+  KNX_SYNC_ANSWERED,
+  KNX_SYNC_NO_ANSWER  // No answer after all retries
+};
+
+// Called for every answer, index is the position in the address list
+typedef void (*KnxSyncAnswerCallback)(int index, KnxTelegram* answer);
+
+class KnxStateSync {
+  public:
+    KnxStateSync(KnxTpUart*);
+
+    // status must hold count bytes, both arrays must outlive the sync
+    void begin(const char* const* addresses, uint8_t* status, int count);
+    // Starts over with the addresses of the last begin()
+    void restart();
+    void setAnswerCallback(KnxSyncAnswerCallback);
+    void setTimeout(unsigned long);
+
+    // Call from loop() after serialEvent()/processTxQueue()
+    void poll();
+
+    bool isComplete();
+    KnxSyncStatus getStatus(int index);
+    int getAnsweredCount();
+    int getNoAnswerCount();
+    // Time from begin() until complete (or until now while running)
+    unsigned long getDuration();
+
+  private:
+    struct InFlight {
+      int index;  // -1 if unused
+      KnxReadHandle handle;
+    };
+
+    KnxTpUart* _knx;
+    const char* const* _addresses;
+    uint8_t* _status;  // KnxSyncStatus in the low nibble, retries in the high nibble
+    int _count;
+    int _next;         // Where to look for the next waiting address
+    int _done;
+    unsigned long _start;
+    unsigned long _end;
+    unsigned long _timeout;
+    KnxSyncAnswerCallback _callback;
+    InFlight _in_flight[STATE_SYNC_WINDOW];
+
+    void finish(int index, KnxSyncStatus status);
+    bool request(InFlight* slot);
+};
+
+#endif
+
+#endif
@@ -6,7 +6,7 @@
 // Modified: Mag Gyver (Since 2016)
 // Modified: Rouven Raudzus (Since 2017)
 
-// Last modified: 04.06.2024
+// Last modified: 18.10.2026
 
 #include "KnxTelegram.h"
 
@@ -24,12 +24,19 @@ void KnxTelegram::clear() {
 
   // Target Group Address, Routing Counter = 6, Length = 1 (= 2 Bytes)
   buffer[5] = 0b11100001;
+
+  startTime = 0;
+  endTime = 0;
 }
 
 int KnxTelegram::getBufferByte(int index) {
   return buffer[index];
 }
 
+const uint8_t* KnxTelegram::getBuffer() {
+  return buffer;
+}
+
 void KnxTelegram::setBufferByte(int index, int content) {
   buffer[index] = content;
 }
@@ -108,6 +115,11 @@ int KnxTelegram::getTargetSubGroup() {
   return buffer[4];
 }
 
+// Main, middle and sub group as one 16 bit value (5/3/8 bits)
+uint16_t KnxTelegram::getTargetGroupAddress() {
+  return ((unsigned int) buffer[3] << 8) | buffer[4];
+}
+
 int KnxTelegram::getTargetArea() {
   return ((buffer[3] & 0b11110000) >> 4);
 }
@@ -121,8 +133,9 @@ int KnxTelegram::getTargetMember() {
 }
 
 void KnxTelegram::setRoutingCounter(int counter) {
-  buffer[5] = buffer[5] & 0b10000000;
-  buffer[5] = buffer[5] | (counter << 4);
+  // Keep the address type and the payload length
+  buffer[5] = buffer[5] & 0b10001111;
+  buffer[5] = buffer[5] | ((counter & 0b111) << 4);
 }
 
 int KnxTelegram::getRoutingCounter() {
@@ -178,6 +191,19 @@ void KnxTelegram::setSequenceNumber(int number) {
   buffer[6] = buffer[6] | (number << 2);
 }
 
+void KnxTelegram::setTimestamps(unsigned long start, unsigned long end) {
+  startTime = start;
+  endTime = end;
+}
+
+unsigned long KnxTelegram::getStartTime() {
+  return startTime;
+}
+
+unsigned long KnxTelegram::getEndTime() {
+  return endTime;
+}
+
 void KnxTelegram::createChecksum() {
   int checksumPos = getPayloadLength() + KNX_TELEGRAM_HEADER_SIZE;
   buffer[checksumPos] = calculateChecksum();
@@ -349,7 +375,10 @@ int KnxTelegram::get2ByteIntValue() {
 
 void KnxTelegram::set2ByteFloatValue(float value) {
   setPayloadLength(4);
+  encode2ByteFloat(value, &buffer[8]);
+}
 
+void KnxTelegram::encode2ByteFloat(float value, uint8_t* out) {
   float v = value * 100.0f;
   int exponent = 0;
   for (; v < -2048.0f; v /= 2) exponent++;
@@ -357,8 +386,8 @@ void KnxTelegram::set2ByteFloatValue(float value) {
   long m = (int)round(v) & 0x7FF;
   short msb = (short) (exponent << 3 | m >> 8);
   if (value < 0.0f) msb |= 0x80;
-  buffer[8] = msb;
-  buffer[9] = (byte)m;
+  out[0] = msb;
+  out[1] = (byte)m;
 }
 
 float KnxTelegram::get2ByteFloatValue() {
@@ -377,6 +406,7 @@ float KnxTelegram::get2ByteFloatValue() {
   return (mantissa * 0.01) * pow(2.0, exponent);
 }
 
+#if KNX_FEATURE_DPT_EXTENDED
 void KnxTelegram::set3ByteTime(int weekday, int hour, int minute, int second) {
   setPayloadLength(5);
 
@@ -461,18 +491,22 @@ int KnxTelegram::get3ByteYearValue() {
   }
   return (buffer[10] & 0b01111111);
 }
+#endif
 
 void KnxTelegram::set4ByteFloatValue(float value) {
   setPayloadLength(6);
+  encode4ByteFloat(value, &buffer[8]);
+}
 
+void KnxTelegram::encode4ByteFloat(float value, uint8_t* out) {
   byte b[4];
   float *f = (float*)(void*) & (b[0]);
   *f = value;
 
-  buffer[8 + 3] = b[0];
-  buffer[8 + 2] = b[1];
-  buffer[8 + 1] = b[2];
-  buffer[8 + 0] = b[3];
+  out[3] = b[0];
+  out[2] = b[1];
+  out[1] = b[2];
+  out[0] = b[3];
 }
 
 float KnxTelegram::get4ByteFloatValue() {
@@ -490,6 +524,258 @@ float KnxTelegram::get4ByteFloatValue() {
   return r;
 }
 
+void KnxTelegram::set1ByteSceneValue(int scene, bool learn) {
+  setPayloadLength(3);
+
+  // Buffer [8] bit 7 learn, bit 6 empty, bit 0-5 scene number [0-63]
+  buffer[8] = (learn ? 0b10000000 : 0) | (scene & 0b00111111);
+}
+
+int KnxTelegram::get1ByteSceneNumberValue() {
+  if (getPayloadLength() != 3) {
+    // Wrong payload length
+    return 0;
+  }
+  return (buffer[8] & 0b00111111);
+}
+
+bool KnxTelegram::get1ByteSceneLearnValue() {
+  if (getPayloadLength() != 3) {
+    // Wrong payload length
+    return 0;
+  }
+  return (buffer[8] & 0b10000000) >> 7;
+}
+
+#if KNX_FEATURE_DPT_EXTENDED
+void KnxTelegram::set3ByteColorValue(int red, int green, int blue) {
+  setPayloadLength(5);
+  buffer[8] = red;
+  buffer[9] = green;
+  buffer[10] = blue;
+}
+
+int KnxTelegram::get3ByteRedValue() {
+  if (getPayloadLength() != 5) {
+    // Wrong payload length
+    return 0;
+  }
+  return buffer[8];
+}
+
+int KnxTelegram::get3ByteGreenValue() {
+  if (getPayloadLength() != 5) {
+    // Wrong payload length
+    return 0;
+  }
+  return buffer[9];
+}
+
+int KnxTelegram::get3ByteBlueValue() {
+  if (getPayloadLength() != 5) {
+    // Wrong payload length
+    return 0;
+  }
+  return buffer[10];
+}
+
+void KnxTelegram::set4ByteUIntValue(uint32_t value) {
+  setPayloadLength(6);
+  buffer[8] = value >> 24;
+  buffer[9] = (value >> 16) & 0xFF;
+  buffer[10] = (value >> 8) & 0xFF;
+  buffer[11] = value & 0xFF;
+}
+
+uint32_t KnxTelegram::get4ByteUIntValue() {
+  if (getPayloadLength() != 6) {
+    // Wrong payload length
+    return 0;
+  }
+  return ((uint32_t) buffer[8] << 24) | ((uint32_t) buffer[9] << 16) | ((uint32_t) buffer[10] << 8) | buffer[11];
+}
+
+void KnxTelegram::set4ByteIntValue(int32_t value) {
+  set4ByteUIntValue((uint32_t) value);
+}
+
+int32_t KnxTelegram::get4ByteIntValue() {
+  return (int32_t) get4ByteUIntValue();
+}
+
+void KnxTelegram::set6ByteRGBWValue(int red, int green, int blue, int white) {
+  setPayloadLength(8);
+  buffer[8] = red;
+  buffer[9] = green;
+  buffer[10] = blue;
+  buffer[11] = white;
+
+  // Buffer [12] reserved, buffer [13] bit 0-3 validity of W, B, G and R
+  buffer[12] = 0;
+  buffer[13] = 0b00001111;
+}
+
+int KnxTelegram::get6ByteRedValue() {
+  if (getPayloadLength() != 8) {
+    // Wrong payload length
+    return 0;
+  }
+  return buffer[8];
+}
+
+int KnxTelegram::get6ByteGreenValue() {
+  if (getPayloadLength() != 8) {
+    // Wrong payload length
+    return 0;
+  }
+  return buffer[9];
+}
+
+int KnxTelegram::get6ByteBlueValue() {
+  if (getPayloadLength() != 8) {
+    // Wrong payload length
+    return 0;
+  }
+  return buffer[10];
+}
+
+int KnxTelegram::get6ByteWhiteValue() {
+  if (getPayloadLength() != 8) {
+    // Wrong payload length
+    return 0;
+  }
+  return buffer[11];
+}
+
+static uint16_t encodeChromaticity(float value) {
+  if (value <= 0) {
+    return 0;
+  }
+  if (value >= 1) {
+    return 65535;
+  }
+  return value * 65535.0f + 0.5f;
+}
+
+void KnxTelegram::set6ByteXYYValue(float x, float y, int brightness) {
+  setPayloadLength(8);
+
+  // Buffer [8-9] x and [10-11] y coordinate, 0..1 scaled to 0..65535
+  uint16_t cx = encodeChromaticity(x);
+  uint16_t cy = encodeChromaticity(y);
+  buffer[8] = cx >> 8;
+  buffer[9] = cx & 0xFF;
+  buffer[10] = cy >> 8;
+  buffer[11] = cy & 0xFF;
+  buffer[12] = brightness;
+
+  // Buffer [13] bit 1 colour valid, bit 0 brightness valid
+  buffer[13] = 0b00000011;
+}
+
+float KnxTelegram::get6ByteColorXValue() {
+  if (getPayloadLength() != 8) {
+    // Wrong payload length
+    return 0;
+  }
+  return ((buffer[8] << 8) | buffer[9]) / 65535.0f;
+}
+
+float KnxTelegram::get6ByteColorYValue() {
+  if (getPayloadLength() != 8) {
+    // Wrong payload length
+    return 0;
+  }
+  return ((buffer[10] << 8) | buffer[11]) / 65535.0f;
+}
+
+int KnxTelegram::get6ByteBrightnessValue() {
+  if (getPayloadLength() != 8) {
+    // Wrong payload length
+    return 0;
+  }
+  return buffer[12];
+}
+
+void KnxTelegram::set8ByteDateTime(int year, int month, int day, int weekday, int hour, int minute, int second) {
+  setPayloadLength(10);
+
+  // Buffer [8] year - 1900
+  buffer[8] = year - 1900;
+
+  // Buffer [9] bit 0-3 month [1-12], buffer [10] bit 0-4 day [1-31]
+  buffer[9] = month & 0b00001111;
+  buffer[10] = day & 0b00011111;
+
+  // Buffer [11] bit 5-7 weekday [0-7], bit 0-4 hour [0-24]
+  buffer[11] = ((weekday & 0b00000111) << 5) | (hour & 0b00011111);
+
+  // Buffer [12] bit 0-5 minutes, buffer [13] bit 0-5 seconds
+  buffer[12] = minute & 0b00111111;
+  buffer[13] = second & 0b00111111;
+
+  // Buffer [14] flags: only "no working day" (bit 5) set, all fields valid
+  // Buffer [15] bit 7 clock without external sync signal
+  buffer[14] = 0b00100000;
+  buffer[15] = 0;
+}
+
+int KnxTelegram::get8ByteYearValue() {
+  if (getPayloadLength() != 10) {
+    // Wrong payload length
+    return 0;
+  }
+  return 1900 + buffer[8];
+}
+
+int KnxTelegram::get8ByteMonthValue() {
+  if (getPayloadLength() != 10) {
+    // Wrong payload length
+    return 0;
+  }
+  return (buffer[9] & 0b00001111);
+}
+
+int KnxTelegram::get8ByteDayValue() {
+  if (getPayloadLength() != 10) {
+    // Wrong payload length
+    return 0;
+  }
+  return (buffer[10] & 0b00011111);
+}
+
+int KnxTelegram::get8ByteWeekdayValue() {
+  if (getPayloadLength() != 10) {
+    // Wrong payload length
+    return 0;
+  }
+  return (buffer[11] & 0b11100000) >> 5;
+}
+
+int KnxTelegram::get8ByteHourValue() {
+  if (getPayloadLength() != 10) {
+    // Wrong payload length
+    return 0;
+  }
+  return (buffer[11] & 0b00011111);
+}
+
+int KnxTelegram::get8ByteMinuteValue() {
+  if (getPayloadLength() != 10) {
+    // Wrong payload length
+    return 0;
+  }
+  return (buffer[12] & 0b00111111);
+}
+
+int KnxTelegram::get8ByteSecondValue() {
+  if (getPayloadLength() != 10) {
+    // Wrong payload length
+    return 0;
+  }
+  return (buffer[13] & 0b00111111);
+}
+
 void KnxTelegram::set14ByteValue(String value) {
   // Define
   char _load[15];
@@ -540,3 +826,4 @@ String KnxTelegram::get14ByteValue() {
   _load[13] = buffer[8 + 13];
   return (_load);
 }
+#endif
@@ -5,12 +5,13 @@
 // Modified: Katja Blankenheim (Since 2014)
 // Modified: Mag Gyver (Since 2016)
 
-// Last modified: 06.06.2017
+// Last modified: 18.10.2026
 
 #ifndef KnxTelegram_h
 #define KnxTelegram_h
 
 #include "Arduino.h"
+#include "KnxFeatures.h"
 
 #define MAX_KNX_TELEGRAM_SIZE 23
 #define KNX_TELEGRAM_HEADER_SIZE 6
@@ -33,6 +34,9 @@ enum KnxCommandType {
   KNX_COMMAND_INDIVIDUAL_ADDR_WRITE = 0b0011,
   KNX_COMMAND_INDIVIDUAL_ADDR_REQUEST = 0b0100,
   KNX_COMMAND_INDIVIDUAL_ADDR_RESPONSE = 0b0101,
+  KNX_COMMAND_MEMORY_READ = 0b1000,
+  KNX_COMMAND_MEMORY_RESPONSE = 0b1001,
+  KNX_COMMAND_MEMORY_WRITE = 0b1010,
   KNX_COMMAND_MASK_VERSION_READ = 0b1100,
   KNX_COMMAND_MASK_VERSION_RESPONSE = 0b1101,
   KNX_COMMAND_RESTART = 0b1110,
@@ -42,7 +46,10 @@ enum KnxCommandType {
 // Extended (escaped) KNX commands
 enum KnxExtendedCommandType {
   KNX_EXT_COMMAND_AUTH_REQUEST = 0b010001,
-  KNX_EXT_COMMAND_AUTH_RESPONSE = 0b010010
+  KNX_EXT_COMMAND_AUTH_RESPONSE = 0b010010,
+  KNX_EXT_COMMAND_PROPERTY_VALUE_READ = 0b010101,
+  KNX_EXT_COMMAND_PROPERTY_VALUE_RESPONSE = 0b010110,
+  KNX_EXT_COMMAND_PROPERTY_VALUE_WRITE = 0b010111
 };
 
 // KNX Transport Layer Communication Type
@@ -68,6 +75,8 @@ class KnxTelegram {
     void clear();
     void setBufferByte(int index, int content);
     int getBufferByte(int index);
+    // Raw frame bytes, e.g. for KnxTelegramView
+    const uint8_t* getBuffer();
     void setPayloadLength(int size);
     int getPayloadLength();
     void setRepeated(bool repeat);
@@ -84,6 +93,7 @@ class KnxTelegram {
     int getTargetMainGroup();
     int getTargetMiddleGroup();
     int getTargetSubGroup();
+    uint16_t getTargetGroupAddress();
     int getTargetArea();
     int getTargetLine();
     int getTargetMember();
@@ -107,7 +117,9 @@ class KnxTelegram {
     int get2ByteIntValue();
     void set2ByteFloatValue(float value);
     float get2ByteFloatValue();
+    static void encode2ByteFloat(float value, uint8_t* out);
 
+#if KNX_FEATURE_DPT_EXTENDED
     void set3ByteTime(int weekday, int hour, int minute, int second);
     int get3ByteWeekdayValue();
     int get3ByteHourValue();
@@ -117,12 +129,59 @@ class KnxTelegram {
     int get3ByteDayValue();
     int get3ByteMonthValue();
     int get3ByteYearValue();
+#endif
+
+    // DPT 17.001 scene number (learn = false) and 18.001 scene control
+    void set1ByteSceneValue(int scene, bool learn);
+    int get1ByteSceneNumberValue();
+    bool get1ByteSceneLearnValue();
+
+#if KNX_FEATURE_DPT_EXTENDED
+    // DPT 232.600 RGB
+    void set3ByteColorValue(int red, int green, int blue);
+    int get3ByteRedValue();
+    int get3ByteGreenValue();
+    int get3ByteBlueValue();
+#endif
 
     void set4ByteFloatValue(float value);
     float get4ByteFloatValue();
+    static void encode4ByteFloat(float value, uint8_t* out);
+
+#if KNX_FEATURE_DPT_EXTENDED
+    // DPT 12.001 unsigned and DPT 13.001 signed counters
+    void set4ByteUIntValue(uint32_t value);
+    uint32_t get4ByteUIntValue();
+    void set4ByteIntValue(int32_t value);
+    int32_t get4ByteIntValue();
+
+    // DPT 251.600 RGBW, all four components marked valid
+    void set6ByteRGBWValue(int red, int green, int blue, int white);
+    int get6ByteRedValue();
+    int get6ByteGreenValue();
+    int get6ByteBlueValue();
+    int get6ByteWhiteValue();
+
+    // DPT 242.600 xyY, chromaticity 0..1 and brightness 0..255
+    void set6ByteXYYValue(float x, float y, int brightness);
+    float get6ByteColorXValue();
+    float get6ByteColorYValue();
+    int get6ByteBrightnessValue();
+
+    // DPT 19.001 date and time, year 1900..2155, weekday 1 (Monday) to
+    // 7 or 0 for any day
+    void set8ByteDateTime(int year, int month, int day, int weekday, int hour, int minute, int second);
+    int get8ByteYearValue();
+    int get8ByteMonthValue();
+    int get8ByteDayValue();
+    int get8ByteWeekdayValue();
+    int get8ByteHourValue();
+    int get8ByteMinuteValue();
+    int get8ByteSecondValue();
 
     void set14ByteValue(String value);
     String get14ByteValue();
+#endif
 
     void createChecksum();
     bool verifyChecksum();
@@ -135,8 +194,15 @@ class KnxTelegram {
     void setSequenceNumber(int);
     KnxControlDataType getControlData();
     void setControlData(KnxControlDataType);
+
+    // micros() when the control byte arrived and when the frame was complete
+    void setTimestamps(unsigned long start, unsigned long end);
+    unsigned long getStartTime();
+    unsigned long getEndTime();
   private:
-    int buffer[MAX_KNX_TELEGRAM_SIZE];
+    uint8_t buffer[MAX_KNX_TELEGRAM_SIZE];
+    unsigned long startTime;
+    unsigned long endTime;
     int calculateChecksum();
 
 };
@@ -0,0 +1,118 @@
+// File: KnxTelegramView.h
+// Read-only view over the raw bytes of a frame (receive ring, capture file,
+// transmit slot or KnxTelegram::getBuffer()). Same accessors as KnxTelegram,
+// but inline and constexpr, and nothing is copied. The view does not own
+// the bytes; they must stay valid while it is used.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxTelegramView_h
+#define KnxTelegramView_h
+
+#include "KnxTelegram.h"
+
+class KnxTelegramView {
+  public:
+    constexpr KnxTelegramView(const uint8_t* frame) : buffer(frame) {}
+
+    constexpr const uint8_t* getBuffer() const {
+      return buffer;
+    }
+    constexpr uint8_t getBufferByte(int index) const {
+      return buffer[index];
+    }
+
+    constexpr bool isRepeated() const {
+      return !(buffer[0] & 0b00100000);
+    }
+    constexpr KnxPriorityType getPriority() const {
+      return (KnxPriorityType) ((buffer[0] & 0b00001100) >> 2);
+    }
+
+    constexpr int getSourceArea() const {
+      return buffer[1] >> 4;
+    }
+    constexpr int getSourceLine() const {
+      return buffer[1] & 0b00001111;
+    }
+    constexpr int getSourceMember() const {
+      return buffer[2];
+    }
+    // Area, line and member as one 16 bit value (4/4/8 bits)
+    constexpr uint16_t getSourceAddress() const {
+      return ((unsigned int) buffer[1] << 8) | buffer[2];
+    }
+
+    constexpr bool isTargetGroup() const {
+      return buffer[5] & 0b10000000;
+    }
+    constexpr int getTargetMainGroup() const {
+      return (buffer[3] & 0b11111000) >> 3;
+    }
+    constexpr int getTargetMiddleGroup() const {
+      return buffer[3] & 0b00000111;
+    }
+    constexpr int getTargetSubGroup() const {
+      return buffer[4];
+    }
+    constexpr int getTargetArea() const {
+      return (buffer[3] & 0b11110000) >> 4;
+    }
+    constexpr int getTargetLine() const {
+      return buffer[3] & 0b00001111;
+    }
+    constexpr int getTargetMember() const {
+      return buffer[4];
+    }
+    // Group (5/3/8 bits) or individual (4/4/8 bits) target as 16 bit value,
+    // check isTargetGroup() to know which one
+    constexpr uint16_t getTargetAddress() const {
+      return ((unsigned int) buffer[3] << 8) | buffer[4];
+    }
+
+    constexpr int getRoutingCounter() const {
+      return (buffer[5] & 0b01110000) >> 4;
+    }
+    constexpr int getPayloadLength() const {
+      return (buffer[5] & 0b00001111) + 1;
+    }
+    constexpr int getTotalLength() const {
+      return KNX_TELEGRAM_HEADER_SIZE + getPayloadLength() + 1;
+    }
+
+    constexpr KnxCommunicationType getCommunicationType() const {
+      return (KnxCommunicationType) ((buffer[6] & 0b11000000) >> 6);
+    }
+    constexpr int getSequenceNumber() const {
+      return (buffer[6] & 0b00111100) >> 2;
+    }
+    constexpr KnxControlDataType getControlData() const {
+      return (KnxControlDataType) (buffer[6] & 0b00000011);
+    }
+    constexpr KnxCommandType getCommand() const {
+      return (KnxCommandType) (((buffer[6] & 0b00000011) << 2) | ((buffer[7] & 0b11000000) >> 6));
+    }
+    constexpr int getFirstDataByte() const {
+      return buffer[7] & 0b00111111;
+    }
+    constexpr bool getBool() const {
+      return getPayloadLength() == 2 && (buffer[7] & 0b00000001);
+    }
+
+    constexpr int getChecksum() const {
+      return buffer[getTotalLength() - 1];
+    }
+    constexpr bool verifyChecksum() const {
+      return calculateChecksum(0, 0xFF) == getChecksum();
+    }
+
+  private:
+    const uint8_t* buffer;
+
+    // Recursive so it stays a single return statement (C++11 constexpr)
+    constexpr int calculateChecksum(int index, int bcc) const {
+      return index >= getTotalLength() - 1 ? bcc : calculateChecksum(index + 1, bcc ^ buffer[index]);
+    }
+};
+
+#endif
@@ -5,28 +5,149 @@
 // Modified: Katja Blankenheim (Since 2014)
 // Modified: Mag Gyver (Since 2016)
 
-// Last modified: 06.06.2017
+// Last modified: 18.10.2026
 
 #include "KnxTpUart.h"
 
-KnxTpUart::KnxTpUart(TPUART_SERIAL_CLASS* sport, String address) {
+#if defined(ARDUINO_ARCH_ESP32)
+portMUX_TYPE knxCriticalMux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+KnxTpUart::KnxTpUart(TPUART_SERIAL_CLASS* sport, String address)
+  : KnxTpUart(sport, individualAddressFromString(address)) {
+}
+
+KnxTpUart::KnxTpUart(TPUART_SERIAL_CLASS* sport, uint16_t individualAddress) {
   _serialport = sport;
-  _source_area = address.substring(0, address.indexOf('.')).toInt();
-  _source_line = address.substring(address.indexOf('.') + 1, address.length()).substring(0, address.substring(address.indexOf('.') + 1, address.length()).indexOf('.')).toInt();
-  _source_member = address.substring(address.lastIndexOf('.') + 1, address.length()).toInt();
+  _source_area = individualAddress >> 12;
+  _source_line = (individualAddress >> 8) & 0x0F;
+  _source_member = individualAddress & 0xFF;
   _listen_group_address_count = 0;
-  _tg = new KnxTelegram();
-  _tg_ptp = new KnxTelegram();
   _listen_to_broadcasts = false;
+  _tx_interval = SERIAL_WRITE_DELAY_MS;
+#if KNX_FEATURE_TX_QUEUE
+  _tx_queue = NULL;
+  _last_tx_time = 0;
+#endif
+#if KNX_FEATURE_RX_RING
+  _rx_ring = NULL;
+#endif
+#if KNX_DIAGNOSTICS >= 2
+  _latency_stats = NULL;
+  _last_tx_timing.queued = 0;
+  _last_tx_timing.start = 0;
+  _last_tx_timing.confirmed = 0;
+#endif
+  _mode = KNX_MODE_NORMAL;
+#if KNX_DIAGNOSTICS >= 1
+  _monitor_ring = NULL;
+  _capture = NULL;
+  _traffic = NULL;
+#endif
+  _hardware_ack = false;
+  KNX_TRACE_INIT();
+  _product_id = -1;
+#if KNX_FEATURE_DEVICE_SERVICES
+  _transport = NULL;
+  _device_memory = NULL;
+  _priority_length = 0;
+  _in_serial_event = false;
+#endif
+#if KNX_FEATURE_VIRTUAL_DEVICES
+  _virtual_devices = NULL;
+#endif
+#if KNX_FEATURE_COUPLER
+  _coupler = NULL;
+  _coupler_port = 0;
+#endif
+#if KNX_FEATURE_SECURE
+  _secure = NULL;
+#endif
+#if KNX_FEATURE_RESET_RECOVERY
+  _recovery = NULL;
+  _recovering = false;
+#endif
+  _tx_confirm_handler = NULL;
+  _tx_confirm_context = NULL;
+  _deferred_frame_count = 0;
+#if KNX_FEATURE_ASYNC_READ
+  for (int i = 0; i < MAX_PENDING_GROUP_READS; i++) {
+    _pending_reads[i].state = KNX_READ_FREE;
+    _pending_reads[i].generation = 0;
+    _pending_reads[i].sent = false;
+  }
+#endif
 }
 
+#if KNX_FEATURE_TX_QUEUE
+void KnxTpUart::setTxQueue(KnxTxQueue* queue) {
+  _tx_queue = queue;
+}
+#endif
+
+#if KNX_FEATURE_RX_RING
+void KnxTpUart::setRxRing(KnxRxRing* ring) {
+  _rx_ring = ring;
+}
+#endif
+
+#if KNX_DIAGNOSTICS >= 2
+void KnxTpUart::setLatencyStats(KnxLatencyStats* stats) {
+  _latency_stats = stats;
+}
+
+KnxTxTiming KnxTpUart::getLastTxTiming() {
+  return _last_tx_timing;
+}
+#endif
+
 void KnxTpUart::setListenToBroadcasts(bool listen) {
   _listen_to_broadcasts = listen;
 }
 
+#if KNX_FEATURE_DEVICE_SERVICES
+void KnxTpUart::setTransport(KnxTransport* transport) {
+  _transport = transport;
+}
+
+void KnxTpUart::setDeviceMemory(KnxDeviceMemory* memory) {
+  _device_memory = memory;
+}
+#endif
+
+#if KNX_FEATURE_VIRTUAL_DEVICES
+void KnxTpUart::setVirtualDevices(KnxVirtualDevices* devices) {
+  _virtual_devices = devices;
+}
+#endif
+
+#if KNX_FEATURE_SECURE
+void KnxTpUart::setSecure(KnxSecure* secure) {
+  _secure = secure;
+}
+#endif
+
+#if KNX_FEATURE_RESET_RECOVERY
+void KnxTpUart::setResetRecovery(KnxResetRecovery* recovery) {
+  _recovery = recovery;
+}
+#endif
+
+#if KNX_FEATURE_COUPLER
+void KnxTpUart::setCoupler(KnxCoupler* coupler, int port) {
+  _coupler = coupler;
+  _coupler_port = port;
+}
+#endif
+
 void KnxTpUart::uartReset() {
   byte sendByte = 0x01;
   _serialport->write(sendByte);
+
+  // The reset also ends the busmonitor mode
+  if (_mode == KNX_MODE_BUSMONITOR) {
+    _mode = KNX_MODE_NORMAL;
+  }
 }
 
 void KnxTpUart::uartStateRequest() {
@@ -34,19 +155,171 @@ void KnxTpUart::uartStateRequest() {
   _serialport->write(sendByte);
 }
 
+void KnxTpUart::uartActivateBusmonitor() {
+  byte sendByte = TPUART_ACTIVATE_BUSMON;
+  _serialport->write(sendByte);
+  _mode = KNX_MODE_BUSMONITOR;
+}
+
+void KnxTpUart::setPassiveListen(bool passive) {
+  if (_mode != KNX_MODE_BUSMONITOR) {
+    _mode = passive ? KNX_MODE_PASSIVE : KNX_MODE_NORMAL;
+  }
+}
+
+KnxTpUartMode KnxTpUart::getMode() {
+  return _mode;
+}
+
+bool KnxTpUart::uartEnableHardwareAck() {
+  byte sendByte = TPUART2_PRODUCT_ID_REQUEST;
+  _serialport->write(sendByte);
+
+  // The first TP-UART ignores the request
+  _product_id = -1;
+  unsigned long startTime = millis();
+  while (_product_id < 0 && (millis() - startTime) <= TPUART2_DETECT_TIMEOUT_MS) {
+    if (rxAvailable() == 0) {
+      delay(1);
+    }
+    else if (isKNXControlByte(rxPeek())) {
+      readKNXTelegram();
+    }
+    else if (rxPeek() == TPUART_RESET_INDICATION_BYTE || (rxPeek() & 0b111) == 0b111) {
+      serialRead();  // Reset or state indication
+    }
+    else {
+      _product_id = serialRead();
+    }
+  }
+
+  _hardware_ack = _product_id >= 0;
+  if (_hardware_ack) {
+    uartSetAddress();
+  }
+  return _hardware_ack;
+}
+
+bool KnxTpUart::hasHardwareAck() {
+  return _hardware_ack;
+}
+
+int KnxTpUart::getProductId() {
+  return _product_id;
+}
+
+void KnxTpUart::uartSetAddress() {
+  // U_SetAddress takes high byte, low byte and a dummy byte, U_Configure
+  // follows as a service of its own
+  uint16_t address = getIndividualAddress();
+  byte sendbuf[5];
+  sendbuf[0] = TPUART2_SET_ADDRESS;
+  sendbuf[1] = address >> 8;
+  sendbuf[2] = address & 0xFF;
+  sendbuf[3] = 0;
+  sendbuf[4] = TPUART2_CONFIGURE | TPUART2_CONFIGURE_FLAGS;
+  _serialport->write(sendbuf, 5);
+}
+
+void KnxTpUart::recoverFromReset() {
+  // The chip is back in its power-up state
+  if (_hardware_ack) {
+    // The reset cleared the address of the TP-UART2
+    uartSetAddress();
+  }
+  if (_mode == KNX_MODE_BUSMONITOR) {
+    byte sendByte = TPUART_ACTIVATE_BUSMON;
+    _serialport->write(sendByte);
+    return;
+  }
+
+#if KNX_FEATURE_RESET_RECOVERY
+  if (_recovery == NULL || _recovering) {
+    return;
+  }
+
+  _recovering = true;
+  _recovery->begin();
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  int length;
+  // Stops early if the chip resets again, the next indication continues
+  while (rxPeek() != TPUART_RESET_INDICATION_BYTE && _recovery->next(frame, &length)) {
+    bool confirmed = sendFrame(frame, length, micros());
+    if (!confirmed && rxPeek() == TPUART_RESET_INDICATION_BYTE) {
+      _recovery->remember(frame, length);
+    }
+    else {
+      _recovery->replayed(confirmed);
+    }
+  }
+  _recovery->end();
+  _recovering = false;
+#endif
+}
+
+#if KNX_DIAGNOSTICS >= 1
+void KnxTpUart::setMonitorRing(KnxMonitorRing* ring) {
+  _monitor_ring = ring;
+}
+
+void KnxTpUart::setCaptureWriter(KnxCaptureWriter* capture) {
+  _capture = capture;
+}
+
+void KnxTpUart::setTrafficStats(KnxTrafficStats* traffic) {
+  _traffic = traffic;
+}
+#endif
+
 void KnxTpUart::setIndividualAddress(int area, int line, int member) {
   _source_area = area;
   _source_line = line;
   _source_member = member;
+
+  if (_hardware_ack) {
+    uartSetAddress();
+  }
+}
+
+uint16_t KnxTpUart::getIndividualAddress() {
+  return ((unsigned int) _source_area << 12) | (_source_line << 8) | _source_member;
 }
 
 KnxTpUartSerialEventType KnxTpUart::serialEvent() {
-  while (_serialport->available() > 0) {
+#if KNX_FEATURE_DEVICE_SERVICES
+  _in_serial_event = true;
+  KnxTpUartSerialEventType event = receiveEvent();
+  _in_serial_event = false;
+  flushPriority();
+  return event;
+#else
+  return receiveEvent();
+#endif
+}
+
+KnxTpUartSerialEventType KnxTpUart::receiveEvent() {
+  if (_deferred_frame_count > 0) {
+    return deferredFrameEvent();
+  }
+
+  while (rxAvailable() > 0) {
     checkErrors();
 
-    int incomingByte = _serialport->peek();
+    int incomingByte = rxPeek();
     printByte(incomingByte);
 
+    // Only frames are monitored in passive mode, the UART services still
+    // come from the TP-UART. In busmonitor mode everything is bus traffic
+    // except the reset indication, see recoverFromReset().
+    if ((_mode == KNX_MODE_PASSIVE && isKNXControlByte(incomingByte))
+        || (_mode == KNX_MODE_BUSMONITOR && incomingByte != TPUART_RESET_INDICATION_BYTE)) {
+      monitorBusByte(incomingByte);
+#if defined(TPUART_DEBUG)
+      TPUART_DEBUG_PORT.println("Event KNX_MONITOR_RECORD");
+#endif
+      return KNX_MONITOR_RECORD;
+    }
+
     if (isKNXControlByte(incomingByte)) {
       bool interested = readKNXTelegram();
       if (interested) {
@@ -64,6 +337,7 @@ KnxTpUartSerialEventType KnxTpUart::serialEvent() {
     }
     else if (incomingByte == TPUART_RESET_INDICATION_BYTE) {
       serialRead();
+      recoverFromReset();
 #if defined(TPUART_DEBUG)
       TPUART_DEBUG_PORT.println("Event TPUART_RESET_INDICATION");
 #endif
@@ -134,303 +408,778 @@ void KnxTpUart::printByte(int incomingByte) {
 #endif
 }
 
-bool KnxTpUart::readKNXTelegram() {
-  // Receive header
-  for (int i = 0; i < 6; i++) {
-    _tg->setBufferByte(i, serialRead());
+bool KnxTpUart::hasDeferredFrames() {
+  return _deferred_frame_count > 0;
+}
+
+KnxTpUartSerialEventType KnxTpUart::deferredFrameEvent() {
+  // Copied out first, processing may send and defer further frames
+  KnxDeferredFrame deferred = _deferred_frames[0];
+  _deferred_frame_count--;
+  for (int i = 0; i < _deferred_frame_count; i++) {
+    _deferred_frames[i] = _deferred_frames[i + 1];
   }
 
+  if (_mode != KNX_MODE_NORMAL) {
+    monitorFrame(deferred.frame, deferred.start, deferred.end);
 #if defined(TPUART_DEBUG)
-  TPUART_DEBUG_PORT.print("Payload Length: ");
-  TPUART_DEBUG_PORT.println(_tg->getPayloadLength());
+    TPUART_DEBUG_PORT.println("Event KNX_MONITOR_RECORD");
 #endif
-  int bufpos = 6;
-  for (int i = 0; i < _tg->getPayloadLength(); i++) {
-    _tg->setBufferByte(bufpos, serialRead());
-    bufpos++;
+    return KNX_MONITOR_RECORD;
+  }
+  if (processTelegram(deferred.frame, deferred.start, deferred.end, deferred.interested)) {
+#if defined(TPUART_DEBUG)
+    TPUART_DEBUG_PORT.println("Event KNX_TELEGRAM");
+#endif
+    return KNX_TELEGRAM;
+  }
+#if defined(TPUART_DEBUG)
+  TPUART_DEBUG_PORT.println("Event IRRELEVANT_KNX_TELEGRAM");
+#endif
+  return IRRELEVANT_KNX_TELEGRAM;
+}
+
+void KnxTpUart::deferTelegram() {
+  // Acknowledged like any other frame, but nothing is processed (and
+  // nothing sent) until the confirmation is in
+  bool passive = _mode != KNX_MODE_NORMAL;
+  if (_deferred_frame_count >= TPUART_DEFERRED_FRAMES) {
+    // No acknowledge, the sender repeats it
+    uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+    unsigned long startTime;
+    unsigned long endTime;
+    receiveFrame(frame, &startTime, &endTime, NULL);
+    return;
+  }
+
+  KnxDeferredFrame* deferred = &_deferred_frames[_deferred_frame_count];
+  deferred->interested = false;
+  if (receiveFrame(deferred->frame, &deferred->start, &deferred->end, passive ? NULL : &deferred->interested)) {
+    _deferred_frame_count++;
+  }
+}
+
+bool KnxTpUart::readKNXTelegram() {
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  unsigned long startTime;
+  unsigned long endTime;
+
+  // Acknowledged as soon as the header is in, see acknowledgeFrame()
+  bool interested = false;
+  if (!receiveFrame(frame, &startTime, &endTime, &interested)) {
+    return false;
   }
+  return processTelegram(frame, startTime, endTime, interested);
+}
 
-  // Checksum
-  _tg->setBufferByte(bufpos, serialRead());
+bool KnxTpUart::processTelegram(const uint8_t* frame, unsigned long startTime, unsigned long endTime, bool interested) {
+  KNX_TRACE_SCOPE(KNX_TRACE_READ_TELEGRAM);
+
+  KnxTelegramView view(frame);
+  for (int i = 0; i < view.getTotalLength(); i++) {
+    _tg.setBufferByte(i, frame[i]);
+  }
+  _tg.setTimestamps(startTime, endTime);
+#if KNX_DIAGNOSTICS >= 2
+  if (_latency_stats != NULL) {
+    _latency_stats->rxFrame.record(endTime - startTime);
+  }
+#endif
 
 #if defined(TPUART_DEBUG)
   // Print the received telegram
-  _tg->print(&TPUART_DEBUG_PORT);
+  _tg.print(&TPUART_DEBUG_PORT);
 #endif
 
-  // Verify if we are interested in this message - GroupAddress
-  bool interested = _tg->isTargetGroup() && isListeningToGroupAddress(_tg->getTargetMainGroup(), _tg->getTargetMiddleGroup(), _tg->getTargetSubGroup());
-
-  // Physical address
-  interested = interested || ((!_tg->isTargetGroup()) && _tg->getTargetArea() == _source_area && _tg->getTargetLine() == _source_line && _tg->getTargetMember() == _source_member);
+#if KNX_FEATURE_COUPLER
+  if (_coupler != NULL) {
+    _coupler->received(_coupler_port, frame);
+  }
+#endif
 
-  // Broadcast (Programming Mode)
-  interested = interested || (_listen_to_broadcasts && _tg->isTargetGroup() && _tg->getTargetMainGroup() == 0 && _tg->getTargetMiddleGroup() == 0 && _tg->getTargetSubGroup() == 0);
+  bool acknowledged = interested;
 
-  if (interested) {
-    sendAck();
+#if KNX_FEATURE_SECURE
+  // Forwarded and recorded as received, the application sees it decrypted
+  if (interested && _secure != NULL) {
+    uint8_t plain[MAX_KNX_TELEGRAM_SIZE];
+    for (int i = 0; i < view.getTotalLength(); i++) {
+      plain[i] = frame[i];
+    }
+    KnxSecureResult result = _secure->unsecure(plain);
+    if (result == KNX_SECURE_OK) {
+      KnxTelegramView plainView(plain);
+      for (int i = 0; i < plainView.getTotalLength(); i++) {
+        _tg.setBufferByte(i, plain[i]);
+      }
+    }
+    else if (result != KNX_SECURE_PLAIN) {
+#if defined(TPUART_DEBUG)
+      TPUART_DEBUG_PORT.print("Secure telegram rejected: ");
+      TPUART_DEBUG_PORT.println((int) result);
+#endif
+      interested = false;
+    }
   }
-  else {
-    sendNotAddressed();
+#endif
+
+#if KNX_FEATURE_VIRTUAL_DEVICES
+  if (interested && _virtual_devices != NULL) {
+    // Acknowledged for a virtual device, maybe for us as well
+    uint16_t target = view.getTargetAddress();
+    if (_tg.isTargetGroup()) {
+      interested = isListeningToGroupAddress(target) || (_listen_to_broadcasts && target == 0);
+      _virtual_devices->received(&_tg);
+    }
+    else {
+      interested = target == getIndividualAddress();
+      if (!interested) {
+        _virtual_devices->received(&_tg);
+      }
+    }
   }
+#endif
 
-  if (_tg->getCommunicationType() == KNX_COMM_UCD) {
+#if KNX_FEATURE_DEVICE_SERVICES
+  if (_transport != NULL && interested && !_tg.isTargetGroup()) {
+    // Answered right away, the peer only waits for its T_ACK so long
+    interested = _transport->received(&_tg);
+  }
+  else
+#endif
+  if (_tg.getCommunicationType() == KNX_COMM_UCD) {
 #if defined(TPUART_DEBUG)
     TPUART_DEBUG_PORT.println("UCD Telegram received");
 #endif
   }
-  else if (_tg->getCommunicationType() == KNX_COMM_NCD) {
+  else if (_tg.getCommunicationType() == KNX_COMM_NCD) {
 #if defined(TPUART_DEBUG)
     TPUART_DEBUG_PORT.print("NCD Telegram ");
-    TPUART_DEBUG_PORT.print(_tg->getSequenceNumber());
+    TPUART_DEBUG_PORT.print(_tg.getSequenceNumber());
     TPUART_DEBUG_PORT.println(" received");
 #endif
     if (interested) {
-      sendNCDPosConfirm(_tg->getSequenceNumber(), _tg->getSourceArea(), _tg->getSourceLine(), _tg->getSourceMember()); // Thanks to Katja Blankenheim for the help
+      sendNCDPosConfirm(_tg.getSequenceNumber(), _tg.getSourceArea(), _tg.getSourceLine(), _tg.getSourceMember()); // Thanks to Katja Blankenheim for the help
     }
   }
 
+#if KNX_FEATURE_ASYNC_READ
+  if (_tg.isTargetGroup() && _tg.getCommand() == KNX_COMMAND_ANSWER) {
+    completePendingReads();
+  }
+#endif
+
+#if KNX_FEATURE_DEVICE_SERVICES
+  if (interested && _device_memory != NULL && handleDeviceService()) {
+    interested = false;
+  }
+#endif
+
+  recordFrame(acknowledged ? KNX_CAPTURE_ACKNOWLEDGED : 0, frame, view.getTotalLength(), startTime);
+
   // Returns if we are interested in this diagram
   return interested;
 }
 
+bool KnxTpUart::receiveFrame(uint8_t* frame, unsigned long* startTime, unsigned long* endTime, bool* interested) {
+#if KNX_FEATURE_RX_RING
+  if (_rx_ring != NULL) {
+    // Exact arrival times, stamped by the interrupt
+    *startTime = _rx_ring->peekTimestamp();
+    if (!readKNXTelegramFromRing(frame, interested)) {
+      return false;
+    }
+    *endTime = _rx_ring->getLastTimestamp();
+    return true;
+  }
+#endif
+
+  *startTime = micros();
+
+  // Receive header
+  for (int i = 0; i < KNX_TELEGRAM_HEADER_SIZE; i++) {
+    frame[i] = serialRead();
+  }
+  if (interested != NULL) {
+    *interested = acknowledgeFrame(frame);
+  }
+
+  // Payload and checksum
+  int length = KnxTelegramView(frame).getTotalLength();
+#if defined(TPUART_DEBUG)
+  TPUART_DEBUG_PORT.print("Payload Length: ");
+  TPUART_DEBUG_PORT.println(KnxTelegramView(frame).getPayloadLength());
+#endif
+  for (int i = KNX_TELEGRAM_HEADER_SIZE; i < length; i++) {
+    frame[i] = serialRead();
+  }
+  *endTime = micros();
+  return true;
+}
+
+void KnxTpUart::monitorBusByte(int incomingByte) {
+  if (!isKNXControlByte(incomingByte)) {
+    // Ack character of the receivers, or noise
+#if KNX_FEATURE_RX_RING
+    unsigned long timestamp = _rx_ring != NULL ? _rx_ring->peekTimestamp() : micros();
+#else
+    unsigned long timestamp = micros();
+#endif
+    uint8_t data = serialRead();
+    recordFrame(KNX_CAPTURE_ACK_CHAR, &data, 1, timestamp);
+    return;
+  }
+
+  // Never acknowledged, the frame is only recorded
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+  unsigned long startTime;
+  unsigned long endTime;
+  if (receiveFrame(frame, &startTime, &endTime, NULL)) {
+    monitorFrame(frame, startTime, endTime);
+  }
+}
+
+void KnxTpUart::monitorFrame(const uint8_t* frame, unsigned long startTime, unsigned long endTime) {
+  KnxTelegramView view(frame);
+  for (int i = 0; i < view.getTotalLength(); i++) {
+    _tg.setBufferByte(i, frame[i]);
+  }
+  _tg.setTimestamps(startTime, endTime);
+#if KNX_DIAGNOSTICS >= 2
+  if (_latency_stats != NULL) {
+    _latency_stats->rxFrame.record(endTime - startTime);
+  }
+#endif
+  recordFrame(0, frame, view.getTotalLength(), startTime);
+}
+
+void KnxTpUart::recordFrame(uint8_t flags, const uint8_t* data, int length, unsigned long timestamp) {
+#if KNX_DIAGNOSTICS >= 1
+  if (_monitor_ring != NULL && !(flags & KNX_CAPTURE_TX)) {
+    _monitor_ring->push((flags & KNX_CAPTURE_ACK_CHAR) ? KNX_MONITOR_ACK : KNX_MONITOR_FRAME, data, length, timestamp);
+  }
+  if (_capture != NULL) {
+    _capture->write(flags, data, length, timestamp);
+  }
+  if (_traffic != NULL && !(flags & KNX_CAPTURE_ACK_CHAR)) {
+    _traffic->record(data, length);
+  }
+#endif
+}
+
 KnxTelegram* KnxTpUart::getReceivedTelegram() {
-  return _tg;
+  return &_tg;
 }
 
 // Command Write
 
 bool KnxTpUart::groupWriteBool(String Address, bool value) {
+  KnxTelegram tg;
   int valueAsInt = 0;
   if (value) {
     valueAsInt = 0b00000001;
   }
 
-  createKNXMessageFrame(2, KNX_COMMAND_WRITE, Address, valueAsInt);
-  return sendMessage();
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, valueAsInt);
+  return sendTelegram(&tg);
 }
 
 bool KnxTpUart::groupWrite4BitInt(String Address, int value) {
+  KnxTelegram tg;
   int out_value = 0;
   if (value) {
     out_value = value & 0b00001111;
   }
 
-  createKNXMessageFrame(2, KNX_COMMAND_WRITE, Address, out_value);
-  return sendMessage();
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, out_value);
+  return sendTelegram(&tg);
 }
 
 bool KnxTpUart::groupWrite4BitDim(String Address, bool direction, byte steps) {
+  KnxTelegram tg;
   int value = 0;
   if (direction || steps) {
     value = (direction << 3) + (steps & 0b00000111);
   }
 
-  createKNXMessageFrame(2, KNX_COMMAND_WRITE, Address, value);
-  return sendMessage();
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, value);
+  return sendTelegram(&tg);
 }
 
 bool KnxTpUart::groupWrite1ByteInt(String Address, int value) {
-  createKNXMessageFrame(2, KNX_COMMAND_WRITE, Address, 0);
-  _tg->set1ByteIntValue(value);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, 0);
+  tg.set1ByteIntValue(value);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
 
 bool KnxTpUart::groupWrite2ByteInt(String Address, int value) {
-  createKNXMessageFrame(2, KNX_COMMAND_WRITE, Address, 0);
-  _tg->set2ByteIntValue(value);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, 0);
+  tg.set2ByteIntValue(value);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
 
 bool KnxTpUart::groupWrite2ByteFloat(String Address, float value) {
-  createKNXMessageFrame(2, KNX_COMMAND_WRITE, Address, 0);
-  _tg->set2ByteFloatValue(value);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, 0);
+  tg.set2ByteFloatValue(value);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
 
+#if KNX_FEATURE_DPT_EXTENDED
 bool KnxTpUart::groupWrite3ByteTime(String Address, int weekday, int hour, int minute, int second) {
-  createKNXMessageFrame(2, KNX_COMMAND_WRITE, Address, 0);
-  _tg->set3ByteTime(weekday, hour, minute, second);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, 0);
+  tg.set3ByteTime(weekday, hour, minute, second);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
 
 bool KnxTpUart::groupWrite3ByteDate(String Address, int day, int month, int year) {
-  createKNXMessageFrame(2, KNX_COMMAND_WRITE, Address, 0);
-  _tg->set3ByteDate(day, month, year);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, 0);
+  tg.set3ByteDate(day, month, year);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
+#endif
 
 bool KnxTpUart::groupWrite4ByteFloat(String Address, float value) {
-  createKNXMessageFrame(2, KNX_COMMAND_WRITE, Address, 0);
-  _tg->set4ByteFloatValue(value);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, 0);
+  tg.set4ByteFloatValue(value);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
 
+#if KNX_FEATURE_DPT_EXTENDED
 bool KnxTpUart::groupWrite14ByteText(String Address, String value) {
-  createKNXMessageFrame(2, KNX_COMMAND_WRITE, Address, 0);
-  _tg->set14ByteValue(value);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, 0);
+  tg.set14ByteValue(value);
+  tg.createChecksum();
+  return sendTelegram(&tg);
+}
+#endif
+
+bool KnxTpUart::groupWriteScene(String Address, int scene, bool learn) {
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, 0);
+  tg.set1ByteSceneValue(scene, learn);
+  tg.createChecksum();
+  return sendTelegram(&tg);
+}
+
+#if KNX_FEATURE_DPT_EXTENDED
+bool KnxTpUart::groupWrite3ByteColor(String Address, int red, int green, int blue) {
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, 0);
+  tg.set3ByteColorValue(red, green, blue);
+  tg.createChecksum();
+  return sendTelegram(&tg);
+}
+
+bool KnxTpUart::groupWrite4ByteUInt(String Address, uint32_t value) {
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, 0);
+  tg.set4ByteUIntValue(value);
+  tg.createChecksum();
+  return sendTelegram(&tg);
+}
+
+bool KnxTpUart::groupWrite4ByteInt(String Address, int32_t value) {
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, 0);
+  tg.set4ByteIntValue(value);
+  tg.createChecksum();
+  return sendTelegram(&tg);
+}
+
+bool KnxTpUart::groupWrite6ByteRGBW(String Address, int red, int green, int blue, int white) {
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, 0);
+  tg.set6ByteRGBWValue(red, green, blue, white);
+  tg.createChecksum();
+  return sendTelegram(&tg);
+}
+
+bool KnxTpUart::groupWrite6ByteXYY(String Address, float x, float y, int brightness) {
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, 0);
+  tg.set6ByteXYYValue(x, y, brightness);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
 
+bool KnxTpUart::groupWrite8ByteDateTime(String Address, int year, int month, int day, int weekday, int hour, int minute, int second) {
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_WRITE, Address, 0);
+  tg.set8ByteDateTime(year, month, day, weekday, hour, minute, second);
+  tg.createChecksum();
+  return sendTelegram(&tg);
+}
+#endif
+
 // Command Answer
 
 bool KnxTpUart::groupAnswerBool(String Address, bool value) {
+  KnxTelegram tg;
   int valueAsInt = 0;
   if (value) {
     valueAsInt = 0b00000001;
   }
 
-  createKNXMessageFrame(2, KNX_COMMAND_ANSWER, Address, valueAsInt);
-  return sendMessage();
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, valueAsInt);
+  return sendTelegram(&tg);
 }
 
 /*
   bool KnxTpUart::groupAnswerBitInt(String Address, int value) {
+  KnxTelegram tg;
   int out_value = 0;
   if (value) {
     out_value = value & B00001111;
   }
 
-  createKNXMessageFrame(2, KNX_COMMAND_ANSWER, Address, out_value);
-  return sendMessage();
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, out_value);
+  return sendTelegram(&tg);
   }
+*/
 
-  bool KnxTpUart::groupAnswer4BitDim(String Address, bool direction, byte steps) {
+bool KnxTpUart::groupAnswer4BitDim(String Address, bool direction, byte steps) {
+  KnxTelegram tg;
   int value = 0;
   if (direction || steps) {
-    value = (direction << 3) + (steps & B00000111);
+    value = (direction << 3) + (steps & 0b00000111);
   }
 
-  createKNXMessageFrame(2, KNX_COMMAND_ANSWER, Address, value);
-  return sendMessage();
-  }
-*/
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, value);
+  return sendTelegram(&tg);
+}
 
 bool KnxTpUart::groupAnswer1ByteInt(String Address, int value) {
-  createKNXMessageFrame(2, KNX_COMMAND_ANSWER, Address, 0);
-  _tg->set1ByteIntValue(value);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, 0);
+  tg.set1ByteIntValue(value);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
 
 bool KnxTpUart::groupAnswer2ByteInt(String Address, int value) {
-  createKNXMessageFrame(2, KNX_COMMAND_ANSWER, Address, 0);
-  _tg->set2ByteIntValue(value);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, 0);
+  tg.set2ByteIntValue(value);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
 
 bool KnxTpUart::groupAnswer2ByteFloat(String Address, float value) {
-  createKNXMessageFrame(2, KNX_COMMAND_ANSWER, Address, 0);
-  _tg->set2ByteFloatValue(value);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, 0);
+  tg.set2ByteFloatValue(value);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
 
+#if KNX_FEATURE_DPT_EXTENDED
 bool KnxTpUart::groupAnswer3ByteTime(String Address, int weekday, int hour, int minute, int second) {
-  createKNXMessageFrame(2, KNX_COMMAND_ANSWER, Address, 0);
-  _tg->set3ByteTime(weekday, hour, minute, second);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, 0);
+  tg.set3ByteTime(weekday, hour, minute, second);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
 
 bool KnxTpUart::groupAnswer3ByteDate(String Address, int day, int month, int year) {
-  createKNXMessageFrame(2, KNX_COMMAND_ANSWER, Address, 0);
-  _tg->set3ByteDate(day, month, year);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, 0);
+  tg.set3ByteDate(day, month, year);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
+#endif
 bool KnxTpUart::groupAnswer4ByteFloat(String Address, float value) {
-  createKNXMessageFrame(2, KNX_COMMAND_ANSWER, Address, 0);
-  _tg->set4ByteFloatValue(value);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, 0);
+  tg.set4ByteFloatValue(value);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
 
+#if KNX_FEATURE_DPT_EXTENDED
 bool KnxTpUart::groupAnswer14ByteText(String Address, String value) {
-  createKNXMessageFrame(2, KNX_COMMAND_ANSWER, Address, 0);
-  _tg->set14ByteValue(value);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, 0);
+  tg.set14ByteValue(value);
+  tg.createChecksum();
+  return sendTelegram(&tg);
+}
+#endif
+
+bool KnxTpUart::groupAnswerScene(String Address, int scene, bool learn) {
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, 0);
+  tg.set1ByteSceneValue(scene, learn);
+  tg.createChecksum();
+  return sendTelegram(&tg);
+}
+
+#if KNX_FEATURE_DPT_EXTENDED
+bool KnxTpUart::groupAnswer3ByteColor(String Address, int red, int green, int blue) {
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, 0);
+  tg.set3ByteColorValue(red, green, blue);
+  tg.createChecksum();
+  return sendTelegram(&tg);
+}
+
+bool KnxTpUart::groupAnswer4ByteUInt(String Address, uint32_t value) {
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, 0);
+  tg.set4ByteUIntValue(value);
+  tg.createChecksum();
+  return sendTelegram(&tg);
+}
+
+bool KnxTpUart::groupAnswer4ByteInt(String Address, int32_t value) {
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, 0);
+  tg.set4ByteIntValue(value);
+  tg.createChecksum();
+  return sendTelegram(&tg);
+}
+
+bool KnxTpUart::groupAnswer6ByteRGBW(String Address, int red, int green, int blue, int white) {
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, 0);
+  tg.set6ByteRGBWValue(red, green, blue, white);
+  tg.createChecksum();
+  return sendTelegram(&tg);
+}
+
+bool KnxTpUart::groupAnswer6ByteXYY(String Address, float x, float y, int brightness) {
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, 0);
+  tg.set6ByteXYYValue(x, y, brightness);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
 
+bool KnxTpUart::groupAnswer8ByteDateTime(String Address, int year, int month, int day, int weekday, int hour, int minute, int second) {
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_ANSWER, Address, 0);
+  tg.set8ByteDateTime(year, month, day, weekday, hour, minute, second);
+  tg.createChecksum();
+  return sendTelegram(&tg);
+}
+#endif
+
 // Command Read
 
 bool KnxTpUart::groupRead(String Address) {
-  createKNXMessageFrame(2, KNX_COMMAND_READ, Address, 0);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_READ, Address, 0);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
 
+#if KNX_FEATURE_ASYNC_READ
+KnxReadHandle KnxTpUart::groupReadAsync(String Address, unsigned long timeout) {
+  int index = -1;
+  for (int i = 0; i < MAX_PENDING_GROUP_READS; i++) {
+    if (_pending_reads[i].state == KNX_READ_FREE) {
+      index = i;
+      break;
+    }
+  }
+  if (index < 0) {
+#if defined(TPUART_DEBUG)
+    TPUART_DEBUG_PORT.println("Already MAX_PENDING_GROUP_READS pending, cannot read another");
+#endif
+    return -1;
+  }
+
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_READ, Address, 0);
+  tg.createChecksum();
+
+  // Registered before sending, the answer may arrive while we wait for the
+  // confirmation. The timeout starts in sendFrame(), after the transmit
+  // queue, see armPendingReads().
+  KnxPendingRead* read = &_pending_reads[index];
+  read->address = groupAddressFromString(Address);
+  read->sent = false;
+  read->start = millis();
+  read->timeout = timeout;
+  read->generation++;
+  read->state = KNX_READ_PENDING;
+
+  if (!sendTelegram(&tg)) {
+    read->state = KNX_READ_FREE;
+    return -1;
+  }
+
+  return (read->generation << 4) | index;
+}
+
+KnxPendingRead* KnxTpUart::pendingRead(KnxReadHandle handle) {
+  if (handle < 0) {
+    return NULL;
+  }
+
+  int index = handle & 0x0F;
+  if (index >= MAX_PENDING_GROUP_READS) {
+    return NULL;
+  }
+
+  KnxPendingRead* read = &_pending_reads[index];
+  if (read->state == KNX_READ_FREE || read->generation != ((handle >> 4) & 0xFF)) {
+    return NULL;
+  }
+  return read;
+}
+
+KnxReadState KnxTpUart::getReadState(KnxReadHandle handle) {
+  KnxPendingRead* read = pendingRead(handle);
+  if (read == NULL) {
+    return KNX_READ_FREE;
+  }
+
+  if (read->state == KNX_READ_PENDING && read->sent && (millis() - read->start) > read->timeout) {
+    read->state = KNX_READ_TIMEOUT;
+  }
+  return (KnxReadState) read->state;
+}
+
+bool KnxTpUart::getReadAnswer(KnxReadHandle handle, KnxTelegram* tg) {
+  if (getReadState(handle) != KNX_READ_DONE) {
+    return false;
+  }
+
+  KnxPendingRead* read = pendingRead(handle);
+  for (int i = 0; i < MAX_KNX_TELEGRAM_SIZE; i++) {
+    tg->setBufferByte(i, read->answer[i]);
+  }
+  return true;
+}
+
+void KnxTpUart::releaseRead(KnxReadHandle handle) {
+  KnxPendingRead* read = pendingRead(handle);
+  if (read != NULL) {
+    read->state = KNX_READ_FREE;
+  }
+}
+
+void KnxTpUart::armPendingReads(const uint8_t* frame) {
+  // By address only, a secured read does not show its command
+  KnxTelegramView view(frame);
+  if (!view.isTargetGroup()) {
+    return;
+  }
+  for (int i = 0; i < MAX_PENDING_GROUP_READS; i++) {
+    KnxPendingRead* read = &_pending_reads[i];
+    if (read->state == KNX_READ_PENDING && !read->sent && read->address == view.getTargetAddress()) {
+      read->sent = true;
+      read->start = millis();
+    }
+  }
+}
+
+void KnxTpUart::completePendingReads() {
+  uint16_t address = _tg.getTargetGroupAddress();
+  for (int i = 0; i < MAX_PENDING_GROUP_READS; i++) {
+    KnxPendingRead* read = &_pending_reads[i];
+    if (read->state != KNX_READ_PENDING || read->address != address) {
+      continue;
+    }
+    // A late answer still counts until somebody looked at the timeout
+    for (int j = 0; j < MAX_KNX_TELEGRAM_SIZE; j++) {
+      read->answer[j] = _tg.getBufferByte(j);
+    }
+    read->state = KNX_READ_DONE;
+  }
+}
+#endif
+
 bool KnxTpUart::individualAnswerAddress() {
-  createKNXMessageFrame(2, KNX_COMMAND_INDIVIDUAL_ADDR_RESPONSE, "0/0/0", 0);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrame(&tg, 2, KNX_COMMAND_INDIVIDUAL_ADDR_RESPONSE, "0/0/0", 0);
+  tg.createChecksum();
+  return sendTelegram(&tg);
 }
 
 bool KnxTpUart::individualAnswerMaskVersion(int area, int line, int member) {
-  createKNXMessageFrameIndividual(4, KNX_COMMAND_MASK_VERSION_RESPONSE, String(area) + "/" + String(line) + "/" + String(member), 0);
-  _tg->setCommunicationType(KNX_COMM_NDP);
-  _tg->setBufferByte(8, 0x07); // Mask version part 1 for BIM M 112
-  _tg->setBufferByte(9, 0x01); // Mask version part 2 for BIM M 112
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrameIndividual(&tg, 4, KNX_COMMAND_MASK_VERSION_RESPONSE, String(area) + "/" + String(line) + "/" + String(member), 0);
+  tg.setCommunicationType(KNX_COMM_NDP);
+  tg.setBufferByte(8, 0x07); // Mask version part 1 for BIM M 112
+  tg.setBufferByte(9, 0x01); // Mask version part 2 for BIM M 112
+  tg.createChecksum();
+#if KNX_FEATURE_DEVICE_SERVICES
+  if (_transport != NULL && _transport->isConnectedTo(area, line, member)) {
+    return _transport->sendData(&tg);
+  }
+#endif
+  return sendTelegram(&tg);
 }
 
 bool KnxTpUart::individualAnswerAuth(int accessLevel, int sequenceNo, int area, int line, int member) {
-  createKNXMessageFrameIndividual(3, KNX_COMMAND_ESCAPE, String(area) + "/" + String(line) + "/" + String(member), KNX_EXT_COMMAND_AUTH_RESPONSE);
-  _tg->setCommunicationType(KNX_COMM_NDP);
-  _tg->setSequenceNumber(sequenceNo);
-  _tg->setBufferByte(8, accessLevel);
-  _tg->createChecksum();
-  return sendMessage();
+  KnxTelegram tg;
+  createKNXMessageFrameIndividual(&tg, 3, KNX_COMMAND_ESCAPE, String(area) + "/" + String(line) + "/" + String(member), KNX_EXT_COMMAND_AUTH_RESPONSE);
+  tg.setCommunicationType(KNX_COMM_NDP);
+  tg.setSequenceNumber(sequenceNo);
+  tg.setBufferByte(8, accessLevel);
+  tg.createChecksum();
+#if KNX_FEATURE_DEVICE_SERVICES
+  if (_transport != NULL && _transport->isConnectedTo(area, line, member)) {
+    return _transport->sendData(&tg);
+  }
+#endif
+  return sendTelegram(&tg);
 }
 
-void KnxTpUart::createKNXMessageFrame(int payloadlength, KnxCommandType command, String address, int firstDataByte) {
+void KnxTpUart::createKNXMessageFrame(KnxTelegram* tg, int payloadlength, KnxCommandType command, String address, int firstDataByte) {
   int mainGroup = address.substring(0, address.indexOf('/')).toInt();
   int middleGroup = address.substring(address.indexOf('/') + 1, address.length()).substring(0, address.substring(address.indexOf('/') + 1, address.length()).indexOf('/')).toInt();
   int subGroup = address.substring(address.lastIndexOf('/') + 1, address.length()).toInt();
-  _tg->clear();
-  _tg->setSourceAddress(_source_area, _source_line, _source_member);
-  _tg->setTargetGroupAddress(mainGroup, middleGroup, subGroup);
-  _tg->setFirstDataByte(firstDataByte);
-  _tg->setCommand(command);
-  _tg->setPayloadLength(payloadlength);
-  _tg->createChecksum();
+  tg->clear();
+  tg->setSourceAddress(_source_area, _source_line, _source_member);
+  tg->setTargetGroupAddress(mainGroup, middleGroup, subGroup);
+  tg->setFirstDataByte(firstDataByte);
+  tg->setCommand(command);
+  tg->setPayloadLength(payloadlength);
+  tg->createChecksum();
 }
 
-void KnxTpUart::createKNXMessageFrameIndividual(int payloadlength, KnxCommandType command, String address, int firstDataByte) {
+void KnxTpUart::createKNXMessageFrameIndividual(KnxTelegram* tg, int payloadlength, KnxCommandType command, String address, int firstDataByte) {
   int area = address.substring(0, address.indexOf('/')).toInt();
   int line = address.substring(address.indexOf('/') + 1, address.length()).substring(0, address.substring(address.indexOf('/') + 1, address.length()).indexOf('/')).toInt();
   int member = address.substring(address.lastIndexOf('/') + 1, address.length()).toInt();
-  _tg->clear();
-  _tg->setSourceAddress(_source_area, _source_line, _source_member);
-  _tg->setTargetIndividualAddress(area, line, member);
-  _tg->setFirstDataByte(firstDataByte);
-  _tg->setCommand(command);
-  _tg->setPayloadLength(payloadlength);
-  _tg->createChecksum();
+  tg->clear();
+  tg->setSourceAddress(_source_area, _source_line, _source_member);
+  tg->setTargetIndividualAddress(area, line, member);
+  tg->setFirstDataByte(firstDataByte);
+  tg->setCommand(command);
+  tg->setPayloadLength(payloadlength);
+  tg->createChecksum();
 }
 
 bool KnxTpUart::sendNCDPosConfirm(int sequenceNo, int area, int line, int member) {
-  _tg_ptp->clear();
-  _tg_ptp->setSourceAddress(_source_area, _source_line, _source_member);
-  _tg_ptp->setTargetIndividualAddress(area, line, member);
-  _tg_ptp->setSequenceNumber(sequenceNo);
-  _tg_ptp->setCommunicationType(KNX_COMM_NCD);
-  _tg_ptp->setControlData(KNX_CONTROLDATA_POS_CONFIRM);
-  _tg_ptp->setPayloadLength(1);
-  _tg_ptp->createChecksum();
+  KnxTelegram ptp;
+  ptp.setSourceAddress(_source_area, _source_line, _source_member);
+  ptp.setTargetIndividualAddress(area, line, member);
+  ptp.setSequenceNumber(sequenceNo);
+  ptp.setCommunicationType(KNX_COMM_NCD);
+  ptp.setControlData(KNX_CONTROLDATA_POS_CONFIRM);
+  ptp.setPayloadLength(1);
+  ptp.createChecksum();
 
 
-  int messageSize = _tg_ptp->getTotalLength();
+  int messageSize = ptp.getTotalLength();
 
   uint8_t sendbuf[2];
   for (int i = 0; i < messageSize; i++) {
@@ -442,7 +1191,7 @@ bool KnxTpUart::sendNCDPosConfirm(int sequenceNo, int area, int line, int member
     }
 
     sendbuf[0] |= i;
-    sendbuf[1] = _tg_ptp->getBufferByte(i);
+    sendbuf[1] = ptp.getBufferByte(i);
 
     _serialport->write(sendbuf, 2);
   }
@@ -452,9 +1201,11 @@ bool KnxTpUart::sendNCDPosConfirm(int sequenceNo, int area, int line, int member
   while (true) {
     confirmation = serialRead();
     if (confirmation == 0b10001011) {
+      txConfirmed();
       return true; // Sent successfully
     }
     else if (confirmation == 0b00001011) {
+      txConfirmed();
       return false;
     }
     else if (confirmation == -1) {
@@ -466,8 +1217,107 @@ bool KnxTpUart::sendNCDPosConfirm(int sequenceNo, int area, int line, int member
   return false;
 }
 
-bool KnxTpUart::sendMessage() {
-  int messageSize = _tg->getTotalLength();
+void KnxTpUart::txConfirmed() {
+#if KNX_DIAGNOSTICS >= 2
+  _last_tx_timing.confirmed = micros();
+  if (_latency_stats != NULL) {
+    _latency_stats->txQueueWait.record(_last_tx_timing.start - _last_tx_timing.queued);
+    _latency_stats->txConfirm.record(_last_tx_timing.confirmed - _last_tx_timing.start);
+  }
+#endif
+}
+
+bool KnxTpUart::sendTemplate(KnxFrameTemplate* frameTemplate) {
+  return sendTelegram(frameTemplate->getFrame(), frameTemplate->getLength());
+}
+
+bool KnxTpUart::sendTelegram(KnxTelegram* tg) {
+  return sendTelegram(tg->getBuffer(), tg->getTotalLength());
+}
+
+bool KnxTpUart::sendTelegram(const uint8_t* frame, int messageSize) {
+  if (_mode == KNX_MODE_BUSMONITOR) {
+    // The TP-UART ignores data requests until it is reset
+    return false;
+  }
+#if KNX_FEATURE_SECURE
+  uint8_t secured[MAX_KNX_TELEGRAM_SIZE];
+  if (_secure != NULL) {
+    // Secured once, a queued frame keeps its sequence number
+    int length = _secure->secure(frame, secured);
+    if (length < 0) {
+#if defined(TPUART_DEBUG)
+      TPUART_DEBUG_PORT.println("Telegram too long for a secured standard frame");
+#endif
+      return false;
+    }
+    if (length > 0) {
+      frame = secured;
+      messageSize = length;
+    }
+  }
+#endif
+#if KNX_FEATURE_TX_QUEUE
+  if (_tx_queue != NULL) {
+    // The drainer sends it, see processTxQueue()
+    return _tx_queue->push(frame, messageSize);
+  }
+#endif
+  return sendMessage(frame, messageSize);
+}
+
+#if KNX_FEATURE_TX_QUEUE
+bool KnxTpUart::processTxQueue() {
+  if (_tx_queue == NULL) {
+    return false;
+  }
+
+  // Paced without blocking, the caller keeps receiving in between
+  if ((millis() - _last_tx_time) < _tx_interval) {
+    return false;
+  }
+
+  KnxTxSlot* slot = _tx_queue->front();
+  if (slot == NULL) {
+    return false;
+  }
+
+  bool success = sendFrame(slot->frame, slot->length, slot->queued);
+  _last_tx_time = millis();
+  _tx_queue->pop();
+  return success;
+}
+
+bool KnxTpUart::hasQueuedTelegrams() {
+  return _tx_queue != NULL && !_tx_queue->isEmpty();
+}
+
+void KnxTpUart::setTxInterval(unsigned long interval) {
+  _tx_interval = interval;
+}
+#endif
+
+void KnxTpUart::setTxConfirmHandler(KnxTxConfirmHandler handler, void* context) {
+  _tx_confirm_handler = handler;
+  _tx_confirm_context = context;
+}
+
+bool KnxTpUart::sendMessage(const uint8_t* frame, int messageSize) {
+  bool success = sendFrame(frame, messageSize, micros());
+  delay (SERIAL_WRITE_DELAY_MS);
+  return success;
+}
+
+bool KnxTpUart::sendFrame(const uint8_t* frame, int messageSize, unsigned long queued) {
+  KNX_TRACE_SCOPE(KNX_TRACE_SEND_FRAME);
+  unsigned long start = micros();
+#if KNX_DIAGNOSTICS >= 2
+  _last_tx_timing.queued = queued;
+  _last_tx_timing.start = start;
+#endif
+#if KNX_FEATURE_ASYNC_READ
+  armPendingReads(frame);
+#endif
 
   uint8_t sendbuf[2];
   for (int i = 0; i < messageSize; i++) {
@@ -479,53 +1329,283 @@ bool KnxTpUart::sendMessage() {
     }
 
     sendbuf[0] |= i;
-    sendbuf[1] = _tg->getBufferByte(i);
+    sendbuf[1] = frame[i];
 
     _serialport->write(sendbuf, 2);
   }
 
 
-  int confirmation;
-  while (true) {
-    confirmation = serialRead();
-    if (confirmation == 0b10001011) {
-      delay (SERIAL_WRITE_DELAY_MS);
-      return true; // Sent successfully
+  // -1 until the TP-UART answers, also after a read timeout
+  int confirmation = -1;
+  while (waitForByte()) {
+    // Frames from the bus may arrive before our confirmation (answers to
+    // earlier reads, for example). They are acknowledged now and handed
+    // to the next serialEvent().
+    if (isKNXControlByte(rxPeek())) {
+      deferTelegram();
+      continue;
     }
-    else if (confirmation == 0b00001011) {
-      delay (SERIAL_WRITE_DELAY_MS);
-      return false;
+    if (rxPeek() == TPUART_RESET_INDICATION_BYTE) {
+      // The chip reset and forgot the frame, left for serialEvent()
+      break;
     }
-    else if (confirmation == -1) {
-      // Read timeout
-      delay (SERIAL_WRITE_DELAY_MS);
-      return false;
+
+    int received = serialRead();
+    if (received == 0b10001011 || received == 0b00001011) {
+      confirmation = received;
+      txConfirmed();
+      break;
+    }
+  }
+  bool success = confirmation == 0b10001011;
+
+  recordFrame(success ? KNX_CAPTURE_TX : KNX_CAPTURE_TX | KNX_CAPTURE_NOT_CONFIRMED, frame, messageSize, start);
+  bool report = true;
+#if KNX_FEATURE_RESET_RECOVERY
+  if (_recovery != NULL) {
+    if (_recovering) {
+      // The first attempt was reported already
+      report = false;
+    }
+    else {
+      // A retry of the caller replaces the held copy, so the frame is not
+      // sent twice
+      _recovery->forget(frame, messageSize);
+      if (confirmation == -1) {
+        // No confirmation at all: kept in case a reset indication follows
+        _recovery->remember(frame, messageSize);
+      }
     }
   }
+#endif
+  if (report && _tx_confirm_handler != NULL) {
+    _tx_confirm_handler(frame, messageSize, success, _tx_confirm_context);
+  }
+  return success;
+}
 
-  return false;
+bool KnxTpUart::sendPriority(const uint8_t* frame, int messageSize) {
+  if (_mode == KNX_MODE_BUSMONITOR) {
+    return false;
+  }
+#if KNX_FEATURE_DEVICE_SERVICES
+  if (!_in_serial_event) {
+    return sendFrame(frame, messageSize, micros());
+  }
+
+  // Sent once the received frame is handled, ahead of the transmit queue.
+  // A second frame from the same telegram pushes the first one out.
+  flushPriority();
+  for (int i = 0; i < messageSize; i++) {
+    _priority_frame[i] = frame[i];
+  }
+  _priority_length = messageSize;
+  return true;
+#else
+  // Not attached with setTransport(), so never called from serialEvent()
+  return sendFrame(frame, messageSize, micros());
+#endif
+}
+
+#if KNX_FEATURE_DEVICE_SERVICES
+void KnxTpUart::flushPriority() {
+  if (_priority_length == 0) {
+    return;
+  }
+  int length = _priority_length;
+  _priority_length = 0;
+  sendFrame(_priority_frame, length, micros());
 }
+#endif
 
 void KnxTpUart::sendAck() {
+  KNX_TRACE_SCOPE(KNX_TRACE_SEND_ACK);
   byte sendByte = 0b00010001;
   _serialport->write(sendByte);
-  delay(SERIAL_WRITE_DELAY_MS);
+}
+
+void KnxTpUart::sendBusy() {
+  KNX_TRACE_SCOPE(KNX_TRACE_SEND_ACK);
+  byte sendByte = 0b00010011;
+  _serialport->write(sendByte);
 }
 
 void KnxTpUart::sendNotAddressed() {
+  KNX_TRACE_SCOPE(KNX_TRACE_SEND_ACK);
   byte sendByte = 0b00010000;
   _serialport->write(sendByte);
-  delay(SERIAL_WRITE_DELAY_MS);
+}
+
+bool KnxTpUart::acknowledgeFrame(const uint8_t* header) {
+  KNX_TRACE_SCOPE(KNX_TRACE_ADDRESS_FILTER);
+  // Verify if we are interested in this message, directly on the received bytes
+  KnxTelegramView view(header);
+#if KNX_FEATURE_COUPLER
+  // Frames leaving the line through the coupler are acknowledged for it
+  KnxCouplerAcceptance acceptance = _coupler != NULL ? _coupler->accepts(_coupler_port, header) : KNX_COUPLER_IGNORE;
+  bool routed = acceptance == KNX_COUPLER_ACCEPT;
+  bool busy = acceptance == KNX_COUPLER_BUSY;
+#else
+  bool routed = false;
+  bool busy = false;
+#endif
+  if (view.isTargetGroup()) {
+    uint16_t address = view.getTargetAddress();
+    bool interested = isListeningToGroupAddress(address);
+
+    // Broadcast (Programming Mode)
+    interested = interested || (_listen_to_broadcasts && address == 0);
+#if KNX_FEATURE_VIRTUAL_DEVICES
+    interested = interested || (_virtual_devices != NULL && _virtual_devices->getGroupOwners(address) != 0);
+#endif
+    if (busy) {
+      sendBusy();
+    }
+    else if (interested || routed) {
+      sendAck();
+    }
+    else {
+      sendNotAddressed();
+    }
+    return interested;
+  }
+
+  // Physical address
+  uint16_t target = view.getTargetAddress();
+  bool interested = target == getIndividualAddress();
+#if KNX_FEATURE_VIRTUAL_DEVICES
+  bool virtualDevice = !interested && _virtual_devices != NULL && _virtual_devices->getDevice(target) >= 0;
+#else
+  bool virtualDevice = false;
+#endif
+  if (_hardware_ack) {
+    // The TP-UART2 acknowledges its own address by itself, but knows
+    // nothing about virtual devices and routing
+    if (virtualDevice || (routed && !interested)) {
+      sendAck();
+    }
+    else if (busy && !interested) {
+      sendBusy();
+    }
+    return interested || virtualDevice;
+  }
+  interested = interested || virtualDevice;
+  if (busy && !interested) {
+    sendBusy();
+  }
+  else if (interested || routed) {
+    sendAck();
+  }
+  else {
+    sendNotAddressed();
+  }
+  return interested;
+}
+
+#if KNX_FEATURE_DEVICE_SERVICES
+bool KnxTpUart::handleDeviceService() {
+  KnxTelegram response;
+  KnxServiceResult result = _device_memory->handle(&_tg, &response);
+  if (result == KNX_SERVICE_RESPOND) {
+    if (_transport != NULL && _transport->isConnectedTo(_tg.getSourceArea(), _tg.getSourceLine(), _tg.getSourceMember())) {
+      _transport->sendData(&response);
+    }
+    else {
+      sendTelegram(&response);
+    }
+  }
+  return result != KNX_SERVICE_IGNORED;
+}
+#endif
+
+#if KNX_FEATURE_RX_RING
+bool KnxTpUart::readKNXTelegramFromRing(uint8_t* frame, bool* interested) {
+  // The control byte starts the frame, the gap in front of it does not matter
+  if (!waitForRxRing(1) || _rx_ring->read(frame, 1) != 1) {
+    return false;
+  }
+
+  int received = 1;
+  int length = KNX_TELEGRAM_HEADER_SIZE;
+  while (received < length) {
+    if (!waitForRxRing(1)) {
+#if defined(TPUART_DEBUG)
+      TPUART_DEBUG_PORT.println("Timeout while receiving message");
+#endif
+      return false;
+    }
+
+    int n = _rx_ring->read(frame + received, length - received, TPUART_RX_FRAME_GAP_US);
+    if (n == 0) {
+      // The next byte came too late, it starts something new
+#if defined(TPUART_DEBUG)
+      TPUART_DEBUG_PORT.println("Frame ended early");
+#endif
+      return false;
+    }
+    received += n;
+
+    if (received >= KNX_TELEGRAM_HEADER_SIZE && length == KNX_TELEGRAM_HEADER_SIZE) {
+      // Header complete, now we know the payload length
+      length = KNX_TELEGRAM_HEADER_SIZE + (frame[5] & 0b00001111) + 2;
+      if (interested != NULL) {
+        *interested = acknowledgeFrame(frame);
+      }
+    }
+  }
+
+  return true;
+}
+
+bool KnxTpUart::waitForRxRing(int count) {
+  unsigned long startTime = millis();
+  while (_rx_ring->available() < count) {
+    if ((millis() - startTime) > SERIAL_READ_TIMEOUT_MS) {
+      return false;
+    }
+    delay(1);
+  }
+  return true;
+}
+#endif
+
+int KnxTpUart::rxAvailable() {
+#if KNX_FEATURE_RX_RING
+  if (_rx_ring != NULL) {
+    return _rx_ring->available();
+  }
+#endif
+  return _serialport->available();
+}
+
+int KnxTpUart::rxPeek() {
+#if KNX_FEATURE_RX_RING
+  if (_rx_ring != NULL) {
+    return _rx_ring->peek();
+  }
+#endif
+  return _serialport->peek();
+}
+
+bool KnxTpUart::waitForByte() {
+  unsigned long startTime = millis();
+  while (!(rxAvailable() > 0)) {
+    if ((millis() - startTime) > SERIAL_READ_TIMEOUT_MS) {
+      return false;
+    }
+    delay(1);
+  }
+  return true;
 }
 
 int KnxTpUart::serialRead() {
   unsigned long startTime = millis();
 #if defined(TPUART_DEBUG)
   TPUART_DEBUG_PORT.print("Available: ");
-  TPUART_DEBUG_PORT.println(_serialport->available());
+  TPUART_DEBUG_PORT.println(rxAvailable());
 #endif
 
-  while (! (_serialport->available() > 0)) {
+  while (! (rxAvailable() > 0)) {
     if ((millis() - startTime) > SERIAL_READ_TIMEOUT_MS) {
       // Timeout
 #if defined(TPUART_DEBUG)
@@ -536,7 +1616,17 @@ int KnxTpUart::serialRead() {
     delay(1);
   }
 
-  int inByte = _serialport->read();
+  int inByte;
+#if KNX_FEATURE_RX_RING
+  if (_rx_ring != NULL) {
+    inByte = _rx_ring->read();
+  }
+  else {
+    inByte = _serialport->read();
+  }
+#else
+  inByte = _serialport->read();
+#endif
   checkErrors();
   printByte(inByte);
 
@@ -544,6 +1634,10 @@ int KnxTpUart::serialRead() {
 }
 
 void KnxTpUart::addListenGroupAddress(String address) {
+  addListenGroupAddress(groupAddressFromString(address));
+}
+
+void KnxTpUart::addListenGroupAddress(uint16_t groupAddress) {
   if (_listen_group_address_count >= MAX_LISTEN_GROUP_ADDRESSES) {
 #if defined(TPUART_DEBUG)
     TPUART_DEBUG_PORT.println("Already listening to MAX_LISTEN_GROUP_ADDRESSES, cannot listen to another");
@@ -551,22 +1645,143 @@ void KnxTpUart::addListenGroupAddress(String address) {
     return;
   }
 
-  _listen_group_addresses[_listen_group_address_count][0] = address.substring(0, address.indexOf('/')).toInt();
-  ;
-  _listen_group_addresses[_listen_group_address_count][1] = address.substring(address.indexOf('/') + 1, address.length()).substring(0, address.substring(address.indexOf('/') + 1, address.length()).indexOf('/')).toInt();
-  _listen_group_addresses[_listen_group_address_count][2] = address.substring(address.lastIndexOf('/') + 1, address.length()).toInt();
+  if (isListeningToGroupAddress(groupAddress)) {
+    return;
+  }
+
+  // Keep the table sorted for the binary search in the receive path
+  int i = _listen_group_address_count;
+  while (i > 0 && _listen_group_addresses[i - 1] > groupAddress) {
+    _listen_group_addresses[i] = _listen_group_addresses[i - 1];
+    i--;
+  }
+  _listen_group_addresses[i] = groupAddress;
 
   _listen_group_address_count++;
 }
 
 bool KnxTpUart::isListeningToGroupAddress(int main, int middle, int sub) {
-  for (int i = 0; i < _listen_group_address_count; i++) {
-    if ( (_listen_group_addresses[i][0] == main)
-         && (_listen_group_addresses[i][1] == middle)
-         && (_listen_group_addresses[i][2] == sub)) {
+  return isListeningToGroupAddress(((unsigned int) main << 11) | (middle << 8) | sub);
+}
+
+bool KnxTpUart::isListeningToGroupAddress(uint16_t address) {
+  int low = 0;
+  int high = _listen_group_address_count - 1;
+  while (low <= high) {
+    int mid = (low + high) / 2;
+    if (_listen_group_addresses[mid] == address) {
       return true;
     }
+    else if (_listen_group_addresses[mid] < address) {
+      low = mid + 1;
+    }
+    else {
+      high = mid - 1;
+    }
   }
 
   return false;
-}
\ No newline at end of file
+}
+
+uint16_t KnxTpUart::individualAddressFromString(String address) {
+  int area = address.substring(0, address.indexOf('.')).toInt();
+  int line = address.substring(address.indexOf('.') + 1, address.length()).substring(0, address.substring(address.indexOf('.') + 1, address.length()).indexOf('.')).toInt();
+  int member = address.substring(address.lastIndexOf('.') + 1, address.length()).toInt();
+  return ((unsigned int) area << 12) | (line << 8) | member;
+}
+
+int KnxTpUart::saveConfig(uint8_t* buffer, int size) {
+  int length = KNX_CONFIG_SIZE(_listen_group_address_count);
+  if (size < length) {
+    return 0;
+  }
+
+  uint16_t address = getIndividualAddress();
+  buffer[0] = 'K';
+  buffer[1] = 'C';
+  buffer[2] = KNX_CONFIG_VERSION;
+  buffer[3] = length & 0xFF;
+  buffer[4] = length >> 8;
+  buffer[5] = address & 0xFF;
+  buffer[6] = address >> 8;
+  buffer[7] = _listen_to_broadcasts ? KNX_CONFIG_BROADCASTS : 0;
+  buffer[8] = _tx_interval & 0xFF;
+  buffer[9] = (_tx_interval >> 8) & 0xFF;
+  buffer[10] = _listen_group_address_count;
+  for (int i = 0; i < _listen_group_address_count; i++) {
+    buffer[KNX_CONFIG_HEADER_SIZE + 2 * i] = _listen_group_addresses[i] & 0xFF;
+    buffer[KNX_CONFIG_HEADER_SIZE + 2 * i + 1] = _listen_group_addresses[i] >> 8;
+  }
+
+  uint16_t crc = 0xFFFF;
+  for (int i = 0; i < length - 2; i++) {
+    crc = knxConfigCrcUpdate(crc, buffer[i]);
+  }
+  buffer[length - 2] = crc & 0xFF;
+  buffer[length - 1] = crc >> 8;
+  return length;
+}
+
+bool KnxTpUart::loadConfig(const uint8_t* blob, int length) {
+  return loadConfig(blob, NULL, 0, length);
+}
+
+bool KnxTpUart::loadConfig(KnxConfigReadByte readByte, int address) {
+  return loadConfig(NULL, readByte, address, KNX_CONFIG_SIZE(MAX_LISTEN_GROUP_ADDRESSES));
+}
+
+bool KnxTpUart::loadConfig(const uint8_t* blob, KnxConfigReadByte readByte, int address, int maxLength) {
+  // One pass over the storage: the table is read into its final sorted
+  // form while the CRC runs, and only taken over if the CRC matches
+  uint8_t header[KNX_CONFIG_HEADER_SIZE];
+  uint16_t table[MAX_LISTEN_GROUP_ADDRESSES];
+  uint16_t crc = 0xFFFF;
+  int position = 0;
+
+  for (; position < KNX_CONFIG_HEADER_SIZE && position < maxLength; position++) {
+    header[position] = blob != NULL ? blob[position] : readByte(address + position);
+    crc = knxConfigCrcUpdate(crc, header[position]);
+  }
+  int count = header[10];
+  int length = header[3] | (header[4] << 8);
+  if (position < KNX_CONFIG_HEADER_SIZE || header[0] != 'K' || header[1] != 'C'
+      || header[2] != KNX_CONFIG_VERSION || count > MAX_LISTEN_GROUP_ADDRESSES
+      || length != KNX_CONFIG_SIZE(count) || length > maxLength) {
+    return false;
+  }
+
+  for (int i = 0; i < count; i++) {
+    uint8_t low = blob != NULL ? blob[position] : readByte(address + position);
+    uint8_t high = blob != NULL ? blob[position + 1] : readByte(address + position + 1);
+    crc = knxConfigCrcUpdate(knxConfigCrcUpdate(crc, low), high);
+    table[i] = low | (high << 8);
+    position += 2;
+    if (i > 0 && table[i] <= table[i - 1]) {
+      // Not sorted, the binary search would miss entries
+      return false;
+    }
+  }
+
+  uint8_t crcLow = blob != NULL ? blob[position] : readByte(address + position);
+  uint8_t crcHigh = blob != NULL ? blob[position + 1] : readByte(address + position + 1);
+  if ((crcLow | (crcHigh << 8)) != crc) {
+    return false;
+  }
+
+  uint16_t individualAddress = header[5] | (header[6] << 8);
+  _listen_to_broadcasts = header[7] & KNX_CONFIG_BROADCASTS;
+  _tx_interval = header[8] | (header[9] << 8);
+  for (int i = 0; i < count; i++) {
+    _listen_group_addresses[i] = table[i];
+  }
+  _listen_group_address_count = count;
+  setIndividualAddress(individualAddress >> 12, (individualAddress >> 8) & 0x0F, individualAddress & 0xFF);
+  return true;
+}
+
+uint16_t KnxTpUart::groupAddressFromString(String address) {
+  int mainGroup = address.substring(0, address.indexOf('/')).toInt();
+  int middleGroup = address.substring(address.indexOf('/') + 1, address.length()).substring(0, address.substring(address.indexOf('/') + 1, address.length()).indexOf('/')).toInt();
+  int subGroup = address.substring(address.lastIndexOf('/') + 1, address.length()).toInt();
+  return ((unsigned int) mainGroup << 11) | (middleGroup << 8) | subGroup;
+}
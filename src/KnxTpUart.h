@@ -5,7 +5,7 @@
 // Modified: Katja Blankenheim (Since 2014)
 // Modified: Mag Gyver (Since 2016)
 
-// Last modified: 06.06.2017
+// Last modified: 18.10.2026
 
 #ifndef KnxTpUart_h
 #define KnxTpUart_h
@@ -13,7 +13,25 @@
 #include "HardwareSerial.h"
 #include "Arduino.h"
 
+#include "KnxFeatures.h"
 #include "KnxTelegram.h"
+#include "KnxTelegramView.h"
+#include "KnxFrameTemplate.h"
+#include "KnxTxQueue.h"
+#include "KnxRxRing.h"
+#include "KnxHistogram.h"
+#include "KnxMonitorRing.h"
+#include "KnxTrafficStats.h"
+#include "KnxCapture.h"
+#include "KnxTransport.h"
+#include "KnxDeviceMemory.h"
+#include "KnxConfig.h"
+#include "KnxVirtualDevices.h"
+#include "KnxCoupler.h"
+#include "KnxCemi.h"
+#include "KnxSecure.h"
+#include "KnxResetRecovery.h"
+#include "KnxTrace.h"
 
 // Services from TPUART
 #define TPUART_RESET_INDICATION_BYTE 0b11
@@ -21,6 +39,20 @@
 // Services to TPUART
 #define TPUART_DATA_START_CONTINUE 0b10000000
 #define TPUART_DATA_END 0b01000000
+#define TPUART_ACTIVATE_BUSMON 0b101
+
+// Services to TP-UART2 / NCN5120 only
+#define TPUART2_PRODUCT_ID_REQUEST 0b00100000
+#define TPUART2_SET_ADDRESS 0b11110001
+#define TPUART2_CONFIGURE 0b00011000
+
+// Option bits sent with U_Configure, see the data sheet of the chip
+#ifndef TPUART2_CONFIGURE_FLAGS
+#define TPUART2_CONFIGURE_FLAGS 0
+#endif
+
+// Time to wait for the product id before assuming a first TP-UART
+#define TPUART2_DETECT_TIMEOUT_MS 50
 
 // Uncomment the following line to enable debugging
 //#define TPUART_DEBUG
@@ -31,35 +63,131 @@
 
 // Delay in ms between sending of packets to the bus
 // Change only if you know what you're doing
+#ifndef SERIAL_WRITE_DELAY_MS
 #define SERIAL_WRITE_DELAY_MS 100
+#endif
 
 // Timeout for reading a byte from TPUART
 // Change only if you know what you're doing
 #define SERIAL_READ_TIMEOUT_MS 10
 
-// Maximum number of group addresses that can be listened on
+// Maximum number of group addresses that can be listened on, at most 255
+// (see KnxConfig.h)
+#ifndef MAX_LISTEN_GROUP_ADDRESSES
 #define MAX_LISTEN_GROUP_ADDRESSES 24
+#endif
+
+#if MAX_LISTEN_GROUP_ADDRESSES > 255
+#error "MAX_LISTEN_GROUP_ADDRESSES must not exceed 255"
+#endif
+
+// Maximum number of groupReadAsync() requests waiting for their answer, at
+// most 16, a read handle keeps the slot in 4 bits
+#ifndef MAX_PENDING_GROUP_READS
+#define MAX_PENDING_GROUP_READS 4
+#endif
+
+#if MAX_PENDING_GROUP_READS > 16
+#error "MAX_PENDING_GROUP_READS must not exceed 16"
+#endif
+
+// Default time to wait for the answer to groupReadAsync()
+#define GROUP_READ_TIMEOUT_MS 2000
+
+// Frames from the bus that arrive while a send waits for its confirmation.
+// They are acknowledged at once and reported by the next serialEvent();
+// when all slots are taken the frame is not acknowledged and the sender
+// repeats it.
+#ifndef TPUART_DEFERRED_FRAMES
+#define TPUART_DEFERRED_FRAMES 2
+#endif
 
 enum KnxTpUartSerialEventType {
   TPUART_RESET_INDICATION,
   KNX_TELEGRAM,
   IRRELEVANT_KNX_TELEGRAM,
-  TPUART_UNKNOWN_EVENT
+  TPUART_UNKNOWN_EVENT,
+  KNX_MONITOR_RECORD      // Frame or ack character seen while monitoring
 };
 
-class KnxTpUart {
+enum KnxTpUartMode {
+  KNX_MODE_NORMAL,
+  KNX_MODE_BUSMONITOR,    // TP-UART busmonitor service, left by uartReset()
+  KNX_MODE_PASSIVE        // Normal mode, but no frame is acknowledged
+};
 
+enum KnxReadState {
+  KNX_READ_FREE,      // Invalid or released handle
+  KNX_READ_PENDING,
+  KNX_READ_DONE,      // Answer available with getReadAnswer()
+  KNX_READ_TIMEOUT
+};
+
+// Identifies one groupReadAsync() request, negative if none could be started
+typedef int KnxReadHandle;
+
+struct KnxPendingRead {
+  uint16_t address;
+  uint8_t state;
+  uint8_t generation;  // Makes handles of reused slots invalid
+  bool sent;           // The timeout runs from the send, not the queueing
+  unsigned long start;
+  unsigned long timeout;
+  uint8_t answer[MAX_KNX_TELEGRAM_SIZE];
+};
+
+struct KnxDeferredFrame {
+  unsigned long start;  // micros() of the first and the last byte
+  unsigned long end;
+  bool interested;
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+};
+
+// Called for every frame sent, after the TP-UART confirmed it or gave up
+typedef void (*KnxTxConfirmHandler)(const uint8_t* frame, int length, bool confirmed, void* context);
+
+class KnxTpUart {
+    friend class KnxTransport;
+    friend class KnxVirtualDevices;
+    friend class KnxCoupler;
 
   public:
     KnxTpUart(TPUART_SERIAL_CLASS*, String);
+    KnxTpUart(TPUART_SERIAL_CLASS*, uint16_t individualAddress);
     void uartReset();
     void uartStateRequest();
+    // Bus monitoring: every frame (and in busmonitor mode every ack
+    // character) is reported as KNX_MONITOR_RECORD and nothing is
+    // acknowledged. The TP-UART cannot send while in busmonitor mode.
+    void uartActivateBusmonitor();
+    void setPassiveListen(bool);
+    KnxTpUartMode getMode();
+
+    // TP-UART2 / NCN5120: the chip acknowledges frames to our individual
+    // address itself, even when the sketch is busy. Probes the chip and
+    // keeps the software acknowledge on older TP-UARTs. Call after
+    // uartReset(); the address is set again after every reset indication.
+    bool uartEnableHardwareAck();
+    bool hasHardwareAck();
+    int getProductId();  // -1 if the chip did not answer
+#if KNX_DIAGNOSTICS >= 1
+    void setMonitorRing(KnxMonitorRing*);
+    // Record received and transmitted frames in the capture format
+    void setCaptureWriter(KnxCaptureWriter*);
+    // Count frames, bytes and repeats per sender and group address
+    void setTrafficStats(KnxTrafficStats*);
+#endif
     KnxTpUartSerialEventType serialEvent();
+    // Frames received during a send wait for serialEvent(), call it while
+    // this is true even if no byte is available
+    bool hasDeferredFrames();
     KnxTelegram* getReceivedTelegram();
 
     void setIndividualAddress(int, int, int);
+    uint16_t getIndividualAddress();
 
     void sendAck();
+    void sendBusy();
     void sendNotAddressed();
 
     bool groupWriteBool(String, bool);
@@ -68,28 +196,61 @@ class KnxTpUart {
     bool groupWrite1ByteInt(String, int);
     bool groupWrite2ByteInt(String, int);
     bool groupWrite2ByteFloat(String, float);
+    bool groupWrite4ByteFloat(String, float);
+    bool groupWriteScene(String, int, bool learn = false);
+#if KNX_FEATURE_DPT_EXTENDED
     bool groupWrite3ByteTime(String, int, int, int, int);
     bool groupWrite3ByteDate(String, int, int, int);
-    bool groupWrite4ByteFloat(String, float);
     bool groupWrite14ByteText(String, String);
+    bool groupWrite3ByteColor(String, int, int, int);
+    bool groupWrite4ByteUInt(String, uint32_t);
+    bool groupWrite4ByteInt(String, int32_t);
+    bool groupWrite6ByteRGBW(String, int, int, int, int);
+    bool groupWrite6ByteXYY(String, float, float, int);
+    bool groupWrite8ByteDateTime(String, int, int, int, int, int, int, int);
+#endif
 
     bool groupAnswerBool(String, bool);
     /*
       bool groupAnswer4BitInt(String, int);
-      bool groupAnswer4BitDim(String, bool, byte);
     */
+    bool groupAnswer4BitDim(String, bool, byte);
     bool groupAnswer1ByteInt(String, int);
     bool groupAnswer2ByteInt(String, int);
     bool groupAnswer2ByteFloat(String, float);
+    bool groupAnswer4ByteFloat(String, float);
+    bool groupAnswerScene(String, int, bool learn = false);
+#if KNX_FEATURE_DPT_EXTENDED
     bool groupAnswer3ByteTime(String, int, int, int, int);
     bool groupAnswer3ByteDate(String, int, int, int);
-    bool groupAnswer4ByteFloat(String, float);
     bool groupAnswer14ByteText(String, String);
+    bool groupAnswer3ByteColor(String, int, int, int);
+    bool groupAnswer4ByteUInt(String, uint32_t);
+    bool groupAnswer4ByteInt(String, int32_t);
+    bool groupAnswer6ByteRGBW(String, int, int, int, int);
+    bool groupAnswer6ByteXYY(String, float, float, int);
+    bool groupAnswer8ByteDateTime(String, int, int, int, int, int, int, int);
+#endif
+
+    // Sends a prepared KnxFrameTemplate with its current value
+    bool sendTemplate(KnxFrameTemplate*);
 
     bool groupRead(String);
 
+#if KNX_FEATURE_ASYNC_READ
+    // Sends a read request and returns at once. The answer is matched in
+    // serialEvent(), even if the address is not listened on. Several reads
+    // may be pending; release each handle when done with it.
+    KnxReadHandle groupReadAsync(String, unsigned long timeout = GROUP_READ_TIMEOUT_MS);
+    KnxReadState getReadState(KnxReadHandle);
+    bool getReadAnswer(KnxReadHandle, KnxTelegram*);
+    void releaseRead(KnxReadHandle);
+#endif
+
     void addListenGroupAddress(String);
+    void addListenGroupAddress(uint16_t);
     bool isListeningToGroupAddress(int, int, int);
+    bool isListeningToGroupAddress(uint16_t);
 
     bool individualAnswerAddress();
     bool individualAnswerMaskVersion(int, int, int);
@@ -97,27 +258,180 @@ class KnxTpUart {
 
     void setListenToBroadcasts(bool);
 
+    // Individual address, listen table and send policy as one blob, see
+    // KnxConfig.h. saveConfig() returns the length or 0 if size is too
+    // small. loadConfig() replaces the configuration only if the blob is
+    // intact and returns false otherwise.
+    int saveConfig(uint8_t* buffer, int size);
+    bool loadConfig(const uint8_t* blob, int length);
+    bool loadConfig(KnxConfigReadByte readByte, int address);
+
+#if KNX_FEATURE_VIRTUAL_DEVICES
+    // Host further devices with their own individual addresses, see
+    // KnxVirtualDevices.h. Their frames are acknowledged and go to their
+    // handlers; serialEvent() reports a frame only if it is for this
+    // KnxTpUart's own address or listen table as well.
+    void setVirtualDevices(KnxVirtualDevices*);
+#endif
+
+#if KNX_FEATURE_SECURE
+    // KNX Data Secure, see KnxSecure.h. Frames to secured group addresses
+    // are secured when sent, received ones reach the application decrypted;
+    // frames that fail verification are not reported.
+    void setSecure(KnxSecure*);
+#endif
+
+#if KNX_FEATURE_RESET_RECOVERY
+    // After a reset indication, send the frames again that the TP-UART did
+    // not confirm because of the reset, see KnxResetRecovery.h. The caller
+    // and the confirm handler see the first attempt only.
+    void setResetRecovery(KnxResetRecovery*);
+#endif
+
+#if KNX_FEATURE_DEVICE_SERVICES
+    // Handle point-to-point connections (ETS) with a transport layer. Its
+    // T_ACKs are sent from serialEvent(), control frames and duplicates are
+    // not reported, and individualAnswer*() use its sequence numbers.
+    void setTransport(KnxTransport*);
+    // Answer memory and property services from a device image. They are
+    // handled in serialEvent() and not reported as telegrams.
+    void setDeviceMemory(KnxDeviceMemory*);
+#endif
+
+#if KNX_FEATURE_TX_QUEUE
+    // Queue outgoing telegrams instead of sending them from the calling task.
+    // groupWrite*() etc. then only report whether the frame was queued and
+    // processTxQueue() must be called from the task that calls serialEvent().
+    void setTxQueue(KnxTxQueue*);
+    bool processTxQueue();
+    bool hasQueuedTelegrams();
+    // Minimum time between two queued frames, SERIAL_WRITE_DELAY_MS by default
+    void setTxInterval(unsigned long);
+#endif
+    void setTxConfirmHandler(KnxTxConfirmHandler, void* context = NULL);
+
+#if KNX_FEATURE_RX_RING
+    // Receive from a ring filled by the UART interrupt instead of the Stream.
+    // The Stream is then only used for sending.
+    void setRxRing(KnxRxRing*);
+#endif
+
+#if KNX_DIAGNOSTICS >= 2
+    // Record receive and transmit latencies into the given histograms
+    void setLatencyStats(KnxLatencyStats*);
+    KnxTxTiming getLastTxTiming();
+#endif
+
 
   private:
     Stream* _serialport;
-    KnxTelegram* _tg;       // for normal communication
-    KnxTelegram* _tg_ptp;   // for PTP sequence confirmation
+    KnxTelegram _tg;        // last received telegram
     int _source_area;
     int _source_line;
     int _source_member;
-    int _listen_group_addresses[MAX_LISTEN_GROUP_ADDRESSES][3];
-    int _listen_group_address_count;
+    uint16_t _listen_group_addresses[MAX_LISTEN_GROUP_ADDRESSES];  // sorted
+    uint8_t _listen_group_address_count;
     bool _listen_to_broadcasts;
+    // Interval used by processTxQueue(), kept in the configuration blob
+    unsigned long _tx_interval;
+#if KNX_FEATURE_TX_QUEUE
+    KnxTxQueue* _tx_queue;
+    unsigned long _last_tx_time;
+#endif
+#if KNX_FEATURE_RX_RING
+    KnxRxRing* _rx_ring;
+#endif
+#if KNX_FEATURE_ASYNC_READ
+    KnxPendingRead _pending_reads[MAX_PENDING_GROUP_READS];
+#endif
+#if KNX_DIAGNOSTICS >= 2
+    KnxLatencyStats* _latency_stats;
+    KnxTxTiming _last_tx_timing;
+#endif
+    KnxTpUartMode _mode;
+#if KNX_DIAGNOSTICS >= 1
+    KnxMonitorRing* _monitor_ring;
+    KnxCaptureWriter* _capture;
+    KnxTrafficStats* _traffic;
+#endif
+    bool _hardware_ack;
+    int _product_id;
+#if KNX_FEATURE_DEVICE_SERVICES
+    KnxTransport* _transport;
+    KnxDeviceMemory* _device_memory;
+    // Transport control frame produced while serialEvent() runs
+    uint8_t _priority_frame[MAX_KNX_TELEGRAM_SIZE];
+    uint8_t _priority_length;  // 0 if empty
+    bool _in_serial_event;
+#endif
+#if KNX_FEATURE_VIRTUAL_DEVICES
+    KnxVirtualDevices* _virtual_devices;
+#endif
+#if KNX_FEATURE_COUPLER
+    KnxCoupler* _coupler;
+    int _coupler_port;
+#endif
+#if KNX_FEATURE_SECURE
+    KnxSecure* _secure;
+#endif
+#if KNX_FEATURE_RESET_RECOVERY
+    KnxResetRecovery* _recovery;
+    bool _recovering;
+#endif
+    KnxTxConfirmHandler _tx_confirm_handler;
+    void* _tx_confirm_context;
+    KnxDeferredFrame _deferred_frames[TPUART_DEFERRED_FRAMES];
+    uint8_t _deferred_frame_count;
 
     bool isKNXControlByte(int);
+    KnxTpUartSerialEventType receiveEvent();
+    bool sendPriority(const uint8_t*, int);
+#if KNX_FEATURE_DEVICE_SERVICES
+    void flushPriority();
+#endif
     void checkErrors();
     void printByte(int);
     bool readKNXTelegram();
-    void createKNXMessageFrame(int, KnxCommandType, String, int);
-    void createKNXMessageFrameIndividual(int, KnxCommandType, String, int);
-    bool sendMessage();
+    bool processTelegram(const uint8_t*, unsigned long, unsigned long, bool);
+    void deferTelegram();
+    KnxTpUartSerialEventType deferredFrameEvent();
+    bool receiveFrame(uint8_t*, unsigned long*, unsigned long*, bool*);
+    bool acknowledgeFrame(const uint8_t*);
+#if KNX_FEATURE_COUPLER
+    void setCoupler(KnxCoupler*, int);
+#endif
+    void uartSetAddress();
+    void recoverFromReset();
+#if KNX_FEATURE_DEVICE_SERVICES
+    bool handleDeviceService();
+#endif
+    void monitorBusByte(int);
+    void monitorFrame(const uint8_t*, unsigned long, unsigned long);
+    void recordFrame(uint8_t, const uint8_t*, int, unsigned long);
+#if KNX_FEATURE_RX_RING
+    bool readKNXTelegramFromRing(uint8_t*, bool*);
+    bool waitForRxRing(int);
+#endif
+    int rxAvailable();
+    int rxPeek();
+    void createKNXMessageFrame(KnxTelegram*, int, KnxCommandType, String, int);
+    void createKNXMessageFrameIndividual(KnxTelegram*, int, KnxCommandType, String, int);
+    bool sendTelegram(KnxTelegram*);
+    bool sendTelegram(const uint8_t*, int);
+    bool sendMessage(const uint8_t*, int);
+    bool sendFrame(const uint8_t*, int, unsigned long);
+    void txConfirmed();
     bool sendNCDPosConfirm(int, int, int, int);
     int serialRead();
+    bool waitForByte();
+    static uint16_t groupAddressFromString(String);
+    static uint16_t individualAddressFromString(String);
+    bool loadConfig(const uint8_t*, KnxConfigReadByte, int, int);
+#if KNX_FEATURE_ASYNC_READ
+    KnxPendingRead* pendingRead(KnxReadHandle);
+    void armPendingReads(const uint8_t*);
+    void completePendingReads();
+#endif
 };
 
 #endif
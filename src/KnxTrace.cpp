@@ -0,0 +1,43 @@
+// File: KnxTrace.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxTrace.h"
+
+#if defined(KNX_TRACE)
+
+KnxHistogram knxTraceHistograms[KNX_TRACE_POINTS];
+
+static const char* const traceNames[KNX_TRACE_POINTS] = {
+  "readKNXTelegram",
+  "address filter",
+  "sendAck",
+  "sendFrame",
+  "secure"
+};
+
+void knxTraceInit() {
+#if !defined(KNX_HOST_BUILD) && (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__))
+  // CoreDebug->DEMCR |= TRCENA, then DWT->CTRL |= CYCCNTENA
+  *(volatile uint32_t*) 0xE000EDFC |= (1UL << 24);
+  *(volatile uint32_t*) 0xE0001000 |= 1UL;
+#endif
+}
+
+void knxTraceReset() {
+  for (int i = 0; i < KNX_TRACE_POINTS; i++) {
+    knxTraceHistograms[i].clear();
+  }
+}
+
+void knxTraceDump(Print* out) {
+  out->print("Tracepoints in ");
+  out->println(KNX_TRACE_UNIT);
+  for (int i = 0; i < KNX_TRACE_POINTS; i++) {
+    if (knxTraceHistograms[i].getCount() > 0) {
+      knxTraceHistograms[i].print(out, traceNames[i]);
+    }
+  }
+}
+
+#endif
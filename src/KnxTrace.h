@@ -0,0 +1,104 @@
+// File: KnxTrace.h
+// Tracepoints around the protocol stages of KnxTpUart. Each stage records
+// its duration into a log2 KnxHistogram, counted with the cheapest cycle
+// counter of the platform:
+//
+//   ESP8266, ESP32, -S2, -S3   CCOUNT (CPU cycles)
+//   other ESP32 (RISC-V)      ESP.getCycleCount()
+//   Cortex-M3/M4/M7           DWT->CYCCNT (CPU cycles)
+//   host x86                  rdtsc (TSC ticks)
+//   other hosts               clock_gettime() (ns)
+//   anything else             micros()
+//
+// Disabled unless KNX_TRACE is defined (uncomment below or pass -DKNX_TRACE
+// to the whole build). Disabled, the macros expand to nothing and no code
+// or data is added.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxTrace_h
+#define KnxTrace_h
+
+#include "Arduino.h"
+
+// Uncomment the following line to enable the tracepoints
+//#define KNX_TRACE
+
+enum KnxTracePoint {
+  KNX_TRACE_READ_TELEGRAM,   // readKNXTelegram(): complete frame until dispatched
+  KNX_TRACE_ADDRESS_FILTER,  // acknowledgeFrame(): address decision on the header
+  KNX_TRACE_SEND_ACK,        // sendAck() / sendNotAddressed()
+  KNX_TRACE_SEND_FRAME,      // sendFrame(): data bytes out until confirmation
+  KNX_TRACE_SECURE,          // Data Secure on a received or sent frame
+  KNX_TRACE_POINTS
+};
+
+#if defined(KNX_TRACE)
+
+#include "KnxHistogram.h"
+
+#if defined(KNX_HOST_BUILD) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define KNX_TRACE_UNIT "ticks"
+#elif defined(KNX_HOST_BUILD)
+#include <time.h>
+#define KNX_TRACE_UNIT "ns"
+#elif defined(__XTENSA__) || defined(ARDUINO_ARCH_ESP32) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define KNX_TRACE_UNIT "cycles"
+#else
+#define KNX_TRACE_UNIT "us"
+#endif
+
+static inline uint32_t knxTraceCycles() {
+#if defined(KNX_HOST_BUILD) && (defined(__x86_64__) || defined(__i386__))
+  return (uint32_t) __rdtsc();
+#elif defined(KNX_HOST_BUILD)
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t) (ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+#elif defined(__XTENSA__)
+  uint32_t ccount;
+  __asm__ __volatile__("rsr %0, ccount" : "=a"(ccount));
+  return ccount;
+#elif defined(ARDUINO_ARCH_ESP32)
+  return ESP.getCycleCount();
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+  return *(volatile uint32_t*) 0xE0001004;  // DWT->CYCCNT
+#else
+  return micros();
+#endif
+}
+
+extern KnxHistogram knxTraceHistograms[KNX_TRACE_POINTS];
+
+// Starts the cycle counter where it has to be enabled
+void knxTraceInit();
+void knxTraceReset();
+// One block per stage, in KNX_TRACE_UNIT
+void knxTraceDump(Print* out);
+
+// Records from here to the end of the enclosing scope
+struct KnxTraceScope {
+  uint8_t point;
+  uint32_t start;
+
+  KnxTraceScope(uint8_t tracePoint) {
+    point = tracePoint;
+    start = knxTraceCycles();
+  }
+  ~KnxTraceScope() {
+    knxTraceHistograms[point].record(knxTraceCycles() - start);
+  }
+};
+
+#define KNX_TRACE_INIT() knxTraceInit()
+#define KNX_TRACE_SCOPE(point) KnxTraceScope knxTraceScope(point)
+
+#else
+
+#define KNX_TRACE_INIT()
+#define KNX_TRACE_SCOPE(point)
+
+#endif
+
+#endif
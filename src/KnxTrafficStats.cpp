@@ -0,0 +1,171 @@
+// File: KnxTrafficStats.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxTrafficStats.h"
+#include "KnxTelegramView.h"
+
+KnxTrafficTable::KnxTrafficTable() {
+  clear();
+}
+
+void KnxTrafficTable::clear() {
+  _used = 0;
+}
+
+void KnxTrafficTable::record(uint16_t address, int length, bool repeated) {
+  KnxTrafficEntry* entry = NULL;
+  for (int i = 0; i < _used; i++) {
+    if (_entries[i].address == address) {
+      entry = &_entries[i];
+      break;
+    }
+  }
+
+  if (entry == NULL) {
+    if (_used < TPUART_TRAFFIC_SLOTS) {
+      entry = &_entries[_used++];
+      entry->frames = 0;
+      entry->error = 0;
+    }
+    else {
+      // The address with the fewest frames leaves its count behind
+      entry = &_entries[0];
+      for (int i = 1; i < TPUART_TRAFFIC_SLOTS; i++) {
+        if (_entries[i].frames < entry->frames) {
+          entry = &_entries[i];
+        }
+      }
+      entry->error = entry->frames;
+    }
+    entry->address = address;
+    entry->bytes = 0;
+    entry->repeats = 0;
+  }
+
+  entry->frames++;
+  entry->bytes += length;
+  if (repeated) {
+    entry->repeats++;
+  }
+}
+
+int KnxTrafficTable::getTop(KnxTrafficEntry* entries, int max) {
+  int count = 0;
+  for (int i = 0; i < _used; i++) {
+    // Insertion into the sorted output, the table is small
+    int j = count < max ? count++ : max;
+    while (j > 0 && entries[j - 1].frames < _entries[i].frames) {
+      if (j < max) {
+        entries[j] = entries[j - 1];
+      }
+      j--;
+    }
+    if (j < max) {
+      entries[j] = _entries[i];
+    }
+  }
+  return count;
+}
+
+bool KnxTrafficTable::find(uint16_t address, KnxTrafficEntry* entry) {
+  for (int i = 0; i < _used; i++) {
+    if (_entries[i].address == address) {
+      *entry = _entries[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+KnxTrafficStats::KnxTrafficStats() {
+  clear();
+}
+
+void KnxTrafficStats::clear() {
+  _sources.clear();
+  _groups.clear();
+  _frames = 0;
+  _bytes = 0;
+  _repeats = 0;
+}
+
+void KnxTrafficStats::record(const uint8_t* frame, int length) {
+  KnxTelegramView view(frame);
+  bool repeated = view.isRepeated();
+
+  _frames++;
+  _bytes += length;
+  if (repeated) {
+    _repeats++;
+  }
+
+  _sources.record(view.getSourceAddress(), length, repeated);
+  if (view.isTargetGroup()) {
+    _groups.record(view.getTargetAddress(), length, repeated);
+  }
+}
+
+KnxTrafficTable* KnxTrafficStats::getSources() {
+  return &_sources;
+}
+
+KnxTrafficTable* KnxTrafficStats::getGroupAddresses() {
+  return &_groups;
+}
+
+unsigned long KnxTrafficStats::getFrameCount() {
+  return _frames;
+}
+
+unsigned long KnxTrafficStats::getByteCount() {
+  return _bytes;
+}
+
+unsigned long KnxTrafficStats::getRepeatCount() {
+  return _repeats;
+}
+
+void KnxTrafficStats::print(Print* out, int top) {
+  out->print("frames ");
+  out->print(_frames);
+  out->print(" bytes ");
+  out->print(_bytes);
+  out->print(" repeats ");
+  out->println(_repeats);
+  printTable(out, &_sources, false, top);
+  printTable(out, &_groups, true, top);
+}
+
+void KnxTrafficStats::printTable(Print* out, KnxTrafficTable* table, bool group, int top) {
+  // <address> frames <n> bytes <n> repeats <n> [error <n>]
+  KnxTrafficEntry entries[TPUART_TRAFFIC_SLOTS];
+  int count = table->getTop(entries, top < TPUART_TRAFFIC_SLOTS ? top : TPUART_TRAFFIC_SLOTS);
+  for (int i = 0; i < count; i++) {
+    uint16_t address = entries[i].address;
+    if (group) {
+      out->print(address >> 11);
+      out->print('/');
+      out->print((address >> 8) & 0x07);
+      out->print('/');
+    }
+    else {
+      out->print(address >> 12);
+      out->print('.');
+      out->print((address >> 8) & 0x0F);
+      out->print('.');
+    }
+    out->print(address & 0xFF);
+    out->print(" frames ");
+    out->print(entries[i].frames);
+    out->print(" bytes ");
+    out->print(entries[i].bytes);
+    out->print(" repeats ");
+    out->print(entries[i].repeats);
+    if (entries[i].error > 0) {
+      out->print(" error ");
+      out->print(entries[i].error);
+    }
+    out->println();
+  }
+}
@@ -0,0 +1,89 @@
+// File: KnxTrafficStats.h
+// Traffic per sender and per group address, to find out who floods the
+// line. Every frame on the bus is counted with its length and repeat
+// flag. Each table keeps its heaviest TPUART_TRAFFIC_SLOTS addresses with
+// the space-saving algorithm. When a new address arrives and the table is
+// full, it takes over the slot with the fewest frames together with its
+// count. The count is then an upper bound, and getError() tells how much
+// of it may belong to the evicted addresses. Any address with more than
+// 1/TPUART_TRAFFIC_SLOTS of the frames is guaranteed to be in the table.
+//
+// KnxTpUart records a frame after it has been acknowledged, so recording
+// never delays the acknowledge. Memory is fixed and nothing is allocated.
+// The tables are filled from serialEvent(), so query them from the same
+// task.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxTrafficStats_h
+#define KnxTrafficStats_h
+
+#include "Arduino.h"
+
+// Addresses kept per table. A table lookup scans all slots, which is
+// still far below the time of one frame on the bus.
+#ifndef TPUART_TRAFFIC_SLOTS
+#define TPUART_TRAFFIC_SLOTS 16
+#endif
+
+#if TPUART_TRAFFIC_SLOTS > 255
+#error "TPUART_TRAFFIC_SLOTS must not exceed 255"
+#endif
+
+struct KnxTrafficEntry {
+  uint16_t address;      // Individual or group address
+  unsigned long frames;  // Upper bound, see error
+  unsigned long bytes;
+  unsigned long repeats;
+  unsigned long error;   // Frames possibly from evicted addresses
+};
+
+class KnxTrafficTable {
+  public:
+    KnxTrafficTable();
+
+    void record(uint16_t address, int length, bool repeated);
+    void clear();
+
+    // Copies up to max entries into entries, most frames first, and
+    // returns how many
+    int getTop(KnxTrafficEntry* entries, int max);
+    // Counts of the address, or false if it is not in the table
+    bool find(uint16_t address, KnxTrafficEntry* entry);
+
+  private:
+    KnxTrafficEntry _entries[TPUART_TRAFFIC_SLOTS];
+    uint8_t _used;
+};
+
+class KnxTrafficStats {
+  public:
+    KnxTrafficStats();
+
+    // From KnxTpUart, frame is the raw frame including the checksum
+    void record(const uint8_t* frame, int length);
+    void clear();
+
+    KnxTrafficTable* getSources();
+    // Group addressed frames only
+    KnxTrafficTable* getGroupAddresses();
+
+    // All frames, exact
+    unsigned long getFrameCount();
+    unsigned long getByteCount();
+    unsigned long getRepeatCount();
+
+    // Totals and the top entries of both tables, one line each
+    void print(Print* out, int top);
+
+  private:
+    KnxTrafficTable _sources;
+    KnxTrafficTable _groups;
+    unsigned long _frames;
+    unsigned long _bytes;
+    unsigned long _repeats;
+
+    static void printTable(Print* out, KnxTrafficTable* table, bool group, int top);
+};
+
+#endif
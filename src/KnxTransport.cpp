@@ -0,0 +1,216 @@
+// File: KnxTransport.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxTransport.h"
+#include "KnxTpUart.h"
+
+#define SEQUENCE_MASK 0x0F
+
+KnxTransport::KnxTransport(KnxTpUart* knx) {
+  _knx = knx;
+  _state = KNX_TRANSPORT_CLOSED;
+  _peer = 0;
+  _seq_send = 0;
+  _seq_receive = 0;
+  _repetitions = 0;
+  _last_activity = 0;
+  _sent_at = 0;
+  _connection_timeout = TRANSPORT_CONNECTION_TIMEOUT_MS;
+  _ack_timeout = TRANSPORT_ACK_TIMEOUT_MS;
+  _repetition_count = 0;
+}
+
+bool KnxTransport::connect(int area, int line, int member) {
+  if (_state != KNX_TRANSPORT_CLOSED) {
+    return false;
+  }
+  uint16_t peer = ((unsigned int) area << 12) | (line << 8) | member;
+  open(peer);
+  return sendControl(peer, KNX_COMM_UCD, KNX_CONTROLDATA_CONNECT, 0);
+}
+
+void KnxTransport::disconnect() {
+  if (_state != KNX_TRANSPORT_CLOSED) {
+    close(true);
+  }
+}
+
+bool KnxTransport::sendData(KnxTelegram* tg) {
+  if (_state != KNX_TRANSPORT_OPEN_IDLE) {
+    return false;
+  }
+
+  uint16_t own = _knx->getIndividualAddress();
+  _pending = *tg;
+  _pending.setSourceAddress(own >> 12, (own >> 8) & 0x0F, own & 0xFF);
+  _pending.setTargetIndividualAddress(_peer >> 12, (_peer >> 8) & 0x0F, _peer & 0xFF);
+  _pending.setCommunicationType(KNX_COMM_NDP);
+  _pending.setSequenceNumber(_seq_send);
+  _pending.createChecksum();
+
+  _state = KNX_TRANSPORT_OPEN_WAIT;
+  _repetitions = 0;
+  // A failed send is repeated like a missing T_ACK
+  sendPending();
+  return true;
+}
+
+void KnxTransport::poll() {
+  if (_state == KNX_TRANSPORT_CLOSED) {
+    return;
+  }
+
+  unsigned long now = millis();
+  if ((now - _last_activity) > _connection_timeout) {
+    close(true);
+    return;
+  }
+
+  if (_state == KNX_TRANSPORT_OPEN_WAIT && (now - _sent_at) > _ack_timeout) {
+    if (_repetitions < TRANSPORT_MAX_REPETITIONS) {
+      _repetitions++;
+      _repetition_count++;
+      sendPending();
+    }
+    else {
+      close(true);
+    }
+  }
+}
+
+void KnxTransport::setTimeouts(unsigned long connection, unsigned long ack) {
+  _connection_timeout = connection;
+  _ack_timeout = ack;
+}
+
+KnxTransportState KnxTransport::getState() {
+  return (KnxTransportState) _state;
+}
+
+bool KnxTransport::isConnected() {
+  return _state != KNX_TRANSPORT_CLOSED;
+}
+
+bool KnxTransport::isConnectedTo(int area, int line, int member) {
+  return isConnected() && _peer == (((unsigned int) area << 12) | (line << 8) | member);
+}
+
+uint16_t KnxTransport::getPeerAddress() {
+  return _peer;
+}
+
+unsigned long KnxTransport::getRepetitionCount() {
+  return _repetition_count;
+}
+
+bool KnxTransport::received(KnxTelegram* tg) {
+  uint16_t source = ((unsigned int) tg->getSourceArea() << 12) | (tg->getSourceLine() << 8) | tg->getSourceMember();
+  bool fromPeer = _state != KNX_TRANSPORT_CLOSED && source == _peer;
+  int sequenceNo = tg->getSequenceNumber();
+
+  switch (tg->getCommunicationType()) {
+    case KNX_COMM_UDP:
+      // Connectionless
+      return true;
+
+    case KNX_COMM_UCD:
+      if (tg->getControlData() == KNX_CONTROLDATA_CONNECT) {
+        if (_state == KNX_TRANSPORT_CLOSED || fromPeer) {
+          // A connect of the current peer starts over
+          open(source);
+        }
+        else {
+          // Busy with another peer
+          sendControl(source, KNX_COMM_UCD, KNX_CONTROLDATA_DISCONNECT, 0);
+        }
+      }
+      else if (tg->getControlData() == KNX_CONTROLDATA_DISCONNECT && fromPeer) {
+        close(false);
+      }
+      return false;
+
+    case KNX_COMM_NDP:
+      if (!fromPeer) {
+        sendControl(source, KNX_COMM_UCD, KNX_CONTROLDATA_DISCONNECT, 0);
+        return false;
+      }
+      _last_activity = millis();
+      if (sequenceNo == _seq_receive) {
+        sendControl(_peer, KNX_COMM_NCD, KNX_CONTROLDATA_POS_CONFIRM, sequenceNo);
+        _seq_receive = (_seq_receive + 1) & SEQUENCE_MASK;
+        return true;
+      }
+      if (sequenceNo == ((_seq_receive - 1) & SEQUENCE_MASK)) {
+        // Our T_ACK got lost, the peer repeats
+        sendControl(_peer, KNX_COMM_NCD, KNX_CONTROLDATA_POS_CONFIRM, sequenceNo);
+      }
+      else {
+        sendControl(_peer, KNX_COMM_NCD, KNX_CONTROLDATA_NEG_CONFIRM, sequenceNo);
+      }
+      return false;
+
+    case KNX_COMM_NCD:
+      if (!fromPeer) {
+        sendControl(source, KNX_COMM_UCD, KNX_CONTROLDATA_DISCONNECT, 0);
+        return false;
+      }
+      _last_activity = millis();
+      if (sequenceNo != _seq_send) {
+        close(true);
+      }
+      else if (_state == KNX_TRANSPORT_OPEN_WAIT) {
+        if (tg->getControlData() == KNX_CONTROLDATA_POS_CONFIRM) {
+          _seq_send = (_seq_send + 1) & SEQUENCE_MASK;
+          _state = KNX_TRANSPORT_OPEN_IDLE;
+        }
+        else if (_repetitions < TRANSPORT_MAX_REPETITIONS) {
+          _repetitions++;
+          _repetition_count++;
+          sendPending();
+        }
+        else {
+          close(true);
+        }
+      }
+      return false;
+  }
+  return false;
+}
+
+void KnxTransport::open(uint16_t peer) {
+  _peer = peer;
+  _state = KNX_TRANSPORT_OPEN_IDLE;
+  _seq_send = 0;
+  _seq_receive = 0;
+  _repetitions = 0;
+  _last_activity = millis();
+}
+
+void KnxTransport::close(bool sendDisconnect) {
+  _state = KNX_TRANSPORT_CLOSED;
+  if (sendDisconnect) {
+    sendControl(_peer, KNX_COMM_UCD, KNX_CONTROLDATA_DISCONNECT, 0);
+  }
+}
+
+bool KnxTransport::sendControl(uint16_t target, KnxCommunicationType type, KnxControlDataType control, int sequenceNo) {
+  uint16_t own = _knx->getIndividualAddress();
+  KnxTelegram tg;
+  tg.setSourceAddress(own >> 12, (own >> 8) & 0x0F, own & 0xFF);
+  tg.setTargetIndividualAddress(target >> 12, (target >> 8) & 0x0F, target & 0xFF);
+  tg.setCommunicationType(type);
+  tg.setSequenceNumber(sequenceNo);
+  tg.setControlData(control);
+  tg.setPayloadLength(1);
+  tg.createChecksum();
+
+  // Bypasses the transmit queue, the peer waits for it
+  return _knx->sendPriority(tg.getBuffer(), tg.getTotalLength());
+}
+
+bool KnxTransport::sendPending() {
+  _sent_at = millis();
+  _last_activity = _sent_at;
+  return _knx->sendPriority(_pending.getBuffer(), _pending.getTotalLength());
+}
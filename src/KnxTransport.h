@@ -0,0 +1,82 @@
+// File: KnxTransport.h
+// Connection-oriented transport layer (point-to-point sessions as used by
+// ETS): T_Connect/T_Disconnect, numbered data with sequence tracking,
+// T_ACK/T_NAK, connection and acknowledge timeouts with repetition.
+// KnxTpUart hands every frame to our individual address to received().
+// The T_ACK or T_NAK it produces is sent when serialEvent() has finished
+// with the frame, before anything in the transmit queue.
+// One connection at a time, like the KNX transport layer style 1.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxTransport_h
+#define KnxTransport_h
+
+#include "Arduino.h"
+
+#include "KnxTelegram.h"
+
+class KnxTpUart;
+
+// Connection closed if nothing is received or sent in this time
+#define TRANSPORT_CONNECTION_TIMEOUT_MS 6000
+
+// Time to wait for the T_ACK of our numbered data
+#define TRANSPORT_ACK_TIMEOUT_MS 3000
+
+// Repetitions of numbered data before the connection is given up
+#define TRANSPORT_MAX_REPETITIONS 3
+
+enum KnxTransportState {
+  KNX_TRANSPORT_CLOSED,
+  KNX_TRANSPORT_OPEN_IDLE,
+  KNX_TRANSPORT_OPEN_WAIT   // Waiting for the T_ACK of our data
+};
+
+class KnxTransport {
+  public:
+    KnxTransport(KnxTpUart*);
+
+    // Client side, the peer may also connect to us
+    bool connect(int area, int line, int member);
+    void disconnect();
+
+    // Sends numbered data to the peer, sequence number and addresses are
+    // filled in. False if not connected or the last data is not acknowledged.
+    bool sendData(KnxTelegram*);
+
+    // Call from loop(), handles the timeouts
+    void poll();
+    void setTimeouts(unsigned long connection, unsigned long ack);
+
+    KnxTransportState getState();
+    bool isConnected();
+    bool isConnectedTo(int area, int line, int member);
+    uint16_t getPeerAddress();
+    unsigned long getRepetitionCount();
+
+    // From the KnxTpUart receive path. Returns true if the telegram is
+    // for the application, false for control frames and duplicates.
+    bool received(KnxTelegram*);
+
+  private:
+    KnxTpUart* _knx;
+    uint8_t _state;
+    uint16_t _peer;
+    uint8_t _seq_send;
+    uint8_t _seq_receive;
+    uint8_t _repetitions;
+    unsigned long _last_activity;
+    unsigned long _sent_at;
+    unsigned long _connection_timeout;
+    unsigned long _ack_timeout;
+    unsigned long _repetition_count;
+    KnxTelegram _pending;  // For repetitions
+
+    void open(uint16_t peer);
+    void close(bool sendDisconnect);
+    bool sendControl(uint16_t target, KnxCommunicationType type, KnxControlDataType control, int sequenceNo);
+    bool sendPending();
+};
+
+#endif
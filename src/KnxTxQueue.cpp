@@ -0,0 +1,110 @@
+// File: KnxTxQueue.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxTxQueue.h"
+#include "KnxCriticalSection.h"
+
+KnxTxQueue::KnxTxQueue() {
+  for (int i = 0; i < TPUART_TX_QUEUE_SIZE; i++) {
+    _slots[i].state = KNX_TX_SLOT_FREE;
+    _slots[i].length = 0;
+  }
+  _head = 0;
+  _tail = 0;
+  _count = 0;
+  _rejected = 0;
+}
+
+KnxTxSlot* KnxTxQueue::reserve() {
+  // Only the slot index is claimed under the lock, the frame is copied outside
+  KnxCriticalSection lock;
+  if (_count >= TPUART_TX_QUEUE_SIZE) {
+    _rejected++;
+    return NULL;
+  }
+  KnxTxSlot* slot = &_slots[_tail];
+  slot->state = KNX_TX_SLOT_FILLING;
+  _tail = (_tail + 1) % TPUART_TX_QUEUE_SIZE;
+  _count++;
+  return slot;
+}
+
+void KnxTxQueue::commit(KnxTxSlot* slot) {
+  // Entering the lock also orders the frame bytes before the state change
+  KnxCriticalSection lock;
+  slot->state = KNX_TX_SLOT_READY;
+}
+
+bool KnxTxQueue::push(KnxTelegram* tg) {
+  KnxTxSlot* slot = reserve();
+  if (slot == NULL) {
+    return false;
+  }
+
+  int length = tg->getTotalLength();
+  for (int i = 0; i < length; i++) {
+    slot->frame[i] = tg->getBufferByte(i);
+  }
+  slot->length = length;
+  slot->queued = micros();
+
+  commit(slot);
+  return true;
+}
+
+bool KnxTxQueue::push(const uint8_t* frame, uint8_t length) {
+  if (length > MAX_KNX_TELEGRAM_SIZE) {
+    return false;
+  }
+
+  KnxTxSlot* slot = reserve();
+  if (slot == NULL) {
+    return false;
+  }
+
+  memcpy(slot->frame, frame, length);
+  slot->length = length;
+  slot->queued = micros();
+
+  commit(slot);
+  return true;
+}
+
+KnxTxSlot* KnxTxQueue::front() {
+  KnxCriticalSection lock;
+  if (_count == 0) {
+    return NULL;
+  }
+
+  // A slow producer holding the head slot blocks the frames behind it,
+  // this keeps the bus order equal to the reservation order
+  KnxTxSlot* slot = &_slots[_head];
+  if (slot->state == KNX_TX_SLOT_FILLING) {
+    return NULL;
+  }
+  slot->state = KNX_TX_SLOT_SENDING;
+  return slot;
+}
+
+void KnxTxQueue::pop() {
+  KnxCriticalSection lock;
+  if (_count == 0) {
+    return;
+  }
+  _slots[_head].state = KNX_TX_SLOT_FREE;
+  _head = (_head + 1) % TPUART_TX_QUEUE_SIZE;
+  _count--;
+}
+
+uint8_t KnxTxQueue::size() {
+  return _count;
+}
+
+bool KnxTxQueue::isEmpty() {
+  return _count == 0;
+}
+
+unsigned long KnxTxQueue::getRejectedCount() {
+  return _rejected;
+}
@@ -0,0 +1,61 @@
+// File: KnxTxQueue.h
+// Bounded multi-producer transmit queue. Any task or interrupt may push an
+// encoded frame; a single drainer (KnxTpUart::processTxQueue()) owns the
+// serial port and sends the frames in order.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxTxQueue_h
+#define KnxTxQueue_h
+
+#include "Arduino.h"
+
+#include "KnxTelegram.h"
+
+// Number of frames the transmit queue can hold
+#ifndef TPUART_TX_QUEUE_SIZE
+#define TPUART_TX_QUEUE_SIZE 8
+#endif
+
+enum KnxTxSlotState {
+  KNX_TX_SLOT_FREE,
+  KNX_TX_SLOT_FILLING,  // Reserved by a producer, frame not complete yet
+  KNX_TX_SLOT_READY,
+  KNX_TX_SLOT_SENDING   // Owned by the drainer until confirmed
+};
+
+struct KnxTxSlot {
+  volatile uint8_t state;
+  uint8_t length;
+  unsigned long queued;  // micros() when pushed
+  uint8_t frame[MAX_KNX_TELEGRAM_SIZE];
+};
+
+class KnxTxQueue {
+  public:
+    KnxTxQueue();
+
+    // Producer side, safe from any context
+    bool push(KnxTelegram* tg);
+    bool push(const uint8_t* frame, uint8_t length);
+
+    // Drainer side, only ever called from one context
+    KnxTxSlot* front();
+    void pop();
+
+    uint8_t size();
+    bool isEmpty();
+    unsigned long getRejectedCount();
+
+  private:
+    KnxTxSlot _slots[TPUART_TX_QUEUE_SIZE];
+    volatile uint8_t _head;
+    volatile uint8_t _tail;
+    volatile uint8_t _count;
+    volatile unsigned long _rejected;
+
+    KnxTxSlot* reserve();
+    void commit(KnxTxSlot* slot);
+};
+
+#endif
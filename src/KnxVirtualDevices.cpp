@@ -0,0 +1,176 @@
+// File: KnxVirtualDevices.cpp
+
+// Last modified: 18.10.2026
+
+#include "KnxVirtualDevices.h"
+#include "KnxTpUart.h"
+
+KnxVirtualDevices::KnxVirtualDevices(KnxTpUart* knx) {
+  _knx = knx;
+  _device_count = 0;
+  _group_count = 0;
+}
+
+int KnxVirtualDevices::addDevice(String individualAddress, KnxDeviceHandler handler, void* context) {
+  return addDevice(KnxTpUart::individualAddressFromString(individualAddress), handler, context);
+}
+
+int KnxVirtualDevices::addDevice(uint16_t individualAddress, KnxDeviceHandler handler, void* context) {
+  if (_device_count >= MAX_VIRTUAL_DEVICES || getDevice(individualAddress) >= 0) {
+    return -1;
+  }
+
+  int device = _device_count++;
+  _devices[device].address = individualAddress;
+  _devices[device].handler = handler;
+  _devices[device].context = context;
+  _devices[device].memory = NULL;
+
+  // Keep _by_address sorted for getDevice()
+  int i = device;
+  while (i > 0 && _devices[_by_address[i - 1]].address > individualAddress) {
+    _by_address[i] = _by_address[i - 1];
+    i--;
+  }
+  _by_address[i] = device;
+  return device;
+}
+
+bool KnxVirtualDevices::addListenGroupAddress(int device, String address) {
+  return addListenGroupAddress(device, KnxTpUart::groupAddressFromString(address));
+}
+
+bool KnxVirtualDevices::addListenGroupAddress(int device, uint16_t address) {
+  if (device < 0 || device >= _device_count) {
+    return false;
+  }
+
+  int index = findGroup(address);
+  if (index < _group_count && _groups[index].address == address) {
+    _groups[index].devices |= (KnxDeviceMask) 1 << device;
+    return true;
+  }
+  if (_group_count >= MAX_VIRTUAL_GROUP_ADDRESSES) {
+#if defined(TPUART_DEBUG)
+    TPUART_DEBUG_PORT.println("Already MAX_VIRTUAL_GROUP_ADDRESSES in use, cannot listen to another");
+#endif
+    return false;
+  }
+
+  for (int i = _group_count; i > index; i--) {
+    _groups[i] = _groups[i - 1];
+  }
+  _groups[index].address = address;
+  _groups[index].devices = (KnxDeviceMask) 1 << device;
+  _group_count++;
+  return true;
+}
+
+void KnxVirtualDevices::setDeviceMemory(int device, KnxDeviceMemory* memory) {
+  if (device >= 0 && device < _device_count) {
+    _devices[device].memory = memory;
+  }
+}
+
+int KnxVirtualDevices::getDeviceCount() {
+  return _device_count;
+}
+
+uint16_t KnxVirtualDevices::getIndividualAddress(int device) {
+  return _devices[device].address;
+}
+
+KnxDeviceMask KnxVirtualDevices::getGroupOwners(uint16_t address) {
+  int index = findGroup(address);
+  if (index < _group_count && _groups[index].address == address) {
+    return _groups[index].devices;
+  }
+  return 0;
+}
+
+int KnxVirtualDevices::getDevice(uint16_t individualAddress) {
+  int low = 0;
+  int high = _device_count - 1;
+  while (low <= high) {
+    int mid = (low + high) / 2;
+    uint16_t address = _devices[_by_address[mid]].address;
+    if (address == individualAddress) {
+      return _by_address[mid];
+    }
+    else if (address < individualAddress) {
+      low = mid + 1;
+    }
+    else {
+      high = mid - 1;
+    }
+  }
+  return -1;
+}
+
+bool KnxVirtualDevices::send(int device, KnxTelegram* tg) {
+  if (device < 0 || device >= _device_count) {
+    return false;
+  }
+  uint16_t address = _devices[device].address;
+  tg->setSourceAddress(address >> 12, (address >> 8) & 0x0F, address & 0xFF);
+  tg->createChecksum();
+  return _knx->sendTelegram(tg);
+}
+
+bool KnxVirtualDevices::received(KnxTelegram* tg) {
+  if (!tg->isTargetGroup()) {
+    uint16_t target = ((unsigned int) tg->getTargetArea() << 12) | (tg->getTargetLine() << 8) | tg->getTargetMember();
+    int device = getDevice(target);
+    return device >= 0 && receivedIndividual(device, tg);
+  }
+
+  KnxDeviceMask owners = getGroupOwners(tg->getTargetGroupAddress());
+  if (owners == 0) {
+    return false;
+  }
+  for (int device = 0; owners != 0; device++, owners >>= 1) {
+    if ((owners & 1) && _devices[device].handler != NULL) {
+      _devices[device].handler(device, tg, _devices[device].context);
+    }
+  }
+  return true;
+}
+
+bool KnxVirtualDevices::receivedIndividual(int device, KnxTelegram* tg) {
+  KnxVirtualDevice* d = &_devices[device];
+  if (tg->getCommunicationType() != KNX_COMM_UDP) {
+    // No connections, see KnxTransport
+    return true;
+  }
+
+  if (d->memory != NULL) {
+    KnxTelegram response;
+    KnxServiceResult result = d->memory->handle(tg, &response);
+    if (result == KNX_SERVICE_RESPOND) {
+      _knx->sendTelegram(&response);
+    }
+    if (result != KNX_SERVICE_IGNORED) {
+      return true;
+    }
+  }
+  if (d->handler != NULL) {
+    d->handler(device, tg, d->context);
+  }
+  return true;
+}
+
+int KnxVirtualDevices::findGroup(uint16_t address) {
+  // Index of the address, or where it would have to be inserted
+  int low = 0;
+  int high = _group_count;
+  while (low < high) {
+    int mid = (low + high) / 2;
+    if (_groups[mid].address < address) {
+      low = mid + 1;
+    }
+    else {
+      high = mid;
+    }
+  }
+  return low;
+}
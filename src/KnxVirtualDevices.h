@@ -0,0 +1,93 @@
+// File: KnxVirtualDevices.h
+// Several logical devices behind one TP-UART, each with its own individual
+// address, listen table, handler and optionally its own KnxDeviceMemory.
+// The listen tables are merged into one sorted table of group addresses
+// with a bit per owning device, so a received frame is resolved to all of
+// its devices by a single binary search however many devices there are.
+// Virtual devices are reachable connectionless only; point-to-point
+// connections (KnxTransport) stay with the address of the KnxTpUart.
+
+// Last modified: 18.10.2026
+
+#ifndef KnxVirtualDevices_h
+#define KnxVirtualDevices_h
+
+#include "Arduino.h"
+
+#include "KnxTelegram.h"
+#include "KnxDeviceMemory.h"
+
+class KnxTpUart;
+
+// At most 16, the owners of a group address are kept as bit mask
+#ifndef MAX_VIRTUAL_DEVICES
+#define MAX_VIRTUAL_DEVICES 8
+#endif
+
+#if MAX_VIRTUAL_DEVICES > 16
+#error "MAX_VIRTUAL_DEVICES must not exceed 16"
+#endif
+
+// Distinct group addresses over all virtual devices
+#ifndef MAX_VIRTUAL_GROUP_ADDRESSES
+#define MAX_VIRTUAL_GROUP_ADDRESSES 48
+#endif
+
+// Bit n set: device n
+typedef uint16_t KnxDeviceMask;
+
+// Called from serialEvent() for every frame to the device
+typedef void (*KnxDeviceHandler)(int device, KnxTelegram* tg, void* context);
+
+struct KnxGroupOwners {
+  uint16_t address;
+  KnxDeviceMask devices;
+};
+
+struct KnxVirtualDevice {
+  uint16_t address;
+  KnxDeviceHandler handler;
+  void* context;
+  KnxDeviceMemory* memory;
+};
+
+class KnxVirtualDevices {
+  public:
+    KnxVirtualDevices(KnxTpUart*);
+
+    // Returns the device number or -1 if MAX_VIRTUAL_DEVICES are in use
+    // or the address is taken
+    int addDevice(String individualAddress, KnxDeviceHandler handler, void* context = NULL);
+    int addDevice(uint16_t individualAddress, KnxDeviceHandler handler, void* context = NULL);
+    bool addListenGroupAddress(int device, String address);
+    bool addListenGroupAddress(int device, uint16_t address);
+    // Memory and property services of the device are answered from this
+    // image instead of being passed to the handler
+    void setDeviceMemory(int device, KnxDeviceMemory*);
+
+    int getDeviceCount();
+    uint16_t getIndividualAddress(int device);
+    KnxDeviceMask getGroupOwners(uint16_t address);
+    int getDevice(uint16_t individualAddress);  // -1 if none
+
+    // Sends the telegram with the individual address of the device as
+    // source, the checksum is created here
+    bool send(int device, KnxTelegram*);
+
+    // From the KnxTpUart receive path, calls the handlers of all devices
+    // addressed by the telegram. Returns true if there was one.
+    bool received(KnxTelegram*);
+
+  private:
+    KnxTpUart* _knx;
+    KnxVirtualDevice _devices[MAX_VIRTUAL_DEVICES];
+    int _device_count;
+    KnxGroupOwners _groups[MAX_VIRTUAL_GROUP_ADDRESSES];  // sorted
+    int _group_count;
+    uint8_t _by_address[MAX_VIRTUAL_DEVICES];  // device numbers, sorted by address
+
+    int findGroup(uint16_t address);
+    bool receivedIndividual(int device, KnxTelegram*);
+};
+
+#endif